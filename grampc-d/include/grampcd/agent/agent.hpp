@@ -23,6 +23,8 @@
 
 #include "grampcd/util/class_forwarding.hpp"
 
+#include <mutex>
+
 namespace grampcd
 {  
     /**
@@ -84,6 +86,8 @@ namespace grampcd
 
         /*Shift the agents states.*/
         void shift_states(const typeRNum dt, const typeRNum t0);
+        /*Shift the agents states in advance and use the predicted state as initial state until the simulated state arrives.*/
+        void predict_state(const typeRNum dt);
 
         /*Returns the agents desired agent state.*/
         const AgentState& get_desiredAgentState() const;
@@ -156,7 +160,22 @@ namespace grampcd
 	    /*This function is called if a message is received including the neighbors coupling states.*/
         void fromCommunication_received_couplingState(const CouplingState& state, const CouplingState& state2, int from);
         /*This function is called if a message is received including the neighbors multiplier state.*/
-        void fromCommunication_received_multiplierState(const MultiplierState& state, PenaltyState penalty, int from);
+        void fromCommunication_received_multiplierState(const MultiplierState& state, const PenaltyState& penalty, int from);
+        /*This function is called if a view on the neighbors agent state is handed over.*/
+        void fromCommunication_received_agentState(const std::shared_ptr<const AgentState>& state, int from);
+        /*This function is called if views on the neighbors current and previous coupling state are handed over.*/
+        void fromCommunication_received_couplingState(const std::shared_ptr<const CouplingState>& state, const std::shared_ptr<const CouplingState>& previous_state, int from);
+        /*This function is called if views on the neighbors coupling states and external influence coupling states are handed over.*/
+        void fromCommunication_received_couplingState
+        (
+            const std::shared_ptr<const CouplingState>& state,
+            const std::shared_ptr<const CouplingState>& previous_state,
+            const std::shared_ptr<const CouplingState>& state2,
+            const std::shared_ptr<const CouplingState>& previous_state2,
+            int from
+        );
+        /*This function is called if views on the neighbors multiplier and penalty state are handed over.*/
+        void fromCommunication_received_multiplierState(const std::shared_ptr<const MultiplierState>& state, const std::shared_ptr<const PenaltyState>& penalty, int from);
         /*This function is called if a message is received including the optimization info.*/
         void fromCommunication_configured_optimization(const OptimizationInfo& info);
         /*This function is called if a message is received to trigger an ADMM step.*/
@@ -165,12 +184,18 @@ namespace grampcd
         /*Set initial states for neighbors.*/
         void set_neighbors_initial_states();
 
-        /*Return the current solution.*/
-        const SolutionPtr& get_solution() const;
+        /*Return a copy of the current solution, which may be read while the agent is running.*/
+        const SolutionPtr get_solution() const;
+        /*Return the data points of the current solution with an index of at least the given one, see Solution::get_solution_since.*/
+        const SolutionPtr get_solution_since(const unsigned int index) const;
+        /*Sets the maximum number of data points of the solution, zero for no limit.*/
+        void set_maximumNumberOfDataPoints(const unsigned int data_points);
         /*Sets a new solution.*/
         void set_solution(const SolutionPtr& solution);
         /*Reset the current solution.*/
         void reset_solution();
+        /*Sets a stream that logs the solution incrementally, or nullptr to stop logging.*/
+        void set_solutionStream(const SolutionStreamPtr& solution_stream);
 
     private:
         //*********************************************
@@ -189,6 +214,8 @@ namespace grampcd
 	    std::vector<typeRNum> u_init_;
 	    std::vector<typeRNum> x_des_;
 	    std::vector<typeRNum> u_des_;
+        bool is_statePredicted_ = false;
+        typeRNum predicted_dt_ = 0.0;
 
         //*********************************************
         // vector for neighbors
@@ -220,7 +247,10 @@ namespace grampcd
 
         OptimizationInfo optimizationInfo_;
         SolverLocalPtr local_solver_;
+        // the solution and its stream are updated by the controller and set by the user, e.g. while the controller runs in the background
+        mutable std::mutex mutex_solution_;
         SolutionPtr solution_;
+        SolutionStreamPtr solution_stream_;
 
         //*********************************************
         // neighbor approximation
@@ -155,6 +155,23 @@ public:
     /*Set neighbors external influence penalty state.*/
     void set_neighbors_externalInfluence_penaltyState( const PenaltyState& penalty );
 
+    //*********************************************
+    // set views on neighbor states
+    //*********************************************
+
+    /*Set view on the neighbors local copies.*/
+    void set_neighbors_localCopies( const std::shared_ptr<const AgentState>& state );
+    /*Set views on the neighbors current and previous coupling state.*/
+    void set_neighbors_couplingState( const std::shared_ptr<const CouplingState>& coupling, const std::shared_ptr<const CouplingState>& previous_coupling );
+    /*Set view on multiplier states regarding the neighbors coupling.*/
+    void set_neighbors_coupled_multiplierState( const std::shared_ptr<const MultiplierState>& multiplier );
+    /*Set view on penalty states regarding the neighbors coupling.*/
+    void set_neighbors_coupled_penaltyState( const std::shared_ptr<const PenaltyState>& penalty );
+    /*Set views on the neighbors current and previous external influence coupling state.*/
+    void set_neighbors_externalInfluence_couplingState( const std::shared_ptr<const CouplingState>& coupling, const std::shared_ptr<const CouplingState>& previous_coupling );
+    /*Release all views and fall back to the stored copies.*/
+    void release_views();
+
     //*********************************************
     // basic functions
     //*********************************************
@@ -233,6 +250,19 @@ private:
     CouplingState previous_neighbors_externalInfluence_couplingState_;
     CouplingState previous_neighbors_couplingState_;
 
+    /************************
+     Views on states of the neighbor, used
+     instead of the copies above if set
+    ************************/
+
+    std::shared_ptr<const AgentState> view_neighbors_localCopies_;
+    std::shared_ptr<const CouplingState> view_neighbors_couplingState_;
+    std::shared_ptr<const CouplingState> view_previous_neighbors_couplingState_;
+    std::shared_ptr<const MultiplierState> view_neighbors_coupled_multiplierState_;
+    std::shared_ptr<const PenaltyState> view_neighbors_coupled_penaltyState_;
+    std::shared_ptr<const CouplingState> view_neighbors_externalInfluence_couplingState_;
+    std::shared_ptr<const CouplingState> view_previous_neighbors_externalInfluence_couplingState_;
+
     /************************
      States for cost approximation
     ************************/
@@ -14,6 +14,8 @@
 
 #include "grampcd/util/class_forwarding.hpp"
 
+#include <map>
+
 namespace grampcd
 {
 
@@ -35,6 +37,8 @@ namespace grampcd
 	    virtual const bool deregister_agent(const AgentInfo& agent) = 0;
         /*Register coupling between agents.*/
         virtual const bool register_coupling(const CouplingInfo& coupling) = 0;
+        /*Register a set of couplings between agents at once.*/
+        virtual const bool register_couplings(const std::vector<CouplingInfo>& couplings) = 0;
         /*De-register coupling between agents.*/
         virtual const bool deregister_coupling(const CouplingInfo& coupling) = 0;
 
@@ -49,10 +53,12 @@ namespace grampcd
         virtual const bool send_desiredAgentState( const AgentState& desired_state, const int from, const int to ) = 0;
         /*Send coupling state to an agent.*/
         virtual const bool send_couplingState(const CouplingState& state, const int from, const int to) = 0;
+        /*Send the same coupling state to a set of agents.*/
+        virtual const bool send_couplingState(const CouplingState& state, const int from, const std::vector<int>& to) = 0;
         /*Send two coupling states to an agent.*/
         virtual const bool send_couplingState(const CouplingState& state, const CouplingState& state2, const int from, const int to) = 0;
         /*Send multiplier and penalty states to an agent.*/
-        virtual const bool send_multiplierState(const MultiplierState& state, PenaltyState penalty, const int from, const int to) = 0;
+        virtual const bool send_multiplierState(const MultiplierState& state, const PenaltyState& penalty, const int from, const int to) = 0;
         /*Send convergence flag to the coordinator.*/
         virtual const bool send_convergenceFlag(const bool converged, const int from) = 0;
 
@@ -61,6 +67,10 @@ namespace grampcd
 
         /*Trigger a step of the ADMM algorithm.*/
         virtual const bool trigger_step(const ADMMStep& step) = 0;
+        /*Set the deadline for each triggered step, non-positive values restore the default.*/
+        virtual void set_stepTimeout(const typeRNum timeout) = 0;
+        /*Set the deadline for each triggered step that sends states or flags, non-positive values use the deadline of all steps.*/
+        virtual void set_communicationTimeout(const typeRNum timeout) = 0;
         /*Trigger simulation.*/
         virtual void trigger_simulation(const std::string& Integrator, const typeRNum dt) = 0;
 
@@ -74,6 +84,8 @@ namespace grampcd
         virtual const std::shared_ptr< std::map< unsigned int, std::vector< CouplingInfoPtr > > > get_sendingNeighbors_from_coordinator() const = 0;
         /*Return a map with receiving neighbors.*/
         virtual const std::shared_ptr< std::map< unsigned int, std::vector< CouplingInfoPtr > > > get_receivingNeighbors_from_coordinator() const = 0;
+        /*Return the topology version of the coordinator, which changes whenever agents or couplings change.*/
+        virtual const unsigned int get_topologyVersion_from_coordinator() const = 0;
         /*Return the agent model of an agent.*/
         virtual const AgentModelPtr get_agentModel(const int agentId ) const = 0;
         /*Return all coupling models of an agent.*/
@@ -92,6 +104,10 @@ namespace grampcd
 	    virtual const SolutionPtr get_solution(const unsigned int agent_id) const = 0;
         /*Return the current solution of a set of agents.*/
 	    virtual const std::vector< SolutionPtr > get_solution(const std::string& agents) const = 0;
+        /*Returns the data points of an agent since an index and its current prediction.*/
+        virtual const SolutionPtr get_solution_since(const unsigned int agent_id, const unsigned int index) const = 0;
+        /*Returns the data points of a set of agents since the indices given per agent id and their current predictions.*/
+        virtual const std::vector< SolutionPtr > get_solution_since(const std::string& agents, const std::map<int, unsigned int>& indices) const = 0;
         /*Resets the solution of an agent.*/
         virtual void reset_solution(const unsigned int agent_id) = 0;
         /*Resets the solution of a set of agents.*/
@@ -99,6 +115,8 @@ namespace grampcd
 
         /*Wait for connections.*/
 	    virtual void waitFor_connection(const int agents, const int couplings) = 0;
+        /*Wait for sub-coordinators and hand each of them a partition of the network.*/
+	    virtual void waitFor_subCoordinators(const int number) = 0;
         /*Wait for a flag of the coordinator.*/
 	    virtual void waitFor_flag_from_coordinator() = 0;
         /*Send flag to a set of agents.*/
@@ -112,6 +130,8 @@ namespace grampcd
 
         /*Cap the stored data to a number of data points.*/
 	    virtual void cap_stored_data(const unsigned int data_points) = 0;
+        /*Set a stream that logs the solutions of the local agents incrementally, or nullptr to stop logging.*/
+        virtual void set_solutionStream(const SolutionStreamPtr& solution_stream) = 0;
         /*Returns the number of agents.*/
         virtual const unsigned int get_numberOfAgents() const = 0;
 
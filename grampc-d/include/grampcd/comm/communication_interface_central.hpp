@@ -28,12 +28,14 @@ namespace grampcd
 	 *
 	 * Implementation of a communication interface that has direct access to all agents.
 	 * This means that all agents run within the same process.
+	 * In zero-copy mode, states that are owned by the sending agent are not copied
+	 * into the receiving neighbor but handed over as read-only views.
 	*/
 	class CommunicationInterfaceCentral : public CommunicationInterface
 	{
 	public:
 
-		CommunicationInterfaceCentral(const LoggingPtr& log, const int number_of_threads = 0);
+		CommunicationInterfaceCentral(const LoggingPtr& log, const int number_of_threads = 0, const bool zero_copy = false);
 
 		void set_coordinator(const CoordinatorPtr& coordinator);
 		void set_simulator(const SimulatorPtr& simulator);
@@ -44,6 +46,8 @@ namespace grampcd
 		const bool deregister_agent(const AgentInfo& agent) override;
 		/*Register coupling between agents.*/
 		const bool register_coupling(const CouplingInfo& coupling) override;
+		/*Register a set of couplings between agents at once.*/
+		const bool register_couplings(const std::vector<CouplingInfo>& couplings) override;
 		/*De-register coupling between agents.*/
 		const bool deregister_coupling(const CouplingInfo& coupling) override;
 
@@ -58,10 +62,12 @@ namespace grampcd
 		const bool send_desiredAgentState(const AgentState& desired_state, const int from, const int to) override;
 		/*Send coupling state to an agent.*/
 		const bool send_couplingState(const CouplingState& state, const int from, const int to) override;
+		/*Send the same coupling state to a set of agents.*/
+		const bool send_couplingState(const CouplingState& state, const int from, const std::vector<int>& to) override;
 		/*Send two coupling states to an agent.*/
 		const bool send_couplingState(const CouplingState& state, const CouplingState& state2, const int from, const int to) override;
 		/*Send multiplier and penalty states to an agent.*/
-		const bool send_multiplierState(const MultiplierState& state, PenaltyState penalty, const int from, const int to) override;
+		const bool send_multiplierState(const MultiplierState& state, const PenaltyState& penalty, const int from, const int to) override;
 		/*Send convergence flag to the coordinator.*/
 		const bool send_convergenceFlag(const bool converged, const int from) override;
 
@@ -70,6 +76,9 @@ namespace grampcd
 
 		/*Trigger a step of the ADMM algorithm.*/
 		const bool trigger_step(const ADMMStep& step) override;
+		/*Set the deadline for each triggered step.*/
+		void set_stepTimeout(const typeRNum timeout) override;
+		void set_communicationTimeout(const typeRNum timeout) override;
 		/*Trigger simulation.*/
 		void trigger_simulation(const std::string& Integrator, const typeRNum dt) override;
 
@@ -83,6 +92,8 @@ namespace grampcd
 		const std::shared_ptr< std::map< unsigned int, std::vector< CouplingInfoPtr > > > get_sendingNeighbors_from_coordinator() const override;
 		/*Return a map with receiving neighbors.*/
 		const std::shared_ptr< std::map< unsigned int, std::vector< CouplingInfoPtr > > > get_receivingNeighbors_from_coordinator() const override;
+		/*Return the topology version of the coordinator.*/
+		const unsigned int get_topologyVersion_from_coordinator() const override;
 		/*Return the agent model of an agent.*/
 		const AgentModelPtr get_agentModel(const int agentId) const override;
 		/*Return all coupling models of an agent.*/
@@ -101,6 +112,10 @@ namespace grampcd
 		const SolutionPtr get_solution(const unsigned int agent_id) const override;
 		/*Return the current solution of a set of agents.*/
 		const std::vector< SolutionPtr > get_solution(const std::string& agents) const override;
+		/*Returns the data points of an agent since an index and its current prediction.*/
+		const SolutionPtr get_solution_since(const unsigned int agent_id, const unsigned int index) const override;
+		/*Returns the data points of a set of agents since the indices given per agent id and their current predictions.*/
+		const std::vector< SolutionPtr > get_solution_since(const std::string& agents, const std::map<int, unsigned int>& indices) const override;
 		/*Resets the solution of an agent.*/
 		void reset_solution(const unsigned int agent_id) override;
 		/*Resets the solution of a set of agents.*/
@@ -108,6 +123,8 @@ namespace grampcd
 
 		/*Wait for connections.*/
 		void waitFor_connection(const int agents, const int couplings) override;
+		/*Wait for sub-coordinators.*/
+		void waitFor_subCoordinators(const int number) override;
 		/*Wait for a flag of the coordinator.*/
 		void waitFor_flag_from_coordinator() override;
 		/*Send flag to a set of agents.*/
@@ -121,16 +138,27 @@ namespace grampcd
 
 		/*Cap the stored data to a number of data points.*/
 		void cap_stored_data(const unsigned int data_points) override;
+		/*Set a stream that logs the solutions of the agents incrementally, or nullptr to stop logging.*/
+		void set_solutionStream(const SolutionStreamPtr& solution_stream) override;
 		/*Returns the number of agents.*/
 		const unsigned int get_numberOfAgents() const override;
 
+		/*Returns true if states are handed over as views instead of copies.*/
+		const bool is_zeroCopy() const;
+
 	private:
+		/*Returns the neighbor of the sending agent that represents the receiving agent.*/
+		const NeighborPtr get_neighbor_of_agent(const int from, const int to) const;
+		/*Inform both agents of a coupling that is registered at the coordinator.*/
+		const bool send_registeredCoupling(const CouplingInfo& coupling);
+
 		CommunicationInfo comm_info_;
 		CoordinatorPtr coordinator_;
 		SimulatorPtr simulator_;
 		std::vector<AgentPtr> agents_;
 
 		LoggingPtr log_;
+		bool zero_copy_ = false;
 		std::ostringstream stream_;
 
 		asio::io_service ioService_;
@@ -18,10 +18,14 @@
 
 #include "grampcd/info/communication_info.hpp"
 
+#include "grampcd/comm/timer_wheel.hpp"
+
 #include "asio.hpp"
 
 #include <shared_mutex>
 #include <functional>
+#include <map>
+#include <mutex>
 
 namespace grampcd
 {
@@ -31,23 +35,32 @@ namespace grampcd
 	 *
 	 * Implementation of a communication interface that has direct access to all agents.
 	 * This means that all agents run within the same process.
+	 *
+	 * A single connection per pair of processes carries the messages of all their agents. Each pair of
+	 * agents communicates over a channel, whose messages are preceded by the ids of the sending and the
+	 * receiving agent. Agents of the same process exchange their messages without a socket.
 	*/
 	class CommunicationInterfaceLocal : public CommunicationInterface
 	{
 	public:
 
 		~CommunicationInterfaceLocal();
-		CommunicationInterfaceLocal(const LoggingPtr& log, const unsigned short port);
-		CommunicationInterfaceLocal(const LoggingPtr& log, const CommunicationInfo& comm_info_coordinator);
+		CommunicationInterfaceLocal(const LoggingPtr& log, const unsigned short port, const int number_of_threads = 0);
+		CommunicationInterfaceLocal(const LoggingPtr& log, const CommunicationInfo& comm_info_coordinator, const int number_of_threads = 0);
+		CommunicationInterfaceLocal(const LoggingPtr& log, const CommunicationInfo& comm_info_coordinator, const unsigned short port, const int number_of_threads = 0);
 
 		/*Returns the communication data of an agent.*/
 		const CommunicationDataPtr get_communicationData(const int agent_id) const;
 		/*Returns the communication data of the coordinator.*/
 		const CommunicationDataPtr get_communicationData(const std::string& agent_type) const;
+		/*Returns the communication data between a local agent and an agent.*/
+		const CommunicationDataPtr get_communicationData(const int local_id, const int agent_id) const;
+		/*Returns the communication data between a local agent and the coordinator or its sub-coordinator.*/
+		const CommunicationDataPtr get_communicationData(const int local_id, const std::string& agent_type) const;
 
 		/*Set the coordinator.*/
 		void set_coordinator(const CoordinatorPtr& coordinator);
-		/*Set an agent.*/
+		/*Add an agent that runs behind this interface.*/
 		void set_agent(const AgentPtr& agent);
 		/*Set the simulator.*/
 		void set_simulator(const SimulatorPtr& simulator);
@@ -62,6 +75,8 @@ namespace grampcd
 		const bool deregister_agent(const AgentInfo& agent) override;
 		/*Register coupling between agents.*/
 		const bool register_coupling(const CouplingInfo& coupling) override;
+		/*Register a set of couplings between agents at once.*/
+		const bool register_couplings(const std::vector<CouplingInfo>& couplings) override;
 		/*De-register coupling between agents.*/
 		const bool deregister_coupling(const CouplingInfo& coupling) override;
 
@@ -76,10 +91,12 @@ namespace grampcd
 		const bool send_desiredAgentState(const AgentState& desired_state, const int from, const int to) override;
 		/*Send coupling state to an agent.*/
 		const bool send_couplingState(const CouplingState& state, const int from, const int to) override;
+		/*Send the same coupling state to a set of agents, with a single datagram if multicast is active.*/
+		const bool send_couplingState(const CouplingState& state, const int from, const std::vector<int>& to) override;
 		/*Send two coupling states to an agent.*/
 		const bool send_couplingState(const CouplingState& state, const CouplingState& state2, const int from, const int to) override;
 		/*Send multiplier and penalty states to an agent.*/
-		const bool send_multiplierState(const MultiplierState& state, PenaltyState penalty, const int from, const int to) override;
+		const bool send_multiplierState(const MultiplierState& state, const PenaltyState& penalty, const int from, const int to) override;
 		/*Send convergence flag to the coordinator.*/
 		const bool send_convergenceFlag(const bool converged, const int from) override;
 
@@ -89,6 +106,10 @@ namespace grampcd
 
 		/*Trigger a step of the ADMM algorithm.*/
 		const bool trigger_step(const ADMMStep& step) override;
+		/*Set the deadline for each triggered step.*/
+		void set_stepTimeout(const typeRNum timeout) override;
+		/*Set the deadline for each triggered step that sends states or flags.*/
+		void set_communicationTimeout(const typeRNum timeout) override;
 		/*Trigger simulation.*/
 		void trigger_simulation(const std::string& Integrator, const typeRNum dt) override;
 
@@ -102,6 +123,8 @@ namespace grampcd
 		const std::shared_ptr< std::map< unsigned int, std::vector< CouplingInfoPtr > > > get_sendingNeighbors_from_coordinator() const override;
 		/*Return a map with receiving neighbors.*/
 		const std::shared_ptr< std::map< unsigned int, std::vector< CouplingInfoPtr > > > get_receivingNeighbors_from_coordinator() const override;
+		/*Return the topology version of the coordinator.*/
+		const unsigned int get_topologyVersion_from_coordinator() const override;
 		/*Return the agent model of an agent.*/
 		const AgentModelPtr get_agentModel(const int agentId) const override;
 		/*Return all coupling models of an agent.*/
@@ -120,6 +143,10 @@ namespace grampcd
 		const SolutionPtr get_solution(const unsigned int agent_id) const override;
 		/*Return the current solution of a set of agents.*/
 		const std::vector< SolutionPtr > get_solution(const std::string& agents) const override;
+		/*Returns the data points of an agent since an index and its current prediction, which only transfers the new data points.*/
+		const SolutionPtr get_solution_since(const unsigned int agent_id, const unsigned int index) const override;
+		/*Returns the data points of a set of agents since the indices given per agent id and their current predictions.*/
+		const std::vector< SolutionPtr > get_solution_since(const std::string& agents, const std::map<int, unsigned int>& indices) const override;
 		/*Resets the solution of an agent.*/
 		void reset_solution(const unsigned int agent_id) override;
 		/*Resets the solution of a set of agents.*/
@@ -127,6 +154,8 @@ namespace grampcd
 
 		/*Wait for connections.*/
 		void waitFor_connection(const int agents, const int couplings) override;
+		/*Wait for sub-coordinators and hand each of them a partition of the network.*/
+		void waitFor_subCoordinators(const int number) override;
 		/*Wait for a flag of the coordinator.*/
 		void waitFor_flag_from_coordinator() override;
 		/*Send flag to a set of agents.*/
@@ -140,6 +169,8 @@ namespace grampcd
 
 		/*Cap the stored data to a number of data points.*/
 		void cap_stored_data(const unsigned int data_points) override;
+		/*Set a stream that logs the solutions of the local agents incrementally, or nullptr to stop logging.*/
+		void set_solutionStream(const SolutionStreamPtr& solution_stream) override;
 		/*Returns the number of agents.*/
 		const unsigned int get_numberOfAgents() const override;
 
@@ -151,6 +182,13 @@ namespace grampcd
 		void fromCommunication_get_ping(const CommunicationDataPtr& comm_data) const;
 		/*This function is called if ping is received.*/
 		void fromCommunication_send_ping(const CommunicationDataPtr& comm_data) const;
+		/*This function is called if the wire format of the connected host is received.*/
+		void fromCommunication_send_wireFormat(const CommunicationDataPtr& comm_data, const unsigned int version,
+			const unsigned int size_of_typeRNum, const bool little_endian);
+		/*This function is called if the port on which the connected host accepts connections is received.*/
+		void fromCommunication_send_listeningPort(const CommunicationDataPtr& comm_data, const unsigned int port);
+		/*This function is called if the connected host closed a channel.*/
+		void fromCommunication_close_channel(const CommunicationDataPtr& comm_data);
 		/*This function is called if requirement for number of active couplings is received.*/
 		void fromCommunication_get_numberOfActiveCouplings(const CommunicationDataPtr& comm_data) const;
 		/*This function is called if number of active couplings is received.*/
@@ -213,10 +251,16 @@ namespace grampcd
 		/*This function is called if acknowledgment for executed ADMM step is received.*/
 		void fromCommunication_received_acknowledgement_executed_ADMMstep(const CommunicationDataPtr& comm_data) const;
 		/*This function is called if ADMM step should be triggered.*/
-		void fromCommunication_triggerStep(ADMMStep step);
+		void fromCommunication_triggerStep(const CommunicationDataPtr& comm_data, ADMMStep step, const unsigned int step_timeout_ms);
+		/*This function is called if a partition of the network is assigned to a sub-coordinator.*/
+		void fromCommunication_assign_partition(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<int> >& agent_ids);
+		/*This function is called if the communication info of the responsible sub-coordinator is received.*/
+		void fromCommunication_send_subCoordinatorInfo(const CommunicationDataPtr& comm_data, const CommunicationInfoPtr& info);
 
 		/*This function is called if coupling should be registered.*/
 		void fromCommunication_register_coupling(const CommunicationDataPtr& comm_data, const CouplingInfoPtr& info);
+		/*This function is called if a set of couplings should be registered.*/
+		void fromCommunication_register_couplings(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<CouplingInfo> >& infos);
 		/*This function is called if coupling is successfully registered.*/
 		void fromCommunication_successfully_registered_coupling(const CommunicationDataPtr& comm_data,
 			const CouplingInfoPtr& coupling_info, const AgentInfoPtr& agent_info, const CommunicationInfoPtr& communication_info);
@@ -229,32 +273,76 @@ namespace grampcd
 		void fromCommunication_get_solution(const CommunicationDataPtr& comm_data) const;
 		/*This function is called if solution is received.*/
 		void fromCommunication_send_solution(const CommunicationDataPtr& comm_data, const SolutionPtr& solution) const;
+		/*This function is called if requirement for the data points of the solution since an index is received.*/
+		void fromCommunication_get_solution_since(const CommunicationDataPtr& comm_data, const unsigned int index) const;
 
 	private:
+		/*@brief Agent that runs behind this interface.*/
+		struct LocalAgent
+		{
+			AgentPtr agent_;
+			/*Mutex that serializes the calls to the agent.*/
+			std::mutex mutex_;
+			/*Channel over which the last step was triggered, the convergence flag is returned over it.*/
+			CommunicationDataPtr comm_data_triggerStep_;
+		};
+
+		/*Returns an agent that runs behind this interface, nullptr if it is not known.*/
+		const std::shared_ptr<LocalAgent> get_localAgent(const int id) const;
+		/*Returns all agents that run behind this interface.*/
+		const std::map< int, std::shared_ptr<LocalAgent> > get_localAgents() const;
+		/*Returns the communication info of this process for a local agent.*/
+		const CommunicationInfo get_communicationInfo(const int local_id) const;
+		/*Send the request to each connected agent it is built for, nullptr skips the agent, and wait for their solutions.*/
+		const std::vector<SolutionPtr> request_solutions(const std::function<const std::shared_ptr<std::vector<char>>(const CommunicationDataPtr&)>& build_request) const;
+
+		/*Returns the connection to the process that accepts connections on the endpoint, which is established if required.*/
+		const CommunicationDataPtr get_link(const std::string& ip, const std::string& port);
+		/*Returns the connection that carries the messages of communication data.*/
+		const CommunicationDataPtr& get_connection(const CommunicationDataPtr& comm_data) const;
+		/*Returns the channel of a connection between a local agent and a connected agent, nullptr if it does not exist.*/
+		const CommunicationDataPtr find_channel(const CommunicationDataPtr& link, const int local_id, const int remote_id) const;
+		/*Returns the channel of a connection between a local agent and a connected agent, which is created if it does not exist.*/
+		const CommunicationDataPtr create_channel(const CommunicationDataPtr& link, const int local_id, const int remote_id, const CommunicationInfoPtr& info);
+		/*Returns the channel of a local agent to the coordinator, which is created if required.*/
+		const CommunicationDataPtr get_channel_to_coordinator(const int local_id);
+		/*Returns the channel a received message is addressed to, a channel opened by the connected host is accepted.*/
+		const CommunicationDataPtr accept_channel(const CommunicationDataPtr& link, const int from, const int to);
+		/*Open a channel as soon as its connection is established.*/
+		void open_channel(const CommunicationDataPtr& channel);
+		/*Handle the closing of a channel.*/
+		void handle_disconnect_channel(const CommunicationDataPtr& channel);
+		/*Close all channels of a local agent to agents and sub-coordinators.*/
+		void close_channels(const int local_id);
+
 		/*Start an server.*/
 		void start_server();
 		/*Start a client.*/
 		void start_client();
+		/*Start threads that run the ioService until there are the given number.*/
+		void start_threads(const int number);
 
 		/*Function handler for accepting connections.*/
 		void acceptHandler(const std::error_code &ec, CommunicationDataPtr comm_data);
 		/*Function handler for receiving messages.*/
 		void readHandler(const std::error_code&ec, const size_t &amountOfBytes, CommunicationDataPtr comm_data);
 		/*Function handler for sending messages.*/
-		void writeHandler(const std::error_code& ec, std::size_t bytes_transferred, CommunicationDataPtr comm_data, std::shared_ptr<std::vector<char>> data_ptr) const;
+		void writeHandler(const std::error_code& ec, std::size_t bytes_transferred, CommunicationDataPtr comm_data) const;
 		/*Function handler for connections.*/
 		void connectHandler(const std::error_code &ec, CommunicationDataPtr comm_data);
 
-		/*Start the polling.*/
-		void start_polling(const CommunicationDataPtr& comm_data) const;
-		/*Poll the registrations.*/
-		void poll_registration(const std::error_code &ec, CommunicationDataPtr comm_data) const;
-		/*Start the ping.*/
-		void start_ping(const CommunicationDataPtr& comm_data);
-		/*Poll the ping.*/
-		void poll_ping(const std::error_code &ec, CommunicationDataPtr comm_data);
-		/*Poll checking the connection.*/
-		void poll_check_connection(const std::error_code &ec, CommunicationDataPtr comm_data);
+		/*Send the pending registrations to the coordinator as soon as it is connected.*/
+		void request_registration();
+		/*Send the pending registrations and retry until they are answered.*/
+		void send_registrations();
+		/*Enable TCP keepalive and the user timeout on a connected socket.*/
+		void configure_keepalive(const CommunicationDataPtr& comm_data) const;
+		/*Start checking if the connection is alive.*/
+		void start_liveness(const CommunicationDataPtr& comm_data);
+		/*Stop checking if the connection is alive.*/
+		void stop_liveness(const CommunicationDataPtr& comm_data);
+		/*Check if data was received recently, ping if the connection is idle and disconnect if the ping is not answered.*/
+		void check_liveness(const CommunicationDataPtr& comm_data, const unsigned int session);
 
 		/*Handle a disconnect.*/
 		void handle_disconnect(const CommunicationDataPtr& comm_data);
@@ -262,9 +350,22 @@ namespace grampcd
 		void handle_disconnect_as_agent(const CommunicationDataPtr& comm_data);
 		/*Handle the disconnect of the coordinator.*/
 		void handle_disconnect_as_coordinator(const CommunicationDataPtr& comm_data);
-
-		/*Connect to a neighbor.*/
-		void connect_to_neighbor(const CommunicationInfoPtr& comm_info);
+		/*Handle a disconnect as sub-coordinator.*/
+		void handle_disconnect_as_subCoordinator(const CommunicationDataPtr& comm_data);
+
+		/*Forward a triggered step to the agents of the partition and report back to the coordinator within the deadline of the coordinator.*/
+		void forward_step(const CommunicationDataPtr& comm_data_coordinator, const ADMMStep& step, const unsigned int step_timeout_ms);
+		/*Send data that is acknowledged within the current phase. Requires mutex_triggerStep_.*/
+		void send_with_acknowledgement(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data);
+		/*Expect an acknowledgement within the current phase. Requires mutex_triggerStep_.*/
+		void expect_acknowledgement(const CommunicationDataPtr& comm_data);
+		/*Register an acknowledgement and return whether it belongs to the current phase. Requires mutex_triggerStep_.*/
+		const bool register_acknowledgement(const CommunicationDataPtr& comm_data) const;
+		/*Discard the acknowledgements that a closed channel does not send anymore.*/
+		void clear_acknowledgements(const CommunicationDataPtr& comm_data) const;
+
+		/*Connect a local agent to a neighbor.*/
+		void connect_to_neighbor(const int local_id, const CommunicationInfoPtr& comm_info);
 		/*Close a socket.*/
 		void close_socket(const CommunicationDataPtr& comm_data) const;
 		/*Close and shutdown a socket.*/
@@ -272,6 +373,48 @@ namespace grampcd
 
 		/*Send data asynchronously.*/
 		void async_send(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data) const;
+		/*Queue the header of a message of a channel. Requires mutex_buffer_send_ of the connection.*/
+		void queue_channelHeader(const CommunicationDataPtr& channel, const unsigned int size_of_message) const;
+		/*Hand a message to an agent of this process.*/
+		void deliver_loopback(const CommunicationDataPtr& channel, const std::shared_ptr< std::vector<char> >& data) const;
+		/*Write all queued messages with a single vectored write. Requires mutex_buffer_send_.*/
+		void start_write(const CommunicationDataPtr& comm_data) const;
+		/*Start writing the queued messages, or defer it to the end of the batch. Requires mutex_buffer_send_.*/
+		void request_write(const CommunicationDataPtr& comm_data) const;
+		/*Defer the writes of all messages that this thread sends until the batch is written.*/
+		void start_batch() const;
+		/*Start the deferred writes of all connections together.*/
+		void write_batch() const;
+		/*Send data compressed, as difference to the last message with the same index if delta encoding is active.*/
+		void send_compressed(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data) const;
+		/*Returns true if states are sent compressed.*/
+		const bool is_compressing() const;
+		/*Quantize a trajectory regarding the configured quantization.*/
+		void quantize(std::vector<typeRNum>& trajectory) const;
+		/*Decompress data if required and evaluate it asynchronously.*/
+		void dispatch_data(const CommunicationDataPtr& comm_data, std::shared_ptr< std::vector<char> > data);
+
+		/*Offer shared memory to the connected host, if it runs on the same machine.*/
+		void offer_sharedMemory(const CommunicationDataPtr& comm_data) const;
+		/*Handle the messages that switch a connection to shared memory.*/
+		void handle_sharedMemory(const CommunicationDataPtr& comm_data, const std::vector<char>& data);
+		/*Send the last message over the socket and all following messages over shared memory.*/
+		void switch_to_sharedMemory(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data) const;
+		/*Start receiving messages over shared memory.*/
+		void start_reading_sharedMemory(const CommunicationDataPtr& comm_data);
+		/*Receive messages over shared memory until the channel is closed.*/
+		void read_sharedMemory(const std::weak_ptr<CommunicationData>& weak_comm_data, const SharedMemoryChannelPtr& channel);
+		/*Close the shared memory channel and wait for the receiving thread.*/
+		void close_sharedMemory(const CommunicationDataPtr& comm_data) const;
+
+		/*Open or close the multicast channel regarding the optimization info.*/
+		void configure_multicast(const OptimizationInfo& info, const int id);
+		/*Returns the multicast channel, which is nullptr if multicast is not active.*/
+		const MulticastChannelPtr get_multicastChannel() const;
+		/*Receive the multicast messages of an agent or the coordinator, if id is -1.*/
+		void join_multicastGroup(const int id) const;
+		/*Evaluate a message received via multicast.*/
+		void receive_multicast(const int sender, const int receiver, const std::shared_ptr< std::vector<char> >& message);
 		/*Connect asynchronously.*/
 		void async_connect(const CommunicationDataPtr& comm_data);
 		/*Connect asynchronously.*/
@@ -281,17 +424,15 @@ namespace grampcd
 		/*Read data asynchronously.*/
 		void async_read_some(const CommunicationDataPtr& comm_data);
 
-		mutable std::mutex mutex_stream_;
-		LoggingPtr log_;
-		std::ostringstream stream_;
-
 		mutable std::shared_mutex mutex_basics_;
-		AgentPtr agent_;
+		std::map< int, std::shared_ptr<LocalAgent> > agents_;
 		SimulatorPtr simulator_;
-		std::vector<AgentInfo> agents_;
 		CommunicationInfo comm_info_local_;
 		CommunicationInfo comm_info_coordinator_;
-		const int number_of_threads_ = 4;
+		// threads that run the ioService, at least one more than agents of this process as their handlers may block
+		const int number_of_threads_;
+		static const int default_number_of_threads_ = 4;
+		static const int min_number_of_threads_ = 2;
 
 		mutable std::shared_mutex mutex_coordinator_;
 		CoordinatorPtr coordinator_;
@@ -309,25 +450,60 @@ namespace grampcd
 		std::vector<CouplingInfo> coupling_infos_deregistering_;
 		std::vector<CouplingInfo> coupling_infos_blocked_;
 
+		// agents of the partition, if this is a sub-coordinator
+		std::vector<int> partition_;
+
+		// channels to all connected agents, sub-coordinators and the coordinator
 		mutable std::shared_mutex mutex_comm_data_vec_;
 		std::vector<CommunicationDataPtr> comm_data_vec_;
+		// connections to other processes, protected by mutex_comm_data_vec_
+		std::vector<CommunicationDataPtr> link_vec_;
+		CommunicationDataPtr link_coordinator_;
+		// connection between the agents of this process, which delivers messages without a socket
+		CommunicationDataPtr link_loopback_;
 		std::vector<CommunicationDataPtr> comm_data_vec_to_delete_;
+		std::map<int, CommunicationDataPtr> subCoordinator_of_agent_;
 
 		asio::io_service ioService_;
+		// connections with deferred writes of the batch that the current thread sends
+		static thread_local bool is_batching_;
+		static thread_local std::vector<CommunicationDataPtr> batch_;
 		asio::ip::tcp::acceptor acceptor_;
+		std::mutex mutex_threads_;
 		std::vector< std::thread > threads_for_communication_;
+		mutable std::mutex mutex_multicast_;
+		MulticastChannelPtr multicast_;
 		asio::basic_waitable_timer<std::chrono::system_clock>  timer_waitForAck_;
 		asio::basic_waitable_timer<std::chrono::system_clock>  timer_waitTrue_;
+		// timeouts of all connections
+		const std::chrono::milliseconds timer_wheel_resolution_ = std::chrono::milliseconds(100);
+		TimerWheel timer_wheel_;
+
+		mutable std::mutex mutex_stream_;
+		LoggingPtr log_;
+		std::ostringstream stream_;
+
+		// pending retry of the registrations, protected by mutex_infos_
+		TimerWheel::Handle timeout_registration_ = 0;
 		const unsigned int general_waiting_time_s_ = 2;
 		const unsigned int polling_period_s_ = 3;
 		const unsigned int ping_period_s_ = 2;
 		const unsigned int ping_waiting_time_ms_ = 1500;
+		const std::size_t max_size_buffer_read_ = 65536;
+		bool is_deltaEncoding_ = false;
+		unsigned int quantization_mantissa_bits_ = 0;
+		typeRNum quantization_tolerance_ = 0;
 		const bool disconnect_at_timeout_ = true;
 
 		// variables to wait for: trigger step
 		mutable std::mutex mutex_triggerStep_;
 		mutable int numberOfNotifications_triggerStep_;
 		mutable std::condition_variable conditionVariable_triggerStep_;
+		mutable bool partition_converged_ = true;
+		unsigned int phase_triggerStep_ = 0;
+		std::chrono::milliseconds step_timeout_ = std::chrono::seconds(general_waiting_time_s_);
+		// deadline of the steps that send states or flags, zero if step_timeout_ applies
+		std::chrono::milliseconds communication_timeout_ = std::chrono::milliseconds(0);
 
 		// variables to wait for: get solutions
 		mutable std::mutex mutex_getSolutions_;
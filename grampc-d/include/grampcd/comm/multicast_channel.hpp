@@ -0,0 +1,146 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#pragma once
+
+#include "grampcd/util/class_forwarding.hpp"
+
+#include "asio.hpp"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace grampcd
+{
+
+	/*!
+	 * @brief Reliable UDP multicast of protocol messages
+	 *
+	 * Each host sends to its own multicast group, the coordinator to the first address of the range
+	 * and agent i to the address with offset i+1. Datagrams carry a session of the sender and a sequence number,
+	 * which starts at zero in each session. A receiver starts over if the session of a sender changes, e.g. after a restart,
+	 * and skips the data that was sent before the first datagram it receives of a session.
+	 * Receivers deliver them in order and request missing ones with a negative acknowledgement (NACK),
+	 * which the sender answers from its history via unicast. Heartbeats with the last sequence number
+	 * follow each message with increasing intervals, so that the loss of the last message is detected.
+	 * A process that hosts several agents sends to the group of one of them and delivers the received
+	 * messages to each addressed agent.
+	*/
+	class MulticastChannel : public std::enable_shared_from_this<MulticastChannel>
+	{
+	public:
+		/*Function that is called for each received message and each receiver of this host it is addressed to.*/
+		typedef std::function<void(const int sender, const int receiver, const std::shared_ptr< std::vector<char> >& message)> ReceiveCallback;
+
+		MulticastChannel(const LoggingPtr& log, asio::io_service& ioService, const int id, const ReceiveCallback& callback);
+
+		/*Bind the sockets to the given range of multicast groups. Returns false if this fails.*/
+		const bool open(const std::string& address, const unsigned short port);
+		/*Close the sockets.*/
+		void close();
+		/*Returns true if the channel uses the given range of multicast groups.*/
+		const bool is_using(const std::string& address, const unsigned short port) const;
+
+		/*Deliver the messages that are addressed to another agent of this host.*/
+		void add_receiver(const int id);
+		/*Receive the messages of a sender.*/
+		void join(const int sender);
+		/*Send a message of the sender to the group of this host, it is delivered to the given receivers only.
+		Returns false if it is not sent, e.g. if the group belongs to another sender.*/
+		const bool send(const int sender, const std::vector<int>& receivers, const std::shared_ptr< std::vector<char> >& message);
+
+	private:
+		enum class DatagramType : char
+		{
+			data = 0,
+			heartbeat = 1,
+			nack = 2,
+			unavailable = 3
+		};
+
+		/*@brief State of the messages received from one sender.*/
+		struct Receiver
+		{
+			/*Flag that states if a message of the sender is received.*/
+			bool is_initialized_ = false;
+			/*Session of the sender.*/
+			unsigned int session_ = 0;
+			/*Sequence number of the next message that is delivered.*/
+			unsigned int next_sequence_ = 0;
+			/*Messages that are received ahead of a missing one.*/
+			std::map< unsigned int, std::shared_ptr< std::vector<char> > > pending_;
+		};
+
+		/*@brief Socket with its receive buffer.*/
+		struct Endpoint
+		{
+			Endpoint(asio::io_service& ioService) : socket_(ioService) {}
+
+			asio::ip::udp::socket socket_;
+			std::vector<char> buffer_ = std::vector<char>(65536, 0);
+			asio::ip::udp::endpoint sender_endpoint_;
+		};
+
+		/*Returns the multicast group of a sender.*/
+		const asio::ip::address_v4 get_group(const int sender) const;
+
+		/*Receive the next datagram asynchronously.*/
+		void async_receive(Endpoint& endpoint);
+		/*Function handler for received datagrams.*/
+		void receiveHandler(const asio::error_code& ec, const std::size_t bytes_transferred, Endpoint& endpoint);
+		/*Evaluate a datagram. Requires mutex_.*/
+		void evaluate_datagram(const std::vector<char>& datagram, const asio::ip::udp::endpoint& from);
+		/*Deliver the pending data in order, as long as no data is missing. Requires mutex_.*/
+		void deliver(const int sender, Receiver& receiver);
+		/*Request missing data from a sender. Requires mutex_.*/
+		void send_nack(const int sender, const unsigned int session, const unsigned int first, const unsigned int last, const asio::ip::udp::endpoint& to);
+		/*Answer a request for missing data. Requires mutex_.*/
+		void send_retransmission(unsigned int first, unsigned int last, const asio::ip::udp::endpoint& to);
+
+		/*Start sending heartbeats after a message was sent. Requires mutex_.*/
+		void start_heartbeat();
+		/*Function handler for sending heartbeats.*/
+		void heartbeatHandler(const asio::error_code& ec);
+
+		LoggingPtr log_;
+		const int id_;
+		const ReceiveCallback callback_;
+
+		mutable std::mutex mutex_;
+		// socket that is bound to the port of the groups and receives the joined groups
+		Endpoint endpoint_group_;
+		// socket that sends data and receives unicast datagrams, i.e. NACKs and retransmissions
+		Endpoint endpoint_unicast_;
+		asio::ip::address_v4 first_group_;
+		unsigned short port_ = 0;
+		bool is_open_ = false;
+
+		// sent data
+		const unsigned int session_;
+		unsigned int sequence_ = 0;
+		std::deque< std::shared_ptr< std::vector<char> > > history_;
+		const std::size_t max_size_history_ = 256;
+		asio::basic_waitable_timer<std::chrono::system_clock> timer_heartbeat_;
+		unsigned int number_of_heartbeats_ = 0;
+		const unsigned int max_number_of_heartbeats_ = 7;
+
+		// received data
+		std::set<int> local_ids_;
+		std::set<int> joined_senders_;
+		std::map<int, Receiver> receivers_;
+		const std::size_t max_number_of_pending_ = 1024;
+	};
+
+}
@@ -0,0 +1,70 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#pragma once
+
+#include "grampcd/util/class_forwarding.hpp"
+
+#include <string>
+
+namespace grampcd
+{
+
+	struct SharedMemorySegment;
+	struct SharedMemoryRing;
+
+	/*!
+	 * @brief Channel between two processes on the same host
+	 *
+	 * A POSIX shared memory segment contains a lock-free single-producer single-consumer
+	 * ring buffer for each direction. Waiting threads sleep on a futex in the segment.
+	 * Shared memory is only supported on Linux, elsewhere no channel is created.
+	*/
+	class SharedMemoryChannel
+	{
+	public:
+		~SharedMemoryChannel();
+
+		/*Create a new shared memory segment. Returns nullptr if this fails.*/
+		static SharedMemoryChannelPtr create(const LoggingPtr& log);
+		/*Open the shared memory segment created by the connected process. Returns nullptr if this fails.*/
+		static SharedMemoryChannelPtr open(const LoggingPtr& log, const std::string& name);
+
+		/*Returns the name of the shared memory segment.*/
+		const std::string& get_name() const;
+		/*Remove the name of the shared memory segment, the mapped memory remains valid.*/
+		void unlink() const;
+
+		/*Write data and wait while the ring buffer is full. Returns false if the channel is closed.*/
+		const bool write(const char* data, std::size_t size) const;
+		/*Read data and wait until it is received. Returns false if the channel is closed.*/
+		const bool read(char* data, std::size_t size) const;
+		/*Close the channel for both processes and wake up all waiting threads.*/
+		void close() const;
+
+	private:
+		SharedMemoryChannel(const LoggingPtr& log, const std::string& name, void* memory, const bool is_creator);
+
+		/*Returns true if the channel is closed or the connected process terminated.*/
+		const bool is_closed() const;
+
+		LoggingPtr log_;
+		std::string name_;
+		SharedMemorySegment* segment_ = nullptr;
+		SharedMemoryRing* ring_send_ = nullptr;
+		SharedMemoryRing* ring_receive_ = nullptr;
+		char* buffer_send_ = nullptr;
+		char* buffer_receive_ = nullptr;
+		bool is_creator_ = false;
+	};
+
+}
@@ -0,0 +1,87 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#pragma once
+
+#include "asio.hpp"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace grampcd
+{
+
+	/*!
+	 * @brief Hierarchical timer wheel
+	 *
+	 * All timeouts of the communication share a single asio timer that ticks with a fixed resolution.
+	 * Each level of the wheel has 64 slots, a slot of level l covers 64^l ticks. Timeouts are inserted
+	 * into the coarsest level that fits and cascade into finer levels as they approach, so that
+	 * scheduling and cancelling are constant in time regardless of the number of timeouts.
+	*/
+	class TimerWheel
+	{
+	public:
+		typedef std::function<void()> Callback;
+		typedef unsigned long long Handle;
+
+		TimerWheel(asio::io_service& ioService, const std::chrono::milliseconds resolution);
+
+		/*Call the function after the delay, which is rounded up to the resolution. Returns a handle to cancel it.*/
+		const Handle schedule(const std::chrono::milliseconds delay, const Callback& callback);
+		/*Cancel a timeout. Handles of timeouts that expired already are ignored.*/
+		void cancel(const Handle handle);
+		/*Cancel all timeouts and stop the timer.*/
+		void clear();
+
+	private:
+		/*@brief Timeout in a slot of the wheel.*/
+		struct Entry
+		{
+			Handle handle_;
+			unsigned long long expiry_;
+		};
+
+		/*Insert an entry regarding the tick that is processed next. Requires mutex_.*/
+		void insert(const Entry& entry, const unsigned long long next_tick);
+		/*Move the entries of a slot into finer levels. Requires mutex_.*/
+		void cascade(const unsigned int level, const unsigned long long tick);
+		/*Returns the number of ticks since the start of the wheel.*/
+		const unsigned long long get_elapsed_ticks() const;
+		/*Arm the timer for the next tick. Requires mutex_.*/
+		void start_timer();
+		/*Function handler for the ticks of the timer.*/
+		void tickHandler(const asio::error_code& ec);
+
+		static const unsigned int bits_per_level_ = 6;
+		static const unsigned int slots_per_level_ = 1 << bits_per_level_;
+		static const unsigned int number_of_levels_ = 4;
+
+		const std::chrono::milliseconds resolution_;
+		const std::chrono::steady_clock::time_point start_;
+
+		std::mutex mutex_;
+		asio::basic_waitable_timer<std::chrono::steady_clock> timer_;
+		bool is_timer_armed_ = false;
+		// last processed tick
+		unsigned long long current_tick_ = 0;
+		Handle next_handle_ = 1;
+		std::array< std::array< std::vector<Entry>, slots_per_level_ >, number_of_levels_ > slots_;
+		// callbacks of the timeouts that are not expired or cancelled
+		std::unordered_map<Handle, Callback> callbacks_;
+	};
+
+}
@@ -16,6 +16,10 @@
 
 #include "grampcd/info/optimization_info.hpp"
 
+#include <chrono>
+#include <tuple>
+#include <unordered_map>
+
 namespace grampcd
 {
 
@@ -32,6 +36,8 @@ namespace grampcd
         const bool register_agent(const AgentInfo& agent_info);
         /* Register coupling in the network */
         const bool register_coupling(const CouplingInfo& coupling_info);
+        /* Register a set of couplings in the network, returns the couplings that are registered */
+        const std::vector<CouplingInfo> register_couplings(const std::vector<CouplingInfo>& coupling_infos);
 
         /* Remove coupling from the network */
         const bool deregister_agent(const AgentInfo& agent_info);
@@ -48,6 +54,10 @@ namespace grampcd
         const std::map< unsigned int, std::vector< CouplingInfoPtr > >& get_sendingNeighbors() const;
         /*Returns map with receiving neighbors.*/
         const std::map< unsigned int, std::vector< CouplingInfoPtr > >& get_receivingNeighbors() const;
+        /*Returns a number that changes whenever an agent or a coupling is registered or de-registered.*/
+        const unsigned int get_topologyVersion() const;
+        /*Returns the agent ids of each partition, grown greedily along the couplings.*/
+        const std::vector< std::vector<int> > partition_network(const unsigned int number_of_partitions) const;
 
         /*************************************************************************
          coordination of alternating direction method of multipliers
@@ -59,6 +69,15 @@ namespace grampcd
         /* Solve optimization problem using alternating direction method of multipliers (ADMM) */
         void solve_ADMM(int outer_iterations = 1, int inner_iterations = 1);
 
+        /* Continue the alternating direction method of multipliers (ADMM) without initializing the agents */
+        void iterate_ADMM(int outer_iterations = 1, int inner_iterations = 1);
+
+        /* Returns true if the last ADMM iteration converged */
+        const bool is_converged() const;
+
+        /* Shift the trajectories of all agents in advance to the next sampling step */
+        void predict_states() const;
+
         /* Received convergence flag from agent */
         void fromCommunication_received_convergenceFlag(bool converged, int from);
 
@@ -68,17 +87,50 @@ namespace grampcd
         /*Returns optimization info.*/
         const OptimizationInfo& get_optimizationInfo() const;
 
+        /*Fit the communication steps into the sampling time that remains after solving the local problems, unless a step deadline is configured.*/
+        void set_realtime(const bool realtime);
+
     private:
+        /* Key of a coupling, consistent with CouplingInfo::operator== */
+        typedef std::tuple<int, int, std::string> CouplingKey;
+        struct CouplingKeyHash
+        {
+            std::size_t operator()(const CouplingKey& key) const;
+        };
+        /* Positions of a coupling in the lists of sending and receiving neighbors */
+        struct CouplingPosition
+        {
+            std::size_t sending_;
+            std::size_t receiving_;
+        };
+
+        /* Returns the key of a coupling */
+        static CouplingKey get_couplingKey(const CouplingInfo& coupling_info);
+        /* Remove coupling from the lists of neighbors by swapping it with the last entry */
+        void erase_coupling(const CouplingKey& key);
+
+        /* Trigger a step that solves a local problem and measure its duration */
+        void solve_step(const ADMMStep step);
+        /* Derive the deadline of the communication steps from the solve time of the previous sampling step in real-time mode */
+        void update_communicationTimeout();
+
 	    std::map<unsigned int, AgentInfoPtr > agents_;
         CommunicationInterfacePtr communication_interface_;
         std::map< unsigned int, std::vector< CouplingInfoPtr > > sending_neighbors_;
         std::map< unsigned int, std::vector< CouplingInfoPtr > > receiving_neighbors_;
+        std::unordered_map< CouplingKey, CouplingPosition, CouplingKeyHash > couplings_;
+        unsigned int topology_version_ = 0;
 
         LoggingPtr log_;
 
         bool ADMM_converged_ = false;
         bool simulation_ = false;
         OptimizationInfo optimizationInfo_;
+
+        bool realtime_ = false;
+        // duration of the solve steps and number of ADMM iterations since the last sampling step
+        std::chrono::steady_clock::duration solve_time_ = std::chrono::steady_clock::duration::zero();
+        unsigned int number_of_iterations_ = 0;
     };
 
 }
\ No newline at end of file
@@ -17,15 +17,31 @@
 #include "grampcd/info/agent_info.hpp"
 #include "grampcd/info/communication_info.hpp"
 
+#include "grampcd/comm/shared_memory_channel.hpp"
+#include "grampcd/comm/timer_wheel.hpp"
+
 #include "grampcd/util/class_forwarding.hpp"
 
 #include "asio.hpp"
 
+#include <atomic>
+#include <functional>
+#include <map>
 #include <shared_mutex>
+#include <thread>
 
 namespace grampcd
 {
 
+    /*@brief Messages that are sent with a single vectored write.*/
+    struct WriteBatch
+    {
+        /*Buffers that are owned by the batch.*/
+        std::vector< std::shared_ptr<std::vector<char>> > buffers_;
+        /*Views on the data to send in order.*/
+        std::vector< asio::const_buffer > views_;
+    };
+
     /*@brief This class contains the data required for communication.*/
     class CommunicationData
     {
@@ -34,9 +50,6 @@ namespace grampcd
             : 
             strand_(ioService),
             socket_(ioService),
-            timer_check_connection_(ioService),
-            timer_ping_(ioService),
-            timer_polling_(ioService),
             agent_info_(new AgentInfo),
             communication_info_(new CommunicationInfo),
             solution_(new Solution),
@@ -45,12 +58,20 @@ namespace grampcd
             couplingModel_for_simulation_(new std::map<int, CouplingModelPtr>)
         {}
 
-        /*Id of the corresponding agent.*/
-        int id_ = -1;
-        /*Agent info of the corresponding agent.*/
-        AgentInfoPtr agent_info_;
-        /*Flag that states wether flag from coordinator is received.*/
-        bool flag_from_coordinator_ = false;
+        ~CommunicationData()
+        {
+            // stop receiving data over shared memory
+            if (shared_memory_ != nullptr)
+                shared_memory_->close();
+
+            if (thread_sharedMemory_.joinable())
+            {
+                if (thread_sharedMemory_.get_id() == std::this_thread::get_id())
+                    thread_sharedMemory_.detach();
+                else
+                    thread_sharedMemory_.join();
+            }
+        }
 
         /*Strand ensured serialization of function calls.*/
         asio::io_service::strand strand_;
@@ -60,23 +81,77 @@ namespace grampcd
         /*TCP socket*/
 	    asio::ip::tcp::socket socket_;
 
-        /*Mutex that protects the buffer for sending data.*/
+        /*Id of the corresponding agent.*/
+        int id_ = -1;
+        /*Agent info of the corresponding agent.*/
+        AgentInfoPtr agent_info_;
+        /*Flag that states wether flag from coordinator is received.*/
+        bool flag_from_coordinator_ = false;
+
+        /*Connection that carries the messages of this channel, nullptr if this is a connection itself.*/
+        std::shared_ptr<CommunicationData> link_;
+        /*Id of the local agent that communicates over this channel, -1 for a coordinator or sub-coordinator.*/
+        int local_id_ = -1;
+        /*Id of the connected agent, -1 for a coordinator or sub-coordinator.*/
+        int remote_id_ = -1;
+        /*Mutex that protects the channels of a connection.*/
+        std::mutex mutex_channels_;
+        /*Channels that are carried by this connection, identified by the connected agent and the local agent.*/
+        std::map< std::pair<int, int>, std::weak_ptr<CommunicationData> > channels_;
+
+        /*Mutex that protects the buffers for sending data.*/
         std::mutex mutex_buffer_send_;
-        /*Buffer for sending data.*/
-	    std::vector< std::shared_ptr<std::vector<char>> > buffer_send_;
-
-        /*Buffer to read data.*/
-        std::vector<char> buffer_read_ = std::vector<char>(512, 0);
-        /*Read data.*/
-        std::vector<char> data_;
-        /*Timer for checking if connection is still alive.*/
-        asio::basic_waitable_timer<std::chrono::system_clock> timer_check_connection_;
+        /*Messages that wait for the current write to complete.*/
+        WriteBatch buffer_send_;
+        /*Messages that are currently written.*/
+        WriteBatch buffer_writing_;
+        /*Flag that states if a write is outstanding.*/
+        bool is_writing_ = false;
+        /*Flag that states if the write is deferred to the end of a batch.*/
+        bool is_batched_ = false;
+        /*Messages up to the switch to shared memory, which are still written to the socket.*/
+        WriteBatch buffer_switch_;
+        /*Flag that states if the outstanding write contains the switch to shared memory.*/
+        bool is_switching_ = false;
+        /*Flag that states if messages are written to shared memory instead of the socket.*/
+        bool is_sendingSharedMemory_ = false;
+        /*Shared memory channel, if the connected host runs on the same machine. Protected by mutex_buffer_send_.*/
+        SharedMemoryChannelPtr shared_memory_;
+        /*Thread that receives messages over shared memory. Protected by mutex_buffer_send_.*/
+        std::thread thread_sharedMemory_;
+        /*Last compressed message sent for each index, used as reference for delta encoding. Protected by mutex_buffer_send_ of the connection.*/
+        std::map< char, std::shared_ptr<std::vector<char>> > last_sent_messages_;
+        /*Last compressed message received for each index, used as reference for delta encoding.*/
+        std::map< char, std::shared_ptr<std::vector<char>> > last_received_messages_;
+
+        /*Buffer to read data. The bytes in [begin_read_, end_read_) are received, but not evaluated yet.*/
+        std::vector<char> buffer_read_ = std::vector<char>(4096, 0);
+        /*Begin of the received data that is not evaluated yet.*/
+        std::size_t begin_read_ = 0;
+        /*End of the received data.*/
+        std::size_t end_read_ = 0;
+        /*Message that is larger than the buffer to read data and hence received directly.*/
+        std::shared_ptr< std::vector<char> > message_read_;
+        /*Number of received bytes of the message.*/
+        std::size_t size_message_read_ = 0;
+        /*Time at which data was received last, any message counts as sign of life.*/
+        std::atomic<std::chrono::steady_clock::time_point> time_last_received_{ std::chrono::steady_clock::now() };
+        /*Mutex that protects the liveness check.*/
+        std::mutex mutex_liveness_;
+        /*Timeout that checks if the connection is alive.*/
+        TimerWheel::Handle timeout_liveness_ = 0;
+        /*Number of started liveness checks, outdated timeouts are ignored.*/
+        unsigned int session_liveness_ = 0;
         /*Flag that states if connection is alive.*/
 	    bool is_connected_ = false;
         /*Flag that states if corresponding agent is configured.*/
 	    bool is_configured = false;
         /*Flag that states if corresponding agent is configuring.*/
         bool is_configuring = false;
+        /*Number of triggered steps that are not acknowledged yet.*/
+        unsigned int number_of_pending_acknowledgements_ = 0;
+        /*Phase in which the last step was triggered.*/
+        unsigned int phase_triggerStep_ = 0;
 
 	    /*Communication info of corresponding agent.*/
 	    CommunicationInfoPtr communication_info_;
@@ -92,10 +167,6 @@ namespace grampcd
 	    std::shared_ptr< std::map<int, CouplingModelPtr> > couplingModel_for_simulation_;
         /*Number of connected agents.*/
         int number_of_connected_agents_ = 0;
-        /*Timer used for ping.*/
-        asio::basic_waitable_timer<std::chrono::system_clock> timer_ping_;
-        /*Timer used for polling.*/
-        asio::basic_waitable_timer<std::chrono::system_clock> timer_polling_;
 
         /*Mutex that protects agent state for simulation.*/
         std::mutex mutex_agentState_for_simulation_;
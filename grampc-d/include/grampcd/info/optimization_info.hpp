@@ -35,6 +35,12 @@ namespace grampcd
         bool COMMON_ShiftControl_ = true;
         /*Used integration method*/
         std::string COMMON_Integrator_ = "heun";
+        /*Number of integration steps per simulation step for the fixed step methods euler, heun and rk4*/
+        unsigned int COMMON_IntegratorSubsteps_ = 1;
+        /*Relative tolerance of the adaptive method rk45*/
+        typeRNum COMMON_IntegratorRelTol_ = 1e-6;
+        /*Absolute tolerance of the adaptive method rk45*/
+        typeRNum COMMON_IntegratorAbsTol_ = 1e-8;
 
         /*Maximum number of gradient iterations*/
         unsigned int GRAMPC_MaxGradIter_ = 0;
@@ -89,6 +95,9 @@ namespace grampcd
         bool ADMM_AdaptPenaltyParameter_ = true;
         /*Activate debug cost*/
         bool ADMM_DebugCost_ = false;
+        /*Deadline for each ADMM step in seconds, non-positive values use the default of two seconds.
+        In real-time mode, the default deadline of the communication steps is the sampling time that remains after solving the local problems.*/
+        typeRNum ADMM_StepTimeout_ = 0;
 
         /*Activate approximation of neighbors cost*/
         bool APPROX_ApproximateCost_ = false;
@@ -96,6 +105,19 @@ namespace grampcd
         bool APPROX_ApproximateConstraints_ = false;
         /*Activate approximation of neighbors dynamics*/
         bool APPROX_ApproximateDynamics_ = false;
+
+        /*Send states as difference to the previous state sent to the same neighbor*/
+        bool COMM_DeltaEncoding_ = false;
+        /*Quantization of sent trajectories, either "none", "float32" or "float16"*/
+        std::string COMM_Quantization_ = "none";
+        /*Maximum absolute error due to quantization, trajectories with larger errors are sent exactly*/
+        typeRNum COMM_QuantizationTolerance_ = 1e-6;
+        /*Broadcast triggered steps and coupling states via UDP multicast*/
+        bool COMM_Multicast_ = false;
+        /*First IPv4 multicast address, the coordinator sends to this group and agent i to the group with offset i+1*/
+        std::string COMM_MulticastAddress_ = "239.255.0.0";
+        /*UDP port of the multicast groups*/
+        int COMM_MulticastPort_ = 30500;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#pragma once
+
+#include "grampcd/info/agent_info.hpp"
+#include "grampcd/info/coupling_info.hpp"
+#include "grampcd/info/optimization_info.hpp"
+
+#include "grampcd/util/types.hpp"
+
+namespace grampcd
+{
+
+    /**
+     * @brief Information about a single scenario of a batch simulation.
+     */
+    struct ScenarioInfo
+    {
+    public:
+        ScenarioInfo() {}
+
+        /*Name of the scenario in the results*/
+        std::string name_ = "";
+        /*Optimization info of the scenario*/
+        OptimizationInfo optimization_info_;
+
+        /*Agents with their model and cost parameters*/
+        std::vector<AgentInfo> agents_;
+        /*Initial states and controls of the agents in the order of agents_*/
+        std::vector< std::vector<typeRNum> > x_init_;
+        std::vector< std::vector<typeRNum> > u_init_;
+        /*Desired states and controls of the agents in the order of agents_, which are optional*/
+        std::vector< std::vector<typeRNum> > x_des_;
+        std::vector< std::vector<typeRNum> > u_des_;
+        /*Couplings between the agents*/
+        std::vector<CouplingInfo> couplings_;
+
+        /*Flag for a distributed controller, otherwise a centralized one is used*/
+        bool distributed_ = true;
+        /*Initial time*/
+        typeRNum t0_ = 0;
+        /*Simulation time*/
+        typeRNum Tsim_ = 1;
+    };
+
+}
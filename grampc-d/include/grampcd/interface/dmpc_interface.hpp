@@ -21,6 +21,11 @@
 
 #include "grampcd/util/class_forwarding.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
 namespace grampcd
 {
 	/*@brief Interface for the DMPC-framework*/
@@ -28,6 +33,7 @@ namespace grampcd
 	{
 	public:
 		DmpcInterface();
+		~DmpcInterface();
 
 		/*Create object of an agent info*/
 		AgentInfo agentInfo() const;
@@ -39,11 +45,13 @@ namespace grampcd
 		CommunicationInfo communicationInfo() const;
 
 		/*Initialize the central communication interface.*/
-		void initialize_central_communicationInterface(int number_of_threads = 0) override;
+		void initialize_central_communicationInterface(int number_of_threads = 0, bool zero_copy = false) override;
+		/*Initialize the local communication interface.*/
+		void initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator, int number_of_threads = 0) override;
 		/*Initialize the local communication interface.*/
-		void initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator) override;
+		void initialize_local_communicationInterface_as_coordinator(unsigned short port, int number_of_threads = 0) override;
 		/*Initialize the local communication interface.*/
-		void initialize_local_communicationInterface_as_coordinator(unsigned short port) override;
+		void initialize_local_communicationInterface_as_subCoordinator(CommunicationInfo adress_coordinator, unsigned short port, int number_of_threads = 0) override;
 
 		/*Register an agent.*/
 		void register_agent(AgentInfo info, std::vector<typeRNum> x_init, std::vector<typeRNum> u_init) override;
@@ -56,6 +64,8 @@ namespace grampcd
 
 		/*Register a coupling between agents.*/
 		void register_coupling(CouplingInfo info) override;
+		/*Register a set of couplings between agents at once.*/
+		void register_couplings(std::vector<CouplingInfo> infos) override;
 		/*De-register a coupling between agents.*/
 		void deregister_coupling(CouplingInfo info) override;
 
@@ -67,11 +77,23 @@ namespace grampcd
 		void run_DMPC(typeRNum Tsim, typeRNum t0) override;
 		/*Run a distributed controller in endless mode.*/
 		void run_DMPC() override;
+		/*Start a distributed controller on a separate thread and return immediately.*/
+		void start_DMPC(typeRNum t_0, typeRNum Tsim) override;
+		/*Start a distributed controller in endless mode on a separate thread and return immediately.*/
+		void start_DMPC() override;
+		/*Returns true while a controller started on a separate thread is running. The solution is complete once it returns false.*/
+		const bool poll() const override;
+		/*Stop the running controller after the current sampling step and wait for it.*/
+		void stop() override;
 
 		/*Returns the solution of an agent.*/
 		SolutionPtr get_solution(unsigned int agent_id) const override;
 		/*Returns the solutions of a set of agents.*/
 		std::vector< SolutionPtr > get_solution(std::string agents) const override;
+		/*Returns the data points of an agent since an index and its current prediction.*/
+		SolutionPtr get_solution_since(unsigned int agent_id, unsigned int index) const override;
+		/*Returns the data points of a set of agents since the indices given per agent id and their current predictions.*/
+		std::vector< SolutionPtr > get_solution_since(std::string agents, std::map<int, unsigned int> indices) const override;
 		/*Resets the solution of an agent.*/
 		virtual void reset_solution(unsigned int agent_id) override;
 		/*Resets the solutions of a set of agents.*/
@@ -80,6 +102,10 @@ namespace grampcd
 		virtual void print_solution_to_file(const unsigned int agent_id, const std::string prefix = "Solution_agent") const override;
 		/*Print solutions of a set of agents to a file.*/
 		virtual void print_solution_to_file(const std::string agents, const std::string prefix = "Solution_agent") const override;
+		/*Print solution of an agent to a binary columnar file.*/
+		virtual void print_solution_to_binaryFile(const unsigned int agent_id, const std::string prefix = "Solution_agent") const override;
+		/*Print solutions of a set of agents to binary columnar files.*/
+		virtual void print_solution_to_binaryFile(const std::string agents, const std::string prefix = "Solution_agent") const override;
 
 		/*Returns the current optimization info.*/
 		OptimizationInfoPtr get_optimizationInfo() const override;
@@ -90,6 +116,8 @@ namespace grampcd
 		void wait_blocking_s(unsigned int s) override;
 		/*Wait for active connections.*/
 		void wait_for_connections(int agents, int couplings) override;
+		/*Wait for sub-coordinators and partition the network among them.*/
+		void wait_for_subCoordinators(int number) override;
 		/*Set as passive.*/
 		void set_passive() override;
 		/*Send flags to a set of agents.*/
@@ -103,8 +131,20 @@ namespace grampcd
 
 		/*Activate to simulation real time.*/
 		void simulate_realtime(bool realtime) override;
+		/*Activate to start each sampling step while the previous one is simulated.*/
+		void pipeline_steps(bool pipelined) override;
+		/*Simulate the agents on the given number of threads.*/
+		void parallelize_simulation(unsigned int number_of_threads) override;
 		/*Cap the stored data.*/
 		void cap_stored_data(unsigned int data_points) override;
+		/*Append the solutions of the local agents to files by a background thread. The agents wait if more than queue_capacity data points are pending.*/
+		void stream_solution_to_file(const std::string prefix = "Solution_agent", unsigned int queue_capacity = 1000) override;
+		/*Write the remaining data of the solution stream and close the files.*/
+		void stop_solution_stream() override;
+		/*Returns the average computation time per sampling step of the last run in ms.*/
+		typeRNum get_averageComputationTime() const;
+		/*Returns the maximum computation time per sampling step of the last run in ms.*/
+		typeRNum get_maximumComputationTime() const;
 
 		/*Print messages of type base*/
 		void set_print_base(bool print) override;
@@ -124,6 +164,14 @@ namespace grampcd
 		void run_DMPC(SimulatorPtr simulator, const OptimizationInfo& oi, typeRNum Tsim, typeRNum t_0);
 		/*Run a centralized distributed in endless model*/
 		void run_DMPC(SimulatorPtr simulator, const OptimizationInfo& oi);
+		/*Simulate the sampling step while the agents start the next one from their predicted states. Returns true if the next step was started and sets the time of its first ADMM iteration.*/
+		const bool pipelined_simulation(SimulatorPtr simulator, const OptimizationInfo& oi, typeRNum dt, std::chrono::milliseconds& CPUtime_firstIteration);
+		/*Run the control loop in the calling thread.*/
+		void run_controlLoop(const std::function<void()>& control_loop);
+		/*Run the control loop on a separate thread.*/
+		void start_controlLoop(const std::function<void()>& control_loop);
+		/*Mark a control loop as running. Returns false if a controller is running already.*/
+		const bool set_running();
 
 		LoggingPtr log_;
 
@@ -134,9 +182,20 @@ namespace grampcd
 		SimulatorPtr simulator_;
 		ModelFactoryPtr factory_;
 		std::vector< SolutionPtr> solutions_;
+		SolutionStreamPtr solution_stream_;
 
 		std::vector< AgentPtr> agents_;
 
 		bool realtime_ = false;
+		bool pipelined_ = false;
+
+		// control loop that runs on a separate thread, a single controller runs at a time
+		std::thread control_loop_;
+		std::atomic<bool> is_running_{ false };
+		// the control loops stop after the current sampling step if set
+		std::atomic<bool> is_stopRequested_{ false };
+
+		typeRNum average_computation_time_ = 0;
+		typeRNum maximum_computation_time_ = 0;
 	};
 }
\ No newline at end of file
@@ -14,6 +14,8 @@
 
 #include "grampcd/util/class_forwarding.hpp"
 
+#include <map>
+
 namespace grampcd
 {
 	class Interface
@@ -23,11 +25,13 @@ namespace grampcd
 		virtual ~Interface();
 
 		/*Initialize the central communication interface.*/
-		virtual void initialize_central_communicationInterface(int number_of_threads = 0) = 0;
+		virtual void initialize_central_communicationInterface(int number_of_threads = 0, bool zero_copy = false) = 0;
+		/*Initialize the local communication interface.*/
+		virtual void initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator, int number_of_threads = 0) = 0;
 		/*Initialize the local communication interface.*/
-		virtual void initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator) = 0;
+		virtual void initialize_local_communicationInterface_as_coordinator(unsigned short port, int number_of_threads = 0) = 0;
 		/*Initialize the local communication interface.*/
-		virtual void initialize_local_communicationInterface_as_coordinator(unsigned short port) = 0;
+		virtual void initialize_local_communicationInterface_as_subCoordinator(CommunicationInfo adress_coordinator, unsigned short port, int number_of_threads = 0) = 0;
 
 		/*Register an agent.*/
 		virtual void register_agent(AgentInfo info, std::vector<typeRNum> x_init, std::vector<typeRNum> u_init) = 0;
@@ -40,6 +44,8 @@ namespace grampcd
 
 		/*Register a coupling between agents.*/
 		virtual void register_coupling(CouplingInfo info) = 0;
+		/*Register a set of couplings between agents at once.*/
+		virtual void register_couplings(std::vector<CouplingInfo> infos) = 0;
 		/*De-register a coupling between agents.*/
 		virtual void deregister_coupling(CouplingInfo info) = 0;
 
@@ -51,11 +57,23 @@ namespace grampcd
 		virtual void run_DMPC(typeRNum Tsim, typeRNum t0) = 0;
 		/*Run a distributed controller in endless mode.*/
 		virtual void run_DMPC() = 0;
+		/*Start a distributed controller on a separate thread and return immediately. No controller is run or started while another one is running.*/
+		virtual void start_DMPC(typeRNum t_0, typeRNum Tsim) = 0;
+		/*Start a distributed controller in endless mode on a separate thread and return immediately.*/
+		virtual void start_DMPC() = 0;
+		/*Returns true while a controller is running, e.g. one started on a separate thread. The solution is complete once it returns false.*/
+		virtual const bool poll() const = 0;
+		/*Stop the running controller after the current sampling step and wait for it.*/
+		virtual void stop() = 0;
 
 		/*Returns the solution of an agent.*/
 		virtual SolutionPtr get_solution(unsigned int agent_id) const = 0;
 		/*Returns the solutions of a set of agents.*/
 		virtual std::vector< SolutionPtr > get_solution(std::string agents) const = 0;
+		/*Returns the data points of an agent since an index and its current prediction. The next index of the returned solution is the cursor for the next call.*/
+		virtual SolutionPtr get_solution_since(unsigned int agent_id, unsigned int index) const = 0;
+		/*Returns the data points of a set of agents since the indices given per agent id and their current predictions.*/
+		virtual std::vector< SolutionPtr > get_solution_since(std::string agents, std::map<int, unsigned int> indices) const = 0;
 		/*Resets the solution of an agent.*/
 		virtual void reset_solution(unsigned int agent_id) = 0;
 		/*Resets the solutions of a set of agents.*/
@@ -64,6 +82,10 @@ namespace grampcd
 		virtual void print_solution_to_file(const unsigned int agent_id, const std::string prefix = "Solution_agent") const = 0;
 		/*Print solutions of a set of agents to a file using a specific prefix for the file name.*/
 		virtual void print_solution_to_file(const std::string agents, const std::string prefix = "Solution_agent") const = 0;
+		/*Print solution of an agent to a binary columnar file using a specific prefix for the file name.*/
+		virtual void print_solution_to_binaryFile(const unsigned int agent_id, const std::string prefix = "Solution_agent") const = 0;
+		/*Print solutions of a set of agents to binary columnar files using a specific prefix for the file name.*/
+		virtual void print_solution_to_binaryFile(const std::string agents, const std::string prefix = "Solution_agent") const = 0;
 
 		/*Returns the current optimization info.*/
 		virtual OptimizationInfoPtr get_optimizationInfo() const = 0;
@@ -74,6 +96,8 @@ namespace grampcd
 		virtual void wait_blocking_s(unsigned int s) = 0;
 		/*Wait for active connections.*/
 		virtual void wait_for_connections(int agents, int couplings) = 0;
+		/*Wait for sub-coordinators and partition the network among them.*/
+		virtual void wait_for_subCoordinators(int number) = 0;
 		/*Set as passive.*/
 		virtual void set_passive() = 0;
 		/*Send flags to a set of agents.*/
@@ -87,8 +111,16 @@ namespace grampcd
 
 		/*Activate to simulation real time.*/
 		virtual void simulate_realtime(bool realtime) = 0;
+		/*Activate to start each sampling step while the previous one is simulated.*/
+		virtual void pipeline_steps(bool pipelined) = 0;
+		/*Simulate the agents on the given number of threads.*/
+		virtual void parallelize_simulation(unsigned int number_of_threads) = 0;
 		/*Cap the stored data.*/
 		virtual void cap_stored_data(unsigned int data_points) = 0;
+		/*Append the solutions of the local agents to files while running, using a specific prefix for the file names.*/
+		virtual void stream_solution_to_file(const std::string prefix = "Solution_agent", unsigned int queue_capacity = 1000) = 0;
+		/*Write the remaining data of the solution stream and close the files.*/
+		virtual void stop_solution_stream() = 0;
 
 		/*Print messages of type base*/
 		virtual void set_print_base(bool print) = 0;
@@ -24,11 +24,13 @@ namespace grampcd
 		PythonInterface();
 
 		/*Initialize the central communication interface.*/
-		void initialize_central_communicationInterface(int number_of_threads = 0) override;
+		void initialize_central_communicationInterface(int number_of_threads = 0, bool zero_copy = false) override;
 		/*Initialize the local communication interface.*/
-		void initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator) override;
+		void initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator, int number_of_threads = 0) override;
 		/*Initialize the local communication interface.*/
-		void initialize_local_communicationInterface_as_coordinator(unsigned short port) override;
+		void initialize_local_communicationInterface_as_coordinator(unsigned short port, int number_of_threads = 0) override;
+		/*Initialize the local communication interface.*/
+		void initialize_local_communicationInterface_as_subCoordinator(CommunicationInfo adress_coordinator, unsigned short port, int number_of_threads = 0) override;
 
 		/*Register an agent.*/
 		void register_agent(AgentInfo info, std::vector<typeRNum> x_init, std::vector<typeRNum> u_init) override;
@@ -41,6 +43,8 @@ namespace grampcd
 
 		/*Register a coupling between agents.*/
 		void register_coupling(CouplingInfo info) override;
+		/*Register a set of couplings between agents at once.*/
+		void register_couplings(std::vector<CouplingInfo> infos) override;
 		/*De-register a coupling between agents.*/
 		void deregister_coupling(CouplingInfo info) override;
 
@@ -52,11 +56,23 @@ namespace grampcd
 		void run_DMPC(typeRNum Tsim, typeRNum t0) override;
 		/*Run a distributed controller in endless mode.*/
 		void run_DMPC() override;
+		/*Start a distributed controller on a separate thread and return immediately.*/
+		void start_DMPC(typeRNum t_0, typeRNum Tsim) override;
+		/*Start a distributed controller in endless mode on a separate thread and return immediately.*/
+		void start_DMPC() override;
+		/*Returns true while a controller started on a separate thread is running. The solution is complete once it returns false.*/
+		const bool poll() const override;
+		/*Stop the running controller after the current sampling step and wait for it.*/
+		void stop() override;
 
 		/*Returns the solution of an agent.*/
 		SolutionPtr get_solution(unsigned int agent_id) const override;
 		/*Returns the solutions of a set of agents.*/
 		std::vector< SolutionPtr > get_solution(std::string agents) const override;
+		/*Returns the data points of an agent since an index and its current prediction.*/
+		SolutionPtr get_solution_since(unsigned int agent_id, unsigned int index) const override;
+		/*Returns the data points of a set of agents since the indices given per agent id and their current predictions.*/
+		std::vector< SolutionPtr > get_solution_since(std::string agents, std::map<int, unsigned int> indices) const override;
 		/*Resets the solution of an agent.*/
 		virtual void reset_solution(unsigned int agent_id) override;
 		/*Resets the solutions of a set of agents.*/
@@ -65,6 +81,10 @@ namespace grampcd
 		virtual void print_solution_to_file(const unsigned int agent_id, const std::string prefix = "Solution_agent") const override;
 		/*Print solutions of a set of agents to a file using a specific prefix for the file name.*/
 		virtual void print_solution_to_file(const std::string agents, const std::string prefix = "Solution_agent") const override;
+		/*Print solution of an agent to a binary columnar file using a specific prefix for the file name.*/
+		virtual void print_solution_to_binaryFile(const unsigned int agent_id, const std::string prefix = "Solution_agent") const override;
+		/*Print solutions of a set of agents to binary columnar files using a specific prefix for the file name.*/
+		virtual void print_solution_to_binaryFile(const std::string agents, const std::string prefix = "Solution_agent") const override;
 
 		/*Returns the current optimization info.*/
 		OptimizationInfoPtr get_optimizationInfo() const override;
@@ -75,6 +95,8 @@ namespace grampcd
 		void wait_blocking_s(unsigned int s) override;
 		/*Wait for active connections.*/
 		void wait_for_connections(int agents, int couplings) override;
+		/*Wait for sub-coordinators and partition the network among them.*/
+		void wait_for_subCoordinators(int number) override;
 		/*Set as passive.*/
 		void set_passive() override;
 		/*Send flags to a set of agents.*/
@@ -88,8 +110,16 @@ namespace grampcd
 
 		/*Activate to simulation real time.*/
 		void simulate_realtime(bool realtime) override;
+		/*Activate to start each sampling step while the previous one is simulated.*/
+		void pipeline_steps(bool pipelined) override;
+		/*Simulate the agents on the given number of threads.*/
+		void parallelize_simulation(unsigned int number_of_threads) override;
 		/*Cap the stored data.*/
 		void cap_stored_data(unsigned int data_points) override;
+		/*Append the solutions of the local agents to files while running, using a specific prefix for the file names.*/
+		void stream_solution_to_file(const std::string prefix = "Solution_agent", unsigned int queue_capacity = 1000) override;
+		/*Write the remaining data of the solution stream and close the files.*/
+		void stop_solution_stream() override;
 
 		/*Print messages of type base*/
 		void set_print_base(bool print) override;
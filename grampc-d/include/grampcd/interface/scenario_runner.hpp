@@ -0,0 +1,85 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#pragma once
+
+#include "grampcd/info/scenario_info.hpp"
+
+#include "grampcd/util/class_forwarding.hpp"
+
+#include <iostream>
+
+namespace grampcd
+{
+
+	/*@brief Aggregated result of a scenario.*/
+	struct ScenarioResult
+	{
+		/*Name of the scenario*/
+		std::string name_ = "";
+		/*Flag that states if the scenario was run*/
+		bool is_successful_ = false;
+		/*Number of agents*/
+		unsigned int number_of_agents_ = 0;
+		/*Number of simulation steps*/
+		unsigned int number_of_steps_ = 0;
+		/*Simulated cost summed over all agents and simulation steps*/
+		typeRNum cost_ = 0;
+		/*Simulated cost of all agents in the last simulation step*/
+		typeRNum final_cost_ = 0;
+		/*Average and maximum computation time of the controller per sampling step in ms*/
+		typeRNum average_computation_time_ = 0;
+		typeRNum maximum_computation_time_ = 0;
+		/*Time to set up and run the scenario in ms*/
+		typeRNum run_time_ = 0;
+	};
+
+	/*@brief Runs a batch of independent scenarios, e.g. a parameter sweep, in parallel within one process.*/
+	class ScenarioRunner
+	{
+	public:
+		ScenarioRunner();
+
+		/*Add a scenario to the batch.*/
+		void add_scenario(ScenarioInfo scenario);
+		/*Remove all scenarios and results.*/
+		void clear();
+
+		/*Run all scenarios on the given number of threads. Each scenario runs on its own interface with a central communication interface.*/
+		void run(unsigned int number_of_threads);
+
+		/*Returns the results in the order of the scenarios.*/
+		const std::vector<ScenarioResult>& get_results() const;
+		/*Print the results to a file with one row per scenario.*/
+		void print_results_to_file(const std::string filename) const;
+
+		/*Print messages of type base*/
+		void set_print_base(bool print);
+		/*Print messages of type warning of the scenarios*/
+		void set_print_warning(bool print);
+		/*Print messages of type error of the scenarios*/
+		void set_print_error(bool print);
+
+	private:
+		/*Set up and run a single scenario.*/
+		const ScenarioResult run_scenario(const ScenarioInfo& scenario) const;
+
+		LoggingPtr log_;
+		bool print_warning_ = false;
+		bool print_error_ = false;
+
+		std::vector<ScenarioInfo> scenarios_;
+		std::vector<ScenarioResult> results_;
+	};
+
+	std::ostream& operator<<(std::ostream& stream, const std::vector<ScenarioResult>& results);
+}
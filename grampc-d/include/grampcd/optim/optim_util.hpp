@@ -83,7 +83,8 @@ namespace grampcd
         SEND_CONVERGENCE_FLAG,
         INITIALIZE,
         SEND_TRUE_STATE,
-        PRINT
+        PRINT,
+        PREDICT_STATE
     };
 
     /*Configure the solver regarding the optimization info.*/
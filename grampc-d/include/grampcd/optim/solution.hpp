@@ -14,6 +14,8 @@
 
 #include "grampcd/state/agent_state.hpp"
 
+#include "grampcd/util/class_forwarding.hpp"
+
 #include <iostream>
 
 namespace grampcd
@@ -32,12 +34,31 @@ namespace grampcd
 		/*Update the solution with debug cost.*/
 		void update_debug_cost(const typeRNum cost);
 
-		/*Simulated agent state*/
+		/*Returns the simulated agent state in chronological order.*/
+		const AgentState get_agentState() const;
+		/*Returns the simulated cost in chronological order.*/
+		const std::vector< typeRNum > get_cost() const;
+		/*Returns the number of simulated data points.*/
+		const unsigned int get_numberOfDataPoints() const;
+		/*Returns the position of the k-th oldest data point in agentState_ and cost_.*/
+		const unsigned int get_dataPoint(const unsigned int k) const;
+
+		/*Returns the index of the oldest stored data point, which counts the data points dropped due to the cap.*/
+		const unsigned int get_indexOfFirstDataPoint() const;
+		/*Sets the index of the oldest stored data point, e.g. of a received solution.*/
+		void set_indexOfFirstDataPoint(const unsigned int index);
+		/*Returns the index that follows the newest data point, i.e. the cursor for the next call of get_solution_since.*/
+		const unsigned int get_nextIndex() const;
+		/*Returns the data points with an index of at least the given one and the current prediction, without debug cost.
+		If the index exceeds the stored data points, e.g. as the solution was reset, all data points are returned.*/
+		const SolutionPtr get_solution_since(const unsigned int index) const;
+
+		/*Simulated agent state, which is a ring buffer if the number of data points is capped*/
 		AgentState agentState_;
 		/*Predicted agent state*/
 		AgentState predicted_agentState_;
 
-		/*Simulated cost*/
+		/*Simulated cost, which is a ring buffer if the number of data points is capped*/
 		std::vector< typeRNum > cost_;
 		/*Predicted cost*/
 		std::vector< typeRNum > predicted_cost_;
@@ -46,6 +67,15 @@ namespace grampcd
 
 		/*Maximum number of data points*/
 		unsigned int maximum_number_of_data_points_ = 0;
+
+	private:
+		/*Reorder the data points chronologically and drop the oldest ones that exceed the maximum number.*/
+		void linearize();
+
+		/*Position of the oldest data point in the ring buffer*/
+		unsigned int first_data_point_ = 0;
+		/*Index of the oldest data point since the solution was started*/
+		unsigned int index_of_first_data_point_ = 0;
 	};
 
 	std::ostream& operator<<(std::ostream& stream, const Solution& solution);
@@ -17,6 +17,12 @@
 #include "grampcd/util/class_forwarding.hpp"
 #include "grampcd/util/logging.hpp"
 
+#include "asio.hpp"
+
+#include <array>
+#include <functional>
+#include <memory>
+
 namespace grampcd
 {
 
@@ -30,17 +36,73 @@ namespace grampcd
 	    /*Simulate the overall system based on a centralized setup.*/
         void centralized_simulation(const SolverCentral *solver, const std::string& Integrator, typeRNum dt);
 
+        /*Collect the states and models of all agents for a distributed simulation.*/
+        const bool collect_states(const std::string& Integrator, typeRNum dt);
+        /*Integrate the collected states without communicating with the agents.*/
+        const bool integrate();
+        /*Send the integrated states to the agents.*/
+        void send_simulatedStates();
+
         /*Set t0*/
         void set_t0(typeRNum t0);
+        /*Evaluate the agents on the given number of threads, including the calling thread.*/
+        void set_numberOfThreads(const unsigned int number_of_threads);
+        /*Set the number of steps per simulation step of the fixed step integrators and the tolerances of the adaptive one.*/
+        void set_integratorOptions(const unsigned int number_of_substeps, const typeRNum rel_tol, const typeRNum abs_tol);
 
     private:
+        /*@brief Coupling graph of the simulated agents in compressed sparse row format.*/
+        struct Topology
+        {
+            /*Agent ids in the order of the arrays.*/
+            std::vector<unsigned int> agent_ids_;
+            std::vector<AgentModelPtr> agent_models_;
+            /*Offsets of each agent in the arrays of all states and controls, with the total size as last entry.*/
+            std::vector<unsigned int> offsets_x_;
+            std::vector<unsigned int> offsets_u_;
+            /*The couplings of agent k are the edges from offsets_edges_[k] to offsets_edges_[k+1].*/
+            std::vector<unsigned int> offsets_edges_;
+            /*Index of the sending neighbor and coupling model of each edge.*/
+            std::vector<unsigned int> neighbors_;
+            std::vector<CouplingModelPtr> coupling_models_;
+        };
+
+        /*@brief Explicit Runge-Kutta method given by its Butcher tableau.*/
+        struct ButcherTableau
+        {
+            /*Row s holds the weights of the previous stages for the states of stage s.*/
+            std::vector< std::vector<typeRNum> > a_;
+            std::vector<typeRNum> b_;
+            std::vector<typeRNum> c_;
+            /*Weights of the error estimate, which is only given for methods with adaptive step size.*/
+            std::vector<typeRNum> e_;
+            unsigned int error_order_ = 0;
+        };
+
+        /*Returns the Butcher tableau of the integration method or nullptr if it is unknown or euler or heun.*/
+        static const ButcherTableau* get_butcherTableau(const std::string& Integrator);
+
+        /*Request the models of the agents that are not cached for the current topology.*/
+        const bool collect_models();
+        /*Compile the topology from the models, if the agents or the coupling graph changed.*/
+        const bool compile_topology();
         void simulate();
-        const typeRNum evaluate_cost
-        (
-            const unsigned int agent_id,
-            const AgentModelPtr& agent_model, 
-            const std::shared_ptr< std::map<int, CouplingModelPtr> >& coupling_models
-        ) const;
+        /*Call the function for the index of each agent, in parallel if several threads are set. Returns after all calls are done.*/
+        void for_each_agent(const std::function<void(const std::size_t)>& function) const;
+        /*Integrate x_step_ over dt with the given number of steps of equal size. Euler or heun are used without a tableau.*/
+        void integrate_fixedSteps(const ButcherTableau* tableau);
+        /*Integrate x_step_ over dt with adaptive step size. Returns false if the step size control fails.*/
+        const bool integrate_adaptiveSteps(const ButcherTableau& tableau);
+        /*Evaluate one euler or heun step of size h from the states x_step_ at the time tau after the current time to x_candidate_.*/
+        void evaluate_eulerStep(const typeRNum tau, const typeRNum h);
+        void evaluate_heunStep(const typeRNum tau, const typeRNum h);
+        /*Evaluate one step of size h from the states x_step_ at the time tau after the current time.
+        The stepped states are written to x_candidate_ and the scaled error of each agent to errors_.*/
+        void evaluate_step(const ButcherTableau& tableau, const typeRNum tau, const typeRNum h);
+        /*Evaluate the time derivative of the states of agent k at the time tau after the current time and the given states of all agents.*/
+        void evaluate_dynamics(const std::size_t k, const typeRNum tau, const std::vector<typeRNum>& x, typeRNum* dx) const;
+        /*Evaluate the cost of the predicted trajectories of agent k.*/
+        const typeRNum evaluate_cost(const std::size_t k) const;
 
         LoggingPtr log_;
         typeRNum dt_ = 0.0;
@@ -48,7 +110,44 @@ namespace grampcd
         std::string Integrator_;
 		std::map<unsigned int, AgentStatePtr > agentStates_;
 		std::map<unsigned int, AgentStatePtr > desired_agentStates_;
+        std::vector<unsigned int> agent_ids_;
+        // models are requested once per topology version of the coordinator
+        std::map<unsigned int, AgentModelPtr > agentModels_;
+        std::map<unsigned int, std::shared_ptr< std::map<int, CouplingModelPtr> > > couplingModels_;
+        unsigned int topology_version_ = 0;
+        bool are_models_cached_ = false;
         CommunicationInterfacePtr communication_interface_;
+
+        // compiled topology, which is rebuilt if the models are collected again or the agents change
+        Topology topology_;
+        bool is_topology_compiled_ = false;
+        // trajectories, current states and controls of all agents in the order of the topology
+        std::vector<AgentStatePtr> states_;
+        std::vector<AgentStatePtr> desired_states_;
+        std::vector<typeRNum> t_;
+        std::vector<typeRNum> x_;
+        std::vector<typeRNum> u_;
+        // integrated states and costs of all agents
+        std::vector<typeRNum> x_next_;
+        std::vector<typeRNum> costs_;
+        bool is_simulated_ = false;
+
+        // states of the current and the attempted step, the stages and the errors of all agents
+        std::vector<typeRNum> x_step_;
+        std::vector<typeRNum> x_candidate_;
+        std::array< std::vector<typeRNum>, 2 > x_stages_;
+        std::vector< std::vector<typeRNum> > dx_stages_;
+        std::vector<typeRNum> errors_;
+
+        unsigned int number_of_substeps_ = 1;
+        typeRNum rel_tol_ = 1e-6;
+        typeRNum abs_tol_ = 1e-8;
+        // last step size of the adaptive integrator, which is the initial one of the next simulation step
+        typeRNum step_size_ = 0.0;
+        const unsigned int max_number_of_steps_ = 100000;
+
+        unsigned int number_of_threads_ = 1;
+        std::unique_ptr<asio::thread_pool> thread_pool_;
     };
 
 }
\ No newline at end of file
@@ -29,16 +29,22 @@ namespace grampcd
 	DMPC_CLASS_FORWARD(Coordinator);
 
 	DMPC_CLASS_FORWARD(DmpcInterface);
+	DMPC_CLASS_FORWARD(ScenarioRunner);
 
 	DMPC_CLASS_FORWARD(Simulator);
 
 	DMPC_CLASS_FORWARD(CommunicationData);
+	DMPC_CLASS_FORWARD(SharedMemoryChannel);
+	DMPC_CLASS_FORWARD(MulticastChannel);
+	DMPC_CLASS_FORWARD(TimerWheel);
 
 	DMPC_CLASS_FORWARD(ModelFactory);
 	DMPC_CLASS_FORWARD(AgentModel);
 	DMPC_CLASS_FORWARD(CouplingModel);
 
 	DMPC_CLASS_FORWARD(Logging);
+	DMPC_CLASS_FORWARD(SolutionFile);
+	DMPC_CLASS_FORWARD(SolutionStream);
 
 	DMPC_CLASS_FORWARD(ApproximateNeighbor);
 	DMPC_CLASS_FORWARD(SolverCentral);
@@ -57,4 +63,6 @@ namespace grampcd
 	DMPC_STRUCT_FORWARD(CouplingInfo);
 	DMPC_STRUCT_FORWARD(OptimizationInfo);
 	DMPC_STRUCT_FORWARD(CommunicationInfo);
+	DMPC_STRUCT_FORWARD(ScenarioInfo);
+	DMPC_STRUCT_FORWARD(ScenarioResult);
 }
\ No newline at end of file
@@ -19,6 +19,9 @@ namespace grampcd
 	class DataConversion
 	{
 	public:
+		/*Returns true if the host stores numbers in little endian byte order.*/
+		static const bool is_littleEndian();
+
 		/*Insert integer into char array*/
 		static void insert_into_charArray(const std::shared_ptr<std::vector<char>>& data, unsigned int& pos, const int a);
 		/*Insert unsigned int into char array*/
@@ -60,6 +63,9 @@ namespace grampcd
 		/*Skip string in char array*/
 		static void skip_in_charArray_string(const std::vector<char>& data, unsigned int& pos);
 
+		/*Round the values to the given number of mantissa bits, if the absolute error does not exceed the tolerance*/
+		static void quantize(std::vector<typeRNum>& a, const unsigned int mantissa_bits, const typeRNum tolerance);
+
 		/*Convert ADMM step to integer*/
 		static const int ADMMStep_to_int(ADMMStep step);
 		/*Convert integer to ADMM step*/
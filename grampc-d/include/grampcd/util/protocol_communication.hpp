@@ -20,18 +20,29 @@ namespace grampcd
 		// common
 		static const std::shared_ptr< std::vector<char> > buildProtocol_get_solution();
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_solution(const SolutionPtr& solution);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_get_solution_since(const unsigned int index);
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_convergenceFlag(const bool converged, const int from);
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_numberOfNeighbors(const int number, const int from);
-		static const std::shared_ptr< std::vector<char> > buildProtocol_triggerStep(const ADMMStep& step);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_triggerStep(const ADMMStep& step, const unsigned int step_timeout_ms);
 		static const std::shared_ptr< std::vector<char> > buildProtocol_get_numberOfActiveCouplings();
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_numberOfActiveCouplings(int number);
 		static const std::shared_ptr< std::vector<char> > buildProtocol_get_ping();
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_ping();
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_flagToAgents();
+		static const std::shared_ptr< std::vector<char> > buildProtocol_assign_partition(const std::vector<int>& agent_ids);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_send_wireFormat();
+		static const std::shared_ptr< std::vector<char> > buildProtocol_compressedMessage(const std::vector<char>& message, const std::shared_ptr< std::vector<char> >& reference);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_offer_sharedMemory(const std::string& name);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_accept_sharedMemory(const bool accepted);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_switch_to_sharedMemory();
+		static const std::shared_ptr< std::vector<char> > buildProtocol_channelHeader(const int from, const int to, const unsigned int size_of_message);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_send_listeningPort(const unsigned int port);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_close_channel();
 
 		// info
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_optimizationInfo(const OptimizationInfo& info);
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_communicationInfo(const CommunicationInfo& info);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_send_subCoordinatorInfo(const CommunicationInfo& info);
 
 		// model
 		static const std::shared_ptr< std::vector<char> > buildProtocol_get_agentModel_from_agent();
@@ -53,6 +64,7 @@ namespace grampcd
 			const CommunicationInfo& comm_info
 		);
 		static const std::shared_ptr< std::vector<char> > buildProtocol_register_coupling(const CouplingInfo& coupling_info);
+		static const std::shared_ptr< std::vector<char> > buildProtocol_register_couplings(const std::vector<CouplingInfo>& coupling_infos);
 
 		// states
 		static const std::shared_ptr< std::vector<char> > buildProtocol_send_agentState(const AgentState& state, const int from);
@@ -81,16 +93,31 @@ namespace grampcd
 
 		// common
 		static const ADMMStep buildFromProtocol_ADMMStep(const std::vector<char>& data);
+		static const unsigned int buildFromProtocol_stepTimeout_from_triggerStep(const std::vector<char>& data);
 		static const SolutionPtr buildFromProtocol_solution(const std::vector<char>& data);
+		static const unsigned int buildFromProtocol_indexOfDataPoint(const std::vector<char>& data);
 		static const int buildFromProtocol_numberOfNeighbors(const std::vector<char>& data);
 		static const bool buildFromProtocol_convergenceFlag(const std::vector<char>& data);
 		static const int buildFromProtocol_from(const std::vector<char>& data);
 		static const int buildFromProtocol_numberOfActiveCouplings(const std::vector<char>& data);
+		static const std::shared_ptr< std::vector<int> > buildFromProtocol_partition(const std::vector<char>& data);
+		static const unsigned int buildFromProtocol_wireFormatVersion(const std::vector<char>& data);
+		static const unsigned int buildFromProtocol_sizeOfTypeRNum_from_wireFormat(const std::vector<char>& data);
+		static const bool buildFromProtocol_littleEndian_from_wireFormat(const std::vector<char>& data);
+		static const char buildFromProtocol_index_from_compressedMessage(const std::vector<char>& data);
+		static const std::shared_ptr< std::vector<char> > buildFromProtocol_compressedMessage(const std::vector<char>& data, const std::shared_ptr< std::vector<char> >& reference);
+		static const std::string buildFromProtocol_name_from_offer_sharedMemory(const std::vector<char>& data);
+		static const bool buildFromProtocol_accepted_from_accept_sharedMemory(const std::vector<char>& data);
+		static const int buildFromProtocol_from_channelMessage(const std::vector<char>& data);
+		static const int buildFromProtocol_to_channelMessage(const std::vector<char>& data);
+		static const std::shared_ptr< std::vector<char> > buildFromProtocol_message_from_channelMessage(const std::vector<char>& data);
+		static const unsigned int buildFromProtocol_listeningPort(const std::vector<char>& data);
 
 		//infos
 		static const std::shared_ptr< AgentInfo > buildFromProtocol_agentInfo(const std::vector<char>& data);
 		static const std::shared_ptr< OptimizationInfo > buildFromProtocol_optimizationInfo(const std::vector<char>& data);
 		static const std::shared_ptr< CouplingInfo > buildFromProtocol_couplingInfo(const std::vector<char>& data);
+		static const std::shared_ptr< std::vector<CouplingInfo> > buildFromProtocol_couplingInfoArray(const std::vector<char>& data);
 		static const std::shared_ptr< std::vector<CommunicationInfo> > buildFromProtocol_communicationInfoArray(const std::vector<char>& data);
 		static const std::shared_ptr< CommunicationInfo > buildFromProtocol_communicationInfo(const std::vector<char>& data);
 		static const std::shared_ptr< AgentInfo > buildFromProtocol_agentInfo_from_successfully_registered_coupling(const std::vector<char>& data);
@@ -117,6 +144,13 @@ namespace grampcd
 	const char position_of_index_in_protocol_ = 4;
 	const char first_element_with_data_ = 5;
 
+	// Version of the wire format, that is exchanged once per connection.
+	// Integers are sent in big endian and typeRNums in little endian byte order.
+	const unsigned int wire_format_version_ = 9;
+
+	// Size of the header that precedes each message of a channel, i.e. size, index, sending and receiving agent.
+	const unsigned int size_of_channelHeader_ = 5 + 2 * sizeof(int);
+
 	enum class index : char
 	{
 		register_agent = 1,
@@ -149,10 +183,22 @@ namespace grampcd
 		send_flagToAgents = 32,
 		send_communicationInfo = 34,
 		successfully_deregistered_agent = 35,
+		assign_partition = 36,
+		send_subCoordinatorInfo = 37,
+		send_wireFormat = 38,
+		compressedMessage = 39,
+		offer_sharedMemory = 40,
+		accept_sharedMemory = 41,
+		switch_to_sharedMemory = 42,
+		channelMessage = 43,
+		send_listeningPort = 44,
+		close_channel = 45,
+		register_couplings = 46,
 		successfully_registered_agent = 100,
 		received_acknowledgement_received_optimizationInfo = 101,
 		received_acknowledgement_executed_ADMMstep = 102,
 		get_solution = 103,
-		send_solution = 104
+		send_solution = 104,
+		get_solution_since = 105
 	};
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#pragma once
+
+#include "grampcd/util/class_forwarding.hpp"
+
+namespace grampcd
+{
+
+	/*!
+	 * @brief Binary columnar file of a solution
+	 *
+	 * The file starts with the magic "GRAMPCD" and a zero byte, followed by the size of the header
+	 * as 64-bit little endian integer. The header is a JSON object that lists the columns with their
+	 * name, length and byte offset after the header. Each column is an array of little endian float64
+	 * values, i.e. the time t, the states x0, x1, ..., the controls u0, u1, ..., the external influences
+	 * v0, v1, ..., the cost and the debug cost. The data starts at a multiple of 8 bytes, such that it
+	 * can be mapped into memory, e.g. by numpy.memmap.
+	*/
+	class SolutionFile
+	{
+	public:
+		/*Write the solution of an agent to a file. Returns false if the file cannot be written.*/
+		static const bool write(const Solution& solution, const std::string& filename);
+		/*Read the solution of an agent from a file. Returns nullptr if the file cannot be read.*/
+		static const SolutionPtr read(const std::string& filename);
+	};
+
+}
@@ -0,0 +1,89 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#pragma once
+
+#include "grampcd/state/agent_state.hpp"
+
+#include "grampcd/util/class_forwarding.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace grampcd
+{
+
+	/*!
+	 * @brief Incremental log of the solutions of the agents
+	 *
+	 * Each simulated data point is queued together with the predicted trajectory and cost of the
+	 * sampling step and appended to the files by a background thread. The queue is bounded, hence
+	 * the agents wait for the writer if it falls behind instead of accumulating data in memory.
+	 * For each agent, the simulated data points are appended to prefix + id + ".txt" and the
+	 * predicted trajectories to prefix + id + "_predicted.txt".
+	*/
+	class SolutionStream
+	{
+	public:
+		SolutionStream(const LoggingPtr& log, const std::string& prefix, const unsigned int queue_capacity);
+		~SolutionStream();
+
+		/*Queue a simulated data point and the predicted trajectory it is based on. Blocks while the queue is full.*/
+		void push(const int agent_id, const typeRNum t0, const std::vector<typeRNum>& x, const typeRNum cost,
+			const AgentState& predicted_agent_state, const std::vector<typeRNum>& predicted_cost);
+		/*Write the queued data points and stop the writer. Data points that are pushed afterwards are discarded.*/
+		void stop();
+
+	private:
+		/*@brief Simulated data point with the predicted trajectory of the sampling step.*/
+		struct DataPoint
+		{
+			int agent_id_;
+			typeRNum t0_;
+			std::vector<typeRNum> x_;
+			typeRNum cost_;
+			AgentState predicted_agentState_;
+			std::vector<typeRNum> predicted_cost_;
+		};
+
+		/*@brief Files of an agent.*/
+		struct Files
+		{
+			std::ofstream simulated_;
+			std::ofstream predicted_;
+		};
+
+		/*Function of the writer thread.*/
+		void write_dataPoints();
+		/*Append a data point to the files of its agent.*/
+		void write_dataPoint(const DataPoint& data_point);
+
+		LoggingPtr log_;
+		const std::string prefix_;
+		const unsigned int queue_capacity_;
+
+		std::mutex mutex_;
+		std::condition_variable is_not_empty_;
+		std::condition_variable is_not_full_;
+		std::deque<DataPoint> queue_;
+		bool is_stopped_ = false;
+
+		// only accessed by the writer thread
+		std::map<int, Files> files_;
+		std::thread writer_;
+	};
+
+}
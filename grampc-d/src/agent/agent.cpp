@@ -15,6 +15,7 @@
 
 #include "grampcd/util/data_conversion.hpp"
 #include "grampcd/util/logging.hpp"
+#include "grampcd/util/solution_stream.hpp"
 
 #include "grampcd/model/model_factory.hpp"
 #include "grampcd/model/agent_model.hpp"
@@ -343,6 +344,19 @@ namespace grampcd
             neighbor->shift_states(dt, t0);
     }
 
+    void Agent::predict_state(const typeRNum dt)
+    {
+        // shift all states as if the sampling step had already passed
+        shift_states(dt, agentState_.t0_);
+
+        // the shifted trajectory provides the predicted initial state
+        for (unsigned int k = 0; k < model_->get_Nxi(); ++k)
+            x_init_[k] = agentState_.x_[k];
+
+        is_statePredicted_ = true;
+        predicted_dt_ = dt;
+    }
+
     const AgentState& Agent::get_desiredAgentState() const
     {
         return desired_agentState_;
@@ -393,6 +407,7 @@ namespace grampcd
             model_->lfct(&predicted_cost[i], agentState_.t_[i], &agentState_.x_[i], &agentState_.u_[i], &desired_agentState_.x_[i]);
 
         // update solution
+        std::lock_guard<std::mutex> guard(mutex_solution_);
 	    solution_->update_predicted_state(state, predicted_cost);
     }
 
@@ -590,7 +605,7 @@ namespace grampcd
 		neighbor->set_neighbors_couplingState(coupling);
     }
 
-    void Agent::fromCommunication_received_multiplierState(const MultiplierState& multiplier, PenaltyState penalty, int from)
+    void Agent::fromCommunication_received_multiplierState(const MultiplierState& multiplier, const PenaltyState& penalty, int from)
     {
         // received neighbors coupled multiplier state
         if (multiplier.i_ != get_id())
@@ -624,6 +639,108 @@ namespace grampcd
 		neighbor->set_neighbors_coupled_penaltyState(penalty);
     }
 
+    void Agent::fromCommunication_received_agentState(const std::shared_ptr<const AgentState>& state, int from)
+    {
+        if (state->i_ != get_id())
+        {
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_agentState] Agent " << get_id() << ": "
+				<< "Agent " << get_id() << " received state of agent " << state->i_ << " from agent "
+				<< from << "." << std::endl;
+
+            return;
+        }
+
+		const auto neighbor = DataConversion::get_element_from_vector(neighbors_, from);
+
+        if (neighbor == nullptr)
+        {
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_agentState] Agent " << get_id() << ": "
+				<< "Could not find neighbor with id " << from << "." << std::endl;
+
+            return;
+        }
+
+        neighbor->set_neighbors_localCopies(state);
+    }
+
+    void Agent::fromCommunication_received_couplingState(const std::shared_ptr<const CouplingState>& coupling, const std::shared_ptr<const CouplingState>& previous_coupling, int from)
+    {
+        if (coupling->i_ != from)
+        {
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_couplingState] Agent " << get_id() << ": "
+				<< "Agent " << get_id() << " received coupling state of agent " << coupling->i_
+				<< " from agent " << from << "." << std::endl;
+
+            return;
+        }
+
+		const auto neighbor = DataConversion::get_element_from_vector(neighbors_, from);
+
+		if (neighbor == nullptr)
+		{
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_couplingState] Agent " << get_id() << ": "
+				<< "Could not find agent with id " << from << "." << std::endl;
+			return;
+		}
+
+        neighbor->set_neighbors_couplingState(coupling, previous_coupling);
+    }
+
+    void Agent::fromCommunication_received_couplingState
+    (
+        const std::shared_ptr<const CouplingState>& coupling,
+        const std::shared_ptr<const CouplingState>& previous_coupling,
+        const std::shared_ptr<const CouplingState>& ext_influence_coupling,
+        const std::shared_ptr<const CouplingState>& previous_ext_influence_coupling,
+        int from
+    )
+    {
+        if (coupling->i_ != from)
+        {
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_couplingState] Agent " << get_id() << ": "
+				<< "Agent " << get_id() << " received coupling state of agent "
+				<< coupling->i_ << " from agent " << from << "." << std::endl;
+
+            return;
+        }
+
+		const auto neighbor = DataConversion::get_element_from_vector(neighbors_, from);
+
+		if (neighbor == nullptr)
+		{
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_couplingState] Agent " << get_id() << ": "
+				<< "Could not find agent with id " << from << "." << std::endl;
+			return;
+		}
+
+        neighbor->set_neighbors_externalInfluence_couplingState(ext_influence_coupling, previous_ext_influence_coupling);
+        neighbor->set_neighbors_couplingState(coupling, previous_coupling);
+    }
+
+    void Agent::fromCommunication_received_multiplierState(const std::shared_ptr<const MultiplierState>& multiplier, const std::shared_ptr<const PenaltyState>& penalty, int from)
+    {
+        if (multiplier->i_ != get_id())
+        {
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_multiplierState] Agent " << get_id() << ": "
+				<< "Agent " << get_id() << " received multiplier state of agent " << multiplier->i_
+				<< " from agent " << from << "." << std::endl;
+
+            return;
+        }
+
+		const auto neighbor = DataConversion::get_element_from_vector(neighbors_, from);
+
+		if (neighbor == nullptr)
+		{
+			log_->print(DebugType::Warning) << "[Agent::fromCommunication_received_multiplierState] Agent " << get_id() << ": "
+				<< "Could not find agent with id " << from << "." << std::endl;
+			return;
+		}
+
+        neighbor->set_neighbors_coupled_multiplierState(multiplier);
+        neighbor->set_neighbors_coupled_penaltyState(penalty);
+    }
+
     void Agent::fromCommunication_configured_optimization(const OptimizationInfo& info)
     {
         initialize(info);
@@ -687,16 +804,21 @@ namespace grampcd
         case ADMMStep::SEND_COUPLING_STATE:
             // send coupling state to neighbors
             {
+                std::vector<int> receivers;
                 for( const auto& neighbor : neighbors_ )
                 {
                     // send coupling state
                     if( ( neighbor->is_receivingNeighbor() || neighbor->is_approximating() ) && ! neighbor->is_approximatingDynamics() )
-                        communication_interface_->send_couplingState(get_couplingState(), get_id(), neighbor->get_id());
+                        receivers.push_back(neighbor->get_id());
 
                     // send coupling state and ext_influence_coupling_state
                     if( neighbor->is_approximatingDynamics() )
                         communication_interface_->send_couplingState(get_couplingState(), neighbor->get_externalInfluence_couplingState(), get_id(), neighbor->get_id());
                 }
+
+                // the same coupling state is sent to all receiving neighbors at once
+                if( !receivers.empty() )
+                    communication_interface_->send_couplingState(get_couplingState(), get_id(), receivers);
             }
             break;
 
@@ -728,7 +850,15 @@ namespace grampcd
             break;
 
         case ADMMStep::PRINT:
-            solution_->update_debug_cost(get_predicted_cost());
+        {
+            const auto predicted_cost = get_predicted_cost();
+            std::lock_guard<std::mutex> guard(mutex_solution_);
+            solution_->update_debug_cost(predicted_cost);
+            break;
+        }
+
+        case ADMMStep::PREDICT_STATE:
+            predict_state(optimizationInfo_.COMMON_dt_);
             break;
         }
     }
@@ -778,7 +908,13 @@ namespace grampcd
     void Agent::set_updatedState(const std::vector<typeRNum>& new_state, const typeRNum dt, const typeRNum t0, const typeRNum cost)
     {
         // shift all states
-        shift_states(dt, t0);    
+        // If the states were already shifted by a prediction, only the remaining time is shifted
+        // and the predicted initial state is corrected by the simulated state.
+        if (!is_statePredicted_)
+            shift_states(dt, t0);
+        else if (dt > predicted_dt_)
+            shift_states(dt - predicted_dt_, t0 + predicted_dt_);
+        is_statePredicted_ = false;
 
         // set simulated state
         for( int k = 0; k < new_state.size(); ++k )
@@ -788,7 +924,19 @@ namespace grampcd
         }
 
         // update solution
+        std::unique_lock<std::mutex> guard(mutex_solution_);
         solution_->update_state(new_state, t0, get_id(), cost);
+
+        // the stream may block, hence it receives a copy of the prediction after the solution is released
+        const auto solution_stream = solution_stream_;
+        if (solution_stream == nullptr)
+            return;
+
+        const auto predicted_agentState = solution_->predicted_agentState_;
+        const auto predicted_cost = solution_->predicted_cost_;
+        guard.unlock();
+
+        solution_stream->push(get_id(), t0, new_state, cost, predicted_agentState, predicted_cost);
     }
 
     const std::vector<NeighborPtr>& Agent::get_sendingNeighbors() const
@@ -831,21 +979,42 @@ namespace grampcd
         return is_approximatingDynamics_;
     }
 
-    const SolutionPtr& Agent::get_solution() const
+    const SolutionPtr Agent::get_solution() const
+    {
+        std::lock_guard<std::mutex> guard(mutex_solution_);
+        return std::make_shared<Solution>(*solution_);
+    }
+
+    const SolutionPtr Agent::get_solution_since(const unsigned int index) const
     {
-        return solution_;
+        std::lock_guard<std::mutex> guard(mutex_solution_);
+        return solution_->get_solution_since(index);
+    }
+
+    void Agent::set_maximumNumberOfDataPoints(const unsigned int data_points)
+    {
+        std::lock_guard<std::mutex> guard(mutex_solution_);
+        solution_->maximum_number_of_data_points_ = data_points;
     }
 
     void Agent::set_solution(const SolutionPtr& solution)
     {
+        std::lock_guard<std::mutex> guard(mutex_solution_);
         solution_ = solution;
     }
 
     void Agent::reset_solution()
     {
+        std::lock_guard<std::mutex> guard(mutex_solution_);
         solution_.reset(new Solution());
     }
 
+    void Agent::set_solutionStream(const SolutionStreamPtr& solution_stream)
+    {
+        std::lock_guard<std::mutex> guard(mutex_solution_);
+        solution_stream_ = solution_stream;
+    }
+
     void Agent::set_initialState(const std::vector<typeRNum>& x_init)
     {
         if (x_init_.size() != x_init.size())
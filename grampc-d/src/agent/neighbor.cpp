@@ -114,7 +114,7 @@ namespace grampcd
 
     const CouplingState& Neighbor::get_neighbors_externalInfluence_couplingState() const
     {
-        return neighbors_externalInfluence_couplingState_;
+        return view_neighbors_externalInfluence_couplingState_ ? *view_neighbors_externalInfluence_couplingState_ : neighbors_externalInfluence_couplingState_;
     }
 
     const MultiplierState& Neighbor::get_neighbors_externalInfluence_multiplierState() const
@@ -154,7 +154,7 @@ namespace grampcd
 
     const AgentState& Neighbor::get_neighbors_localCopies() const
     {
-        return neighbors_localCopies_;
+        return view_neighbors_localCopies_ ? *view_neighbors_localCopies_ : neighbors_localCopies_;
     }
 
     const AgentState& Neighbor::get_neighbors_desiredAgentState() const
@@ -164,27 +164,27 @@ namespace grampcd
 
     const CouplingState& Neighbor::get_neighbors_couplingState() const
     {
-        return neighbors_couplingState_;
+        return view_neighbors_couplingState_ ? *view_neighbors_couplingState_ : neighbors_couplingState_;
     }
 
     const MultiplierState& Neighbor::get_neighbors_coupled_multiplierState() const
     {
-        return neighbors_coupled_multiplierState_;
+        return view_neighbors_coupled_multiplierState_ ? *view_neighbors_coupled_multiplierState_ : neighbors_coupled_multiplierState_;
     }
 
     const PenaltyState& Neighbor::get_neighbors_coupled_penaltyState() const
     {
-        return neighbors_coupled_penaltyState_;
+        return view_neighbors_coupled_penaltyState_ ? *view_neighbors_coupled_penaltyState_ : neighbors_coupled_penaltyState_;
     }
 
     const CouplingState& Neighbor::get_previous_neighbors_externalInfluence_couplingState() const
     {
-        return previous_neighbors_externalInfluence_couplingState_;
+        return view_previous_neighbors_externalInfluence_couplingState_ ? *view_previous_neighbors_externalInfluence_couplingState_ : previous_neighbors_externalInfluence_couplingState_;
     }
 
     const CouplingState& Neighbor::get_previous_neighbors_couplingState() const
     {
-        return previous_neighbors_couplingState_;
+        return view_previous_neighbors_couplingState_ ? *view_previous_neighbors_couplingState_ : previous_neighbors_couplingState_;
     }
 
     const AgentState& Neighbor::get_desiredAgentState() const
@@ -280,8 +280,10 @@ namespace grampcd
     {
         if( compare_stateDimensions( neighbors_externalInfluence_couplingState_, coupling ) )
         {
-            previous_neighbors_externalInfluence_couplingState_ = neighbors_externalInfluence_couplingState_;
+            previous_neighbors_externalInfluence_couplingState_ = get_neighbors_externalInfluence_couplingState();
             neighbors_externalInfluence_couplingState_ = coupling;
+            view_neighbors_externalInfluence_couplingState_.reset();
+            view_previous_neighbors_externalInfluence_couplingState_.reset();
         }
         else
             log_->print(DebugType::Error) << "[Neighbor::set_neighbors_externalInfluence_couplingState] "
@@ -331,7 +333,10 @@ namespace grampcd
     void Neighbor::set_neighbors_localCopies( const AgentState& state )
     {
         if( compare_stateDimensions( neighbors_localCopies_, state ) )
+        {
             neighbors_localCopies_ = state;
+            view_neighbors_localCopies_.reset();
+        }
         else
             log_->print(DebugType::Error) << "[Neighbor::set_neighbors_localCopies] "
             << "Failed to set neighbors local copies, as dimensions don't fit." << std::endl;
@@ -341,8 +346,10 @@ namespace grampcd
     {
         if( compare_stateDimensions( neighbors_couplingState_, coupling ) )
         {
-            previous_neighbors_couplingState_ = neighbors_couplingState_;
+            previous_neighbors_couplingState_ = get_neighbors_couplingState();
             neighbors_couplingState_ = coupling;
+            view_neighbors_couplingState_.reset();
+            view_previous_neighbors_couplingState_.reset();
         }
         else
             log_->print(DebugType::Error) << "[Neighbor::set_neighbors_couplingState] "
@@ -352,7 +359,10 @@ namespace grampcd
     void Neighbor::set_neighbors_coupled_multiplierState( const MultiplierState& multiplier )
     {
         if( compare_stateDimensions( neighbors_coupled_multiplierState_, multiplier ) )
+        {
             neighbors_coupled_multiplierState_ = multiplier;
+            view_neighbors_coupled_multiplierState_.reset();
+        }
         else
             log_->print(DebugType::Error) << "[Neighbor::set_neighbors_coupled_multiplierState] "
             << "Failed to set neighbors coupled multiplier state, as dimensions don't fit." << std::endl;
@@ -361,7 +371,10 @@ namespace grampcd
     void Neighbor::set_neighbors_coupled_penaltyState( const PenaltyState& penalty )
     {
         if( compare_stateDimensions( neighbors_coupled_penaltyState_, penalty ) )
+        {
             neighbors_coupled_penaltyState_ = penalty;
+            view_neighbors_coupled_penaltyState_.reset();
+        }
         else
             log_->print(DebugType::Error) << "[Neighbor::set_neighbors_coupled_penaltyState] "
             << "Failed to set neighbors coupled penalty state, as dimensions don't fit." << std::endl;
@@ -376,6 +389,69 @@ namespace grampcd
             << "Failed to neighbors desired agent state, as dimensions don't fit." << std::endl;
     }
 
+    void Neighbor::set_neighbors_localCopies( const std::shared_ptr<const AgentState>& state )
+    {
+        if( compare_stateDimensions( neighbors_localCopies_, *state ) )
+            view_neighbors_localCopies_ = state;
+        else
+            log_->print(DebugType::Error) << "[Neighbor::set_neighbors_localCopies] "
+            << "Failed to set view on neighbors local copies, as dimensions don't fit." << std::endl;
+    }
+
+    void Neighbor::set_neighbors_couplingState( const std::shared_ptr<const CouplingState>& coupling, const std::shared_ptr<const CouplingState>& previous_coupling )
+    {
+        if( compare_stateDimensions( neighbors_couplingState_, *coupling ) && compare_stateDimensions( neighbors_couplingState_, *previous_coupling ) )
+        {
+            view_neighbors_couplingState_ = coupling;
+            view_previous_neighbors_couplingState_ = previous_coupling;
+        }
+        else
+            log_->print(DebugType::Error) << "[Neighbor::set_neighbors_couplingState] "
+            << "Failed to set view on neighbors coupling state, as dimensions don't fit." << std::endl;
+    }
+
+    void Neighbor::set_neighbors_coupled_multiplierState( const std::shared_ptr<const MultiplierState>& multiplier )
+    {
+        if( compare_stateDimensions( neighbors_coupled_multiplierState_, *multiplier ) )
+            view_neighbors_coupled_multiplierState_ = multiplier;
+        else
+            log_->print(DebugType::Error) << "[Neighbor::set_neighbors_coupled_multiplierState] "
+            << "Failed to set view on neighbors coupled multiplier state, as dimensions don't fit." << std::endl;
+    }
+
+    void Neighbor::set_neighbors_coupled_penaltyState( const std::shared_ptr<const PenaltyState>& penalty )
+    {
+        if( compare_stateDimensions( neighbors_coupled_penaltyState_, *penalty ) )
+            view_neighbors_coupled_penaltyState_ = penalty;
+        else
+            log_->print(DebugType::Error) << "[Neighbor::set_neighbors_coupled_penaltyState] "
+            << "Failed to set view on neighbors coupled penalty state, as dimensions don't fit." << std::endl;
+    }
+
+    void Neighbor::set_neighbors_externalInfluence_couplingState( const std::shared_ptr<const CouplingState>& coupling, const std::shared_ptr<const CouplingState>& previous_coupling )
+    {
+        if( compare_stateDimensions( neighbors_externalInfluence_couplingState_, *coupling )
+            && compare_stateDimensions( neighbors_externalInfluence_couplingState_, *previous_coupling ) )
+        {
+            view_neighbors_externalInfluence_couplingState_ = coupling;
+            view_previous_neighbors_externalInfluence_couplingState_ = previous_coupling;
+        }
+        else
+            log_->print(DebugType::Error) << "[Neighbor::set_neighbors_externalInfluence_couplingState] "
+            << "Failed to set view on neighbors external influence coupling state, as dimensions don't fit." << std::endl;
+    }
+
+    void Neighbor::release_views()
+    {
+        view_neighbors_localCopies_.reset();
+        view_neighbors_couplingState_.reset();
+        view_previous_neighbors_couplingState_.reset();
+        view_neighbors_coupled_multiplierState_.reset();
+        view_neighbors_coupled_penaltyState_.reset();
+        view_neighbors_externalInfluence_couplingState_.reset();
+        view_previous_neighbors_externalInfluence_couplingState_.reset();
+    }
+
     void Neighbor::initialize_neighbor(const std::vector<double>& t, const OptimizationInfo& optimization_info, Agent* agent)
     {
         is_approximatingConstraints_ = optimization_info.APPROX_ApproximateConstraints_;
@@ -531,6 +607,8 @@ namespace grampcd
 
     void Neighbor::reset_neighborStates()
     {
+        release_views();
+
         const auto& t = local_copies_.t_;
 
         const unsigned int i = agent_id_;
@@ -15,6 +15,7 @@
 #include "grampcd/model/agent_model.hpp"
 
 #include "grampcd/agent/agent.hpp"
+#include "grampcd/agent/neighbor.hpp"
 
 #include "grampcd/coord/coordinator.hpp"
 
@@ -23,16 +24,18 @@
 #include "grampcd/simulator/simulator.hpp"
 
 #include "grampcd/util/logging.hpp"
+#include "grampcd/util/data_conversion.hpp"
 
 #include <algorithm>
 
 namespace grampcd
 {
 
-    CommunicationInterfaceCentral::CommunicationInterfaceCentral(const LoggingPtr& log, const int number_of_threads) 
+    CommunicationInterfaceCentral::CommunicationInterfaceCentral(const LoggingPtr& log, const int number_of_threads, const bool zero_copy) 
 		:
-		work_(ioService_),
-        log_(log)
+        log_(log),
+        zero_copy_(zero_copy),
+		work_(ioService_)
 	{
 		// start threads
         if (number_of_threads > 1)
@@ -125,6 +128,33 @@ const bool CommunicationInterfaceCentral::register_coupling(const CouplingInfo&
         return false; 
     }
 
+    return send_registeredCoupling(coupling);
+}
+
+const bool CommunicationInterfaceCentral::register_couplings(const std::vector<CouplingInfo>& couplings)
+{
+    if (!coordinator_)
+    {
+        log_->print(DebugType::Error) << "[CentralizedCommunicationInterface::register_couplings] "
+            << "Failed to register couplings as coordinator is missing." << std::endl;
+        return false;
+    }
+
+    const auto registered_couplings = coordinator_->register_couplings(couplings);
+    bool success = registered_couplings.size() == couplings.size();
+    if (!success)
+        log_->print(DebugType::Error) << "[CentralizedCommunicationInterface::register_couplings] "
+            << "Could not register " << couplings.size() - registered_couplings.size() << " of "
+            << couplings.size() << " couplings." << std::endl;
+
+    for (const auto& coupling : registered_couplings)
+        success = send_registeredCoupling(coupling) && success;
+
+    return success;
+}
+
+const bool CommunicationInterfaceCentral::send_registeredCoupling(const CouplingInfo& coupling)
+{
     if (std::max(coupling.agent_id_, coupling.neighbor_id_) >= agents_.size())
     {
         log_->print(DebugType::Error) << "[CentralizedCommunicationInterface::register_coupling] "
@@ -191,6 +221,17 @@ const bool CommunicationInterfaceCentral::send_agentState(const AgentState& stat
         return false;
     }
 
+    if (zero_copy_)
+    {
+        // hand over a view if the local copies are owned by the sending agent
+        const auto neighbor = get_neighbor_of_agent(from, to);
+        if (neighbor != nullptr && &neighbor->get_localCopies() == &state)
+        {
+            agents_[to]->fromCommunication_received_agentState(std::shared_ptr<const AgentState>(neighbor, &state), from);
+            return true;
+        }
+    }
+
     agents_[to]->fromCommunication_received_agentState(state, from);
     return true;
 }
@@ -233,6 +274,11 @@ const std::shared_ptr< std::map< unsigned int, std::vector< CouplingInfoPtr > >
     return std::make_shared< std::map< unsigned int, std::vector< CouplingInfoPtr > > >(coordinator_->get_receivingNeighbors());
 }
 
+const unsigned int CommunicationInterfaceCentral::get_topologyVersion_from_coordinator() const
+{
+    return coordinator_->get_topologyVersion();
+}
+
 const AgentModelPtr CommunicationInterfaceCentral::get_agentModel(const int agentId) const
 {
     return agents_[ agentId ]->get_agentModel();
@@ -252,10 +298,29 @@ const bool CommunicationInterfaceCentral::send_couplingState(const CouplingState
         return false;
     }
 
+    if (zero_copy_ && from >= 0 && static_cast<std::size_t>(from) < agents_.size() && agents_[from] != nullptr && &agents_[from]->get_couplingState() == &state)
+    {
+        const AgentPtr& agent = agents_[from];
+        agents_[to]->fromCommunication_received_couplingState(
+            std::shared_ptr<const CouplingState>(agent, &agent->get_couplingState()),
+            std::shared_ptr<const CouplingState>(agent, &agent->get_previous_couplingState()),
+            from);
+        return true;
+    }
+
     agents_[to]->fromCommunication_received_couplingState(state, from);
     return true;
 }
 
+const bool CommunicationInterfaceCentral::send_couplingState(const CouplingState& state, const int from, const std::vector<int>& to)
+{
+    bool is_sent = true;
+    for (const auto& id : to)
+        is_sent = send_couplingState(state, from, id) && is_sent;
+
+    return is_sent;
+}
+
 const bool CommunicationInterfaceCentral::send_couplingState(const CouplingState& state, const CouplingState& state2, const int from, const int to)
 {
     if( to >= agents_.size() )
@@ -265,11 +330,27 @@ const bool CommunicationInterfaceCentral::send_couplingState(const CouplingState
         return false;
     }
 
+    if (zero_copy_ && from >= 0 && static_cast<std::size_t>(from) < agents_.size() && agents_[from] != nullptr && &agents_[from]->get_couplingState() == &state)
+    {
+        const AgentPtr& agent = agents_[from];
+        const auto neighbor = get_neighbor_of_agent(from, to);
+        if (neighbor != nullptr && &neighbor->get_externalInfluence_couplingState() == &state2)
+        {
+            agents_[to]->fromCommunication_received_couplingState(
+                std::shared_ptr<const CouplingState>(agent, &agent->get_couplingState()),
+                std::shared_ptr<const CouplingState>(agent, &agent->get_previous_couplingState()),
+                std::shared_ptr<const CouplingState>(neighbor, &neighbor->get_externalInfluence_couplingState()),
+                std::shared_ptr<const CouplingState>(neighbor, &neighbor->get_previous_externalInfluence_couplingState()),
+                from);
+            return true;
+        }
+    }
+
     agents_[to]->fromCommunication_received_couplingState(state, state2, from);
     return true;
 }
 
-const bool CommunicationInterfaceCentral::send_multiplierState(const MultiplierState& state, PenaltyState penalty, const int from, const int to)
+const bool CommunicationInterfaceCentral::send_multiplierState(const MultiplierState& state, const PenaltyState& penalty, const int from, const int to)
 {
     if( to >= agents_.size() )
     {
@@ -278,6 +359,20 @@ const bool CommunicationInterfaceCentral::send_multiplierState(const MultiplierS
         return false;
     }
 
+    if (zero_copy_)
+    {
+        // hand over views if multiplier and penalty are owned by the sending agent
+        const auto neighbor = get_neighbor_of_agent(from, to);
+        if (neighbor != nullptr && &neighbor->get_coupled_multiplierState() == &state && &neighbor->get_coupled_penaltyState() == &penalty)
+        {
+            agents_[to]->fromCommunication_received_multiplierState(
+                std::shared_ptr<const MultiplierState>(neighbor, &state),
+                std::shared_ptr<const PenaltyState>(neighbor, &penalty),
+                from);
+            return true;
+        }
+    }
+
     agents_[to]->fromCommunication_received_multiplierState(state, penalty, from);
     return true;
 }
@@ -335,6 +430,17 @@ const bool CommunicationInterfaceCentral::trigger_step(const ADMMStep& step)
     return true;
 }
 
+void CommunicationInterfaceCentral::set_stepTimeout(const typeRNum /*timeout*/)
+{
+    // all agents run in this process and always complete a triggered step,
+    // so that there are no late agents to exclude
+}
+
+void CommunicationInterfaceCentral::set_communicationTimeout(const typeRNum /*timeout*/)
+{
+    // see set_stepTimeout
+}
+
 void CommunicationInterfaceCentral::trigger_simulation(const std::string& Integrator, const typeRNum dt)
 {
     simulator_->distributed_simulation(Integrator, dt);
@@ -356,7 +462,7 @@ const SolutionPtr CommunicationInterfaceCentral::get_solution(const unsigned int
 {
 	for (auto agent : agents_)
 	{
-        if (agent->get_id() == agent_id)
+        if (agent != nullptr && agent->get_id() == agent_id)
             return agent->get_solution();
 	}
 
@@ -391,6 +497,52 @@ const std::vector<SolutionPtr> CommunicationInterfaceCentral::get_solution(const
     return solutions;
 }
 
+const SolutionPtr CommunicationInterfaceCentral::get_solution_since(const unsigned int agent_id, const unsigned int index) const
+{
+    for (const auto& agent : agents_)
+    {
+        if (agent != nullptr && agent->get_id() == static_cast<int>(agent_id))
+            return agent->get_solution_since(index);
+    }
+
+    log_->print(DebugType::Error) << "[CommunicationInterfaceCentral::get_solution_since] "
+        << "Unknown agent." << std::endl;
+
+    return nullptr;
+}
+
+const std::vector<SolutionPtr> CommunicationInterfaceCentral::get_solution_since(const std::string& agents, const std::map<int, unsigned int>& indices) const
+{
+    if (agents != "all")
+    {
+        log_->print(DebugType::Error) << "[CommunicationInterfaceCentral::get_solution_since] "
+            << "Unknown set of agents." << std::endl;
+
+        return std::vector<SolutionPtr>();
+    }
+
+    if (!coordinator_)
+    {
+        log_->print(DebugType::Error) << "[CommunicationInterfaceCentral::get_solution_since] "
+            << "Coordinator is required to sample all solutions." << std::endl;
+
+        return std::vector<SolutionPtr>();
+    }
+
+    std::vector<SolutionPtr> solutions;
+    for (const auto& agent : agents_)
+    {
+        if (agent == nullptr)
+            continue;
+
+        // agents without an index return all of their data points
+        const auto iter = indices.find(agent->get_id());
+        solutions.push_back(agent->get_solution_since(iter != indices.end() ? iter->second : 0));
+    }
+
+    return solutions;
+}
+
 void CommunicationInterfaceCentral::reset_solution(const unsigned int agent_id)
 {
     for (const auto& agent : agents_)
@@ -419,6 +571,12 @@ void CommunicationInterfaceCentral::waitFor_connection(const int agents, const i
         << "This function is not implemented for the centralized communication interface." << std::endl;
 }
 
+void CommunicationInterfaceCentral::waitFor_subCoordinators(const int /*number*/)
+{
+    log_->print(DebugType::Error) << "[CommunicationInterfaceCentral::waitFor_subCoordinators] "
+        << "This function is not implemented for the centralized communication interface." << std::endl;
+}
+
 void CommunicationInterfaceCentral::set_passive()
 {
     log_->print(DebugType::Error) << "[CommunicationInterfaceCentral::set_passive] "
@@ -454,7 +612,16 @@ void CommunicationInterfaceCentral::cap_stored_data(const unsigned int data_poin
     for (auto agent : agents_)
     {
         if(agent != nullptr)
-            agent->get_solution()->maximum_number_of_data_points_ = data_points;
+            agent->set_maximumNumberOfDataPoints(data_points);
+    }
+}
+
+void CommunicationInterfaceCentral::set_solutionStream(const SolutionStreamPtr& solution_stream)
+{
+    for (auto agent : agents_)
+    {
+        if (agent != nullptr)
+            agent->set_solutionStream(solution_stream);
     }
 }
 
@@ -470,4 +637,17 @@ const unsigned int CommunicationInterfaceCentral::get_numberOfAgents() const
     return coordinator_->get_numberOfAgents();
 }
 
+const bool CommunicationInterfaceCentral::is_zeroCopy() const
+{
+    return zero_copy_;
+}
+
+const NeighborPtr CommunicationInterfaceCentral::get_neighbor_of_agent(const int from, const int to) const
+{
+    if (from < 0 || static_cast<std::size_t>(from) >= agents_.size() || agents_[from] == nullptr)
+        return nullptr;
+
+    return DataConversion::get_element_from_vector(agents_[from]->get_neighbors(), to);
+}
+
 }
@@ -11,6 +11,8 @@
  */
 
 #include "grampcd/comm/communication_interface_local.hpp"
+#include "grampcd/comm/shared_memory_channel.hpp"
+#include "grampcd/comm/multicast_channel.hpp"
 
 #include "grampcd/info/communication_data.hpp"
 
@@ -30,16 +32,30 @@
 
 #include <iostream>
 #include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#ifdef __linux__
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
 
 namespace grampcd
 {
 
+    thread_local bool CommunicationInterfaceLocal::is_batching_ = false;
+    thread_local std::vector<CommunicationDataPtr> CommunicationInterfaceLocal::batch_;
+
     // constructor for agents
-    CommunicationInterfaceLocal::CommunicationInterfaceLocal(const LoggingPtr& log, const CommunicationInfo& comm_info_coordinator)
+    CommunicationInterfaceLocal::CommunicationInterfaceLocal(const LoggingPtr& log, const CommunicationInfo& comm_info_coordinator, const int number_of_threads)
         :
+          number_of_threads_(number_of_threads > 0 ? std::max(number_of_threads, min_number_of_threads_) : default_number_of_threads_),
           acceptor_(ioService_, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0)),
           timer_waitForAck_(ioService_),
           timer_waitTrue_(ioService_),
+          timer_wheel_(ioService_, timer_wheel_resolution_),
         log_(log)
     {
         comm_info_local_.agent_type_ = "agent";
@@ -58,11 +74,13 @@ namespace grampcd
     }
 
     // constructor for coordinator
-    CommunicationInterfaceLocal::CommunicationInterfaceLocal(const LoggingPtr& log, const unsigned short port)
+    CommunicationInterfaceLocal::CommunicationInterfaceLocal(const LoggingPtr& log, const unsigned short port, const int number_of_threads)
         :
+          number_of_threads_(number_of_threads > 0 ? std::max(number_of_threads, min_number_of_threads_) : default_number_of_threads_),
           acceptor_(ioService_, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
           timer_waitForAck_(ioService_),
           timer_waitTrue_(ioService_),
+          timer_wheel_(ioService_, timer_wheel_resolution_),
         log_(log)
     {
         comm_info_local_.agent_type_ = "coordinator";
@@ -76,36 +94,167 @@ namespace grampcd
             << "Communication interface is set up for a coordinator." << std::endl;
     }
 
+    // constructor for sub-coordinators
+    CommunicationInterfaceLocal::CommunicationInterfaceLocal(const LoggingPtr& log, const CommunicationInfo& comm_info_coordinator, const unsigned short port, const int number_of_threads)
+        :
+          number_of_threads_(number_of_threads > 0 ? std::max(number_of_threads, min_number_of_threads_) : default_number_of_threads_),
+          acceptor_(ioService_, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
+          timer_waitForAck_(ioService_),
+          timer_waitTrue_(ioService_),
+          timer_wheel_(ioService_, timer_wheel_resolution_),
+        log_(log)
+    {
+        comm_info_local_.agent_type_ = "sub_coordinator";
+        comm_info_local_.ip_ = acceptor_.local_endpoint().address().to_string();
+        comm_info_local_.port_ = std::to_string(acceptor_.local_endpoint().port());
+
+        // set coordinator
+        std::unique_lock<std::shared_mutex> guard(mutex_coordinator_);
+        comm_info_coordinator_ = comm_info_coordinator;
+
+        // start communication as client of the coordinator, agents connect later on
+        start_client();
+
+        log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::CommunicationInterfaceLocal] "
+            << "Communication interface is set up for a sub-coordinator." << std::endl;
+    }
+
     CommunicationInterfaceLocal::~CommunicationInterfaceLocal()
     {
+        // close multicast sockets
+        std::unique_lock<std::mutex> guard_multicast(mutex_multicast_);
+        if (multicast_ != nullptr)
+            multicast_->close();
+        guard_multicast.unlock();
+
         // stop the ioService
         ioService_.stop();
 
         // joi all threads
+        std::unique_lock<std::mutex> guard_threads(mutex_threads_);
         for (auto& thread : threads_for_communication_)
             thread.join();
+        guard_threads.unlock();
+
+        // stop receiving over shared memory
+        std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+        for (const auto& link : link_vec_)
+            close_sharedMemory(link);
+        guard.unlock();
+
+        // release the communication data referenced by timeouts
+        timer_wheel_.clear();
     }
 
     void CommunicationInterfaceLocal::handle_disconnect(const CommunicationDataPtr& comm_data)
     {
+        // a single channel is closed, while its connection remains open
+        if (comm_data->link_ != nullptr)
+        {
+            if (comm_data->is_connected_)
+                async_send(comm_data, ProtocolCommunication::buildProtocol_close_channel());
+
+            handle_disconnect_channel(comm_data);
+            return;
+        }
+
         // reset flag
         comm_data->is_connected_ = false;
 
-        // reset timer
-        comm_data->timer_ping_.cancel();
-        comm_data->timer_polling_.cancel();
-        comm_data->timer_check_connection_.cancel();
+        // stop checking the connection
+        stop_liveness(comm_data);
+
+        // stop receiving over shared memory
+        close_sharedMemory(comm_data);
 
-        // clear data array
-        comm_data->data_.clear();
+        // clear received data
+        comm_data->begin_read_ = 0;
+        comm_data->end_read_ = 0;
+        comm_data->message_read_ = nullptr;
+        comm_data->size_message_read_ = 0;
+        comm_data->last_received_messages_.clear();
+
+        std::unique_lock<std::mutex> guard_send(comm_data->mutex_buffer_send_);
+        comm_data->last_sent_messages_.clear();
+        guard_send.unlock();
 
         // close socket
         close_shutdown_socket(comm_data);
 
+        // all channels of the connection are closed
+        std::vector<CommunicationDataPtr> channels;
+        std::unique_lock<std::mutex> guard_channels(comm_data->mutex_channels_);
+        for (const auto& [ids, weak_channel] : comm_data->channels_)
+        {
+            const auto channel = weak_channel.lock();
+            if (channel != nullptr)
+                channels.push_back(channel);
+        }
+        guard_channels.unlock();
+
+        for (const auto& channel : channels)
+            if (channel->is_connected_)
+                handle_disconnect_channel(channel);
+
+        // the connection to the coordinator is kept, all other connections are established again on demand
+        if (comm_data == link_coordinator_)
+        {
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handle_disconnect] "
+                << "Try to reconnect to coordinator." << std::endl;
+
+            async_connect(comm_data, comm_data->communication_info_->ip_, comm_data->communication_info_->port_);
+        }
+        else
+        {
+            std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+            DataConversion::erase_element_from_vector(link_vec_, comm_data);
+        }
+    }
+
+    void CommunicationInterfaceLocal::handle_disconnect_channel(const CommunicationDataPtr& channel)
+    {
+        const auto& link = channel->link_;
+
+        // reset flag
+        channel->is_connected_ = false;
+
+        // clear the references of the delta encoding
+        channel->last_received_messages_.clear();
+
+        std::unique_lock<std::mutex> guard_send(link->mutex_buffer_send_);
+        channel->last_sent_messages_.clear();
+        guard_send.unlock();
+
+        clear_acknowledgements(channel);
+
+        // the channels to the coordinator are opened again once it is reconnected
+        if (channel->communication_info_->agent_type_ != "coordinator")
+        {
+            std::lock_guard<std::mutex> guard_channels(link->mutex_channels_);
+            const auto iterator = link->channels_.find({ channel->remote_id_, channel->local_id_ });
+            if (iterator != link->channels_.end() && iterator->second.lock() == channel)
+                link->channels_.erase(iterator);
+        }
+
         if (comm_info_local_.agent_type_ == "agent")
-            handle_disconnect_as_agent(comm_data);
+            handle_disconnect_as_agent(channel);
         else if (comm_info_local_.agent_type_ == "coordinator")
-            handle_disconnect_as_coordinator(comm_data);
+            handle_disconnect_as_coordinator(channel);
+        else if (comm_info_local_.agent_type_ == "sub_coordinator")
+            handle_disconnect_as_subCoordinator(channel);
+    }
+
+    void CommunicationInterfaceLocal::close_channels(const int local_id)
+    {
+        std::vector<CommunicationDataPtr> channels;
+        std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+        for (const auto& comm_data : comm_data_vec_)
+            if (comm_data->local_id_ == local_id && comm_data->communication_info_->agent_type_ != "coordinator")
+                channels.push_back(comm_data);
+        guard.unlock();
+
+        for (const auto& channel : channels)
+            handle_disconnect(channel);
     }
 
     void CommunicationInterfaceLocal::handle_disconnect_as_agent(const CommunicationDataPtr& comm_data)
@@ -121,32 +270,49 @@ namespace grampcd
             std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
             DataConversion::erase_element_from_vector(comm_data_vec_, comm_data);
         }
-        // The coordinator disconnected, so fully restart
+        // The sub-coordinator disconnected, the coordinator triggers directly again
+        else if(comm_data->communication_info_->agent_type_ == "sub_coordinator")
+        {
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handleDisconnectAsAgent] "
+                << "Sub-coordinator disconnected." << std::endl;
+
+            std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+            DataConversion::erase_element_from_vector(comm_data_vec_, comm_data);
+        }
+        // The coordinator disconnected, so fully restart the local agent
         else if(comm_data->communication_info_->agent_type_ == "coordinator")
         {
+            const int local_id = comm_data->local_id_;
+            const auto local_agents = get_localAgents();
+
             log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handleDisconnectAsAgent] "
-                << "Coordinator disconnected." << std::endl;
+                << "Coordinator disconnected from agent " << local_id << "." << std::endl;
 
-            std::lock_guard<std::shared_mutex> guard(mutex_infos_);
+            std::unique_lock<std::shared_mutex> guard(mutex_infos_);
 
-            // move all active registration infos to pending
-            while( agent_infos_active_.size() > 0 )
+            // move the active registration info to pending
+            for (auto iterator = agent_infos_active_.begin(); iterator != agent_infos_active_.end(); )
             {
-                agent_infos_registering_.push_back(agent_infos_active_[0]);
-                agent_infos_active_.erase(agent_infos_active_.begin());
+                if (iterator->id_ == local_id)
+                {
+                    agent_infos_registering_.push_back(*iterator);
+                    iterator = agent_infos_active_.erase(iterator);
+                }
+                else
+                    ++iterator;
             }
 
-            // move all active coupling infos to pending and delete all corresponding neighbors
-            std::unique_lock<std::shared_mutex> guard_mutex_basics(mutex_basics_);
-            while(coupling_infos_active_.size() > 0)
-            {
-                const auto& info = coupling_infos_active_[0];
-
-                agent_->fromCommunication_deregistered_coupling(info);
+            // move the active coupling infos of the agent to pending
+            std::vector<CouplingInfo> couplings;
+            for (const auto& info : coupling_infos_active_)
+                if (info.agent_id_ == local_id || info.neighbor_id_ == local_id)
+                    couplings.push_back(info);
 
+            for (const auto& info : couplings)
+            {
                 // check if coupling should be reregistered
                 const bool reregister = (!DataConversion::is_element_in_vector(coupling_infos_blocked_, info))
-                    && (info.agent_id_ == agent_->get_id());
+                    && local_agents.count(info.agent_id_) > 0;
 
                 // if it should not be reregistered, delete it form the list pending couplings
                 if (!reregister)
@@ -160,20 +326,31 @@ namespace grampcd
                 // delete coupling from the list active couplings
                 DataConversion::erase_element_from_vector(coupling_infos_active_, info);
             }
+            guard.unlock();
 
-            // close all connections to agents
-            std::unique_lock<std::shared_mutex> guard_comm_data_vec(mutex_comm_data_vec_);
-            while(comm_data_vec_.size() > 1)
+            // delete the couplings in all local agents that are involved
+            for (const auto& info : couplings)
             {
-                close_shutdown_socket(comm_data_vec_[1]);
-                DataConversion::erase_element_from_vector(comm_data_vec_,comm_data_vec_[1]);
+                for (const int id : { info.agent_id_, info.neighbor_id_ })
+                {
+                    const auto local_agent = local_agents.find(id);
+                    if (local_agent == local_agents.end())
+                        continue;
+
+                    std::lock_guard<std::mutex> guard_agent(local_agent->second->mutex_);
+                    local_agent->second->agent_->fromCommunication_deregistered_coupling(info);
+                }
             }
 
-            // try to reconnect
-            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handleDisconnectAsAgent] "
-                << "Try to reconnect to coordinator." << std::endl;
+            // close all channels to neighbors
+            close_channels(local_id);
 
-            async_connect(comm_data, comm_data->communication_info_->ip_, comm_data->communication_info_->port_);
+            // the coordinator closed the channel only, so register again
+            if (link_coordinator_->is_connected_)
+            {
+                open_channel(comm_data);
+                request_registration();
+            }
         }
     }
 
@@ -237,6 +414,53 @@ namespace grampcd
         // delete CommunicationData from vector
         std::unique_lock<std::shared_mutex> guard_comm_data_vec(mutex_comm_data_vec_);
         DataConversion::erase_element_from_vector(comm_data_vec_, comm_data);
+
+        // agents of a disconnected sub-coordinator are triggered directly again
+        if (comm_data->communication_info_->agent_type_ == "sub_coordinator")
+        {
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handleDisconnectAsCoordinator]"
+                << " Sub-coordinator disconnected." << std::endl;
+
+            for (auto iterator = subCoordinator_of_agent_.begin(); iterator != subCoordinator_of_agent_.end(); )
+            {
+                if (iterator->second == comm_data)
+                    iterator = subCoordinator_of_agent_.erase(iterator);
+                else
+                    ++iterator;
+            }
+        }
+        else if (comm_data->agent_info_->id_ >= 0)
+            subCoordinator_of_agent_.erase(comm_data->agent_info_->id_);
+    }
+
+    void CommunicationInterfaceLocal::handle_disconnect_as_subCoordinator(const CommunicationDataPtr& comm_data)
+    {
+        // An agent of the partition disconnected
+        if (comm_data->communication_info_->agent_type_ != "coordinator")
+        {
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handleDisconnectAsSubCoordinator]"
+                << " Agent with id " << comm_data->communication_info_->id_
+                << " disconnected." << std::endl;
+
+            std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+            DataConversion::erase_element_from_vector(comm_data_vec_, comm_data);
+            return;
+        }
+
+        // The coordinator disconnected, so the partition is void
+        log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handleDisconnectAsSubCoordinator] "
+            << "Coordinator disconnected." << std::endl;
+
+        std::unique_lock<std::shared_mutex> guard_infos(mutex_infos_);
+        partition_.clear();
+        guard_infos.unlock();
+
+        // close all channels to agents
+        close_channels(comm_data->local_id_);
+
+        // the coordinator closed the channel only, so announce this sub-coordinator again
+        if (link_coordinator_->is_connected_)
+            open_channel(comm_data);
     }
 
     void CommunicationInterfaceLocal::acceptHandler(const std::error_code& ec, CommunicationDataPtr comm_data)
@@ -256,22 +480,33 @@ namespace grampcd
         // set flag
         comm_data->is_connected_ = true;
 
-        // start sending a periodic ping to check, if the connection is still open
-        start_ping(comm_data);
+        // exchange wire format and the port on which this host accepts connections
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_wireFormat());
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_listeningPort(std::stoi(comm_info_local_.port_)));
 
-        //it's always an agent that is accepted
-        comm_data->communication_info_->agent_type_ = "agent";
+        // check if the connection is still open
+        configure_keepalive(comm_data);
+        start_liveness(comm_data);
 
-        // read data from socket
-        async_read_some(comm_data);
+        // the connection is identified by the address of the connected host, the channels by the agents
+        asio::error_code ec_endpoint;
+        std::shared_lock<std::shared_mutex> guard_socket(comm_data->mutex_socket_);
+        const auto remote_endpoint = comm_data->socket_.remote_endpoint(ec_endpoint);
+        guard_socket.unlock();
 
         // create new socket
         std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
-        comm_data_vec_.push_back(std::shared_ptr<CommunicationData>(new CommunicationData(ioService_)));
+        if (!ec_endpoint)
+            comm_data->communication_info_->ip_ = remote_endpoint.address().to_string();
+        const auto comm_data_accept = std::make_shared<CommunicationData>(ioService_);
+        link_vec_.push_back(comm_data_accept);
         guard.unlock();
 
+        // read data from socket
+        async_read_some(comm_data);
+
         // accept connection on new socket
-        async_accept(comm_data_vec_.back());
+        async_accept(comm_data_accept);
     }
 
     void CommunicationInterfaceLocal::connectHandler(const std::error_code &ec, CommunicationDataPtr comm_data)
@@ -300,154 +535,307 @@ namespace grampcd
             return;
         }
     
-        // set flag
+        // set flag, the channels that are created from now on are opened directly
+        std::unique_lock<std::mutex> guard_channels(comm_data->mutex_channels_);
         comm_data->is_connected_ = true;
 
-        // start the period ping to check if connection is still open
-        start_ping(comm_data);
+        std::vector<CommunicationDataPtr> channels;
+        for (const auto& [ids, weak_channel] : comm_data->channels_)
+        {
+            const auto channel = weak_channel.lock();
+            if (channel != nullptr)
+                channels.push_back(channel);
+        }
+        guard_channels.unlock();
+
+        // exchange wire format and the port on which this host accepts connections
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_wireFormat());
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_listeningPort(std::stoi(comm_info_local_.port_)));
+
+        // use shared memory if the connected host runs on the same machine
+        offer_sharedMemory(comm_data);
+
+        // check if the connection is still open
+        configure_keepalive(comm_data);
+        start_liveness(comm_data);
+
+        // open the channels that wait for this connection
+        for (const auto& channel : channels)
+            open_channel(channel);
 
         // connected to coordinator
-        if (comm_data->communication_info_->agent_type_ == "coordinator")
+        if (comm_data == link_coordinator_)
         {
             log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::connectHandler] "
                 << "Connected to coordinator." << std::endl;
 
-            // start polling the registrations
-            start_polling(comm_data_vec_.back());
+            // a sub-coordinator announces itself to the coordinator
+            if (comm_info_local_.agent_type_ == "sub_coordinator")
+                get_channel_to_coordinator(-1);
+
+            // send the pending registrations
+            send_registrations();
 
             // accept new connection
-            std::lock_guard<std::shared_mutex> guard(mutex_comm_data_vec_);
-            comm_data_vec_.push_back(std::shared_ptr<CommunicationData>(new CommunicationData(ioService_)));
-            async_accept(comm_data_vec_.back());
-        }
-        // connected to agent
-        else
-        {
-            // send communication info
-            async_send(comm_data, ProtocolCommunication::buildProtocol_send_communicationInfo(comm_info_local_));
+            std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+            const auto comm_data_accept = std::make_shared<CommunicationData>(ioService_);
+            link_vec_.push_back(comm_data_accept);
+            guard.unlock();
 
-            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::connectHandler] Connected to agent with id "
-                << std::to_string(comm_data->communication_info_->id_) << std::endl;
+            async_accept(comm_data_accept);
         }
 
         // read data from socket
         async_read_some(comm_data);
     }
 
+    void CommunicationInterfaceLocal::open_channel(const CommunicationDataPtr& channel)
+    {
+        const auto& link = channel->link_;
+
+        // the channel is opened once its connection is established
+        std::unique_lock<std::mutex> guard_channels(link->mutex_channels_);
+        if (!link->is_connected_ || channel->is_connected_)
+            return;
+        channel->is_connected_ = true;
+        guard_channels.unlock();
+
+        if (channel->communication_info_->agent_type_ == "coordinator")
+        {
+            // a sub-coordinator announces itself to the coordinator
+            if (comm_info_local_.agent_type_ == "sub_coordinator")
+            {
+                std::shared_lock<std::shared_mutex> guard_socket(link->mutex_socket_);
+                comm_info_local_.ip_ = link->socket_.local_endpoint().address().to_string();
+                guard_socket.unlock();
+
+                async_send(channel, ProtocolCommunication::buildProtocol_send_communicationInfo(comm_info_local_));
+            }
+            return;
+        }
+
+        // send communication info
+        async_send(channel, ProtocolCommunication::buildProtocol_send_communicationInfo(get_communicationInfo(channel->local_id_)));
+
+        if (channel->communication_info_->agent_type_ == "sub_coordinator")
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::open_channel] "
+                << "Connected to sub-coordinator." << std::endl;
+        else
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::open_channel] Connected to agent with id "
+                << std::to_string(channel->communication_info_->id_) << std::endl;
+    }
+
     void CommunicationInterfaceLocal::start_server()
     {
         std::lock_guard<std::shared_mutex> guard(mutex_comm_data_vec_);
 
+        // agents of this process are connected without a socket
+        link_loopback_ = std::make_shared<CommunicationData>(ioService_);
+        link_loopback_->is_connected_ = true;
+
         //accept new connection
-        comm_data_vec_.push_back(std::shared_ptr<CommunicationData>(new CommunicationData(ioService_)));
-        async_accept(comm_data_vec_.back());
+        link_vec_.push_back(std::make_shared<CommunicationData>(ioService_));
+        async_accept(link_vec_.back());
 
         // start threads
-        for( int i = 0; i < number_of_threads_; ++i  )
-            threads_for_communication_.push_back(std::thread([this]() {ioService_.run(); }));
+        start_threads(number_of_threads_);
     }
 
     void CommunicationInterfaceLocal::start_client()
     {
         std::lock_guard<std::shared_mutex> guard(mutex_comm_data_vec_);
 
-        // create communication data
-        comm_data_vec_.push_back(std::shared_ptr<CommunicationData>(new CommunicationData(ioService_)));
+        // agents of this process are connected without a socket
+        link_loopback_ = std::make_shared<CommunicationData>(ioService_);
+        link_loopback_->is_connected_ = true;
 
-        // connect to coordinator
-        async_connect(comm_data_vec_.back(), comm_info_coordinator_.ip_, comm_info_coordinator_.port_);
+        // create the connection, which carries the channels of all local agents to the coordinator
+        link_coordinator_ = std::make_shared<CommunicationData>(ioService_);
+        link_vec_.push_back(link_coordinator_);
         comm_info_coordinator_.agent_type_ = "coordinator";
 
         // safe coordinator comminfo in commdata
-        comm_data_vec_.back()->communication_info_ = std::make_shared<CommunicationInfo>(comm_info_coordinator_);
+        link_coordinator_->communication_info_ = std::make_shared<CommunicationInfo>(comm_info_coordinator_);
+
+        // connect to coordinator
+        async_connect(link_coordinator_, comm_info_coordinator_.ip_, comm_info_coordinator_.port_);
 
         // start threads
-        for( int i = 0; i < number_of_threads_; ++i  )
-            threads_for_communication_.push_back(std::thread([this]() {ioService_.run(); }));
+        start_threads(number_of_threads_);
     }
 
-    void CommunicationInterfaceLocal::poll_check_connection(const std::error_code &ec, CommunicationDataPtr comm_data)
+    void CommunicationInterfaceLocal::configure_keepalive(const CommunicationDataPtr& comm_data) const
     {
-        if(ec || !disconnect_at_timeout_)
-            return;
+        std::shared_lock<std::shared_mutex> guard(comm_data->mutex_socket_);
 
-        if(comm_data->communication_info_->agent_type_ == "coordinator")
-            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::poll_check_connection] Coordinator is not responding." << std::endl;
-        else if(comm_data->communication_info_->agent_type_ == "agent")
-            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::poll_check_connection] Agent with id " << comm_data->communication_info_->id_
-                      << " is not responding." << std::endl;    
+        // the operating system detects a dead peer of an idle connection, even if this host is not running
+        asio::error_code ec;
+        comm_data->socket_.set_option(asio::socket_base::keep_alive(true), ec);
 
-        if(comm_data->is_connected_) 
-            handle_disconnect(comm_data);
+#ifdef __linux__
+        // probe after the ping period and drop the connection if sent data is not acknowledged within the liveness timeout
+        const int keepalive_idle_s = static_cast<int>(ping_period_s_);
+        const int keepalive_interval_s = 1;
+        const int keepalive_count = 2;
+        const unsigned int user_timeout_ms = ping_period_s_ * 1000 + ping_waiting_time_ms_;
+
+        const auto handle = comm_data->socket_.native_handle();
+        if (!ec)
+        {
+            if (setsockopt(handle, IPPROTO_TCP, TCP_KEEPIDLE, &keepalive_idle_s, sizeof(keepalive_idle_s)) != 0
+                || setsockopt(handle, IPPROTO_TCP, TCP_KEEPINTVL, &keepalive_interval_s, sizeof(keepalive_interval_s)) != 0
+                || setsockopt(handle, IPPROTO_TCP, TCP_KEEPCNT, &keepalive_count, sizeof(keepalive_count)) != 0
+                || setsockopt(handle, IPPROTO_TCP, TCP_USER_TIMEOUT, &user_timeout_ms, sizeof(user_timeout_ms)) != 0)
+                ec = asio::error_code(errno, asio::error::get_system_category());
+        }
+#endif
+
+        if (ec)
+            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::configure_keepalive] "
+                << "Failed to enable TCP keepalive: " << ec.message() << std::endl;
     }
 
-    void CommunicationInterfaceLocal::start_ping(const CommunicationDataPtr& comm_data)
+    void CommunicationInterfaceLocal::start_liveness(const CommunicationDataPtr& comm_data)
     {
-        // start polling ping
-        comm_data->timer_ping_.expires_from_now(std::chrono::seconds(ping_period_s_));
-        comm_data->timer_ping_.async_wait(std::bind(&CommunicationInterfaceLocal::poll_ping,
-            this, std::placeholders::_1, comm_data) );
+        comm_data->time_last_received_ = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> guard(comm_data->mutex_liveness_);
+        timer_wheel_.cancel(comm_data->timeout_liveness_);
+
+        const unsigned int session = ++comm_data->session_liveness_;
+        comm_data->timeout_liveness_ = timer_wheel_.schedule(std::chrono::seconds(ping_period_s_),
+            [this, comm_data, session]() { check_liveness(comm_data, session); });
     }
 
-    void CommunicationInterfaceLocal::poll_ping(const std::error_code &ec, CommunicationDataPtr comm_data)
+    void CommunicationInterfaceLocal::stop_liveness(const CommunicationDataPtr& comm_data)
     {
-        if(ec)
-            return;
+        std::lock_guard<std::mutex> guard(comm_data->mutex_liveness_);
+        timer_wheel_.cancel(comm_data->timeout_liveness_);
+        comm_data->timeout_liveness_ = 0;
+        ++comm_data->session_liveness_;
+    }
+
+    void CommunicationInterfaceLocal::check_liveness(const CommunicationDataPtr& comm_data, const unsigned int session)
+    {
+        std::unique_lock<std::mutex> guard(comm_data->mutex_liveness_);
 
-        // do not ping, if connection is closed
-        if( !comm_data->is_connected_ ) 
+        // the check was stopped or restarted in the meantime
+        if (session != comm_data->session_liveness_ || !comm_data->is_connected_)
             return;
 
-        // start timer to measure delay
-        comm_data->timer_check_connection_.expires_from_now(std::chrono::milliseconds(ping_waiting_time_ms_));
-        comm_data->timer_check_connection_.async_wait(std::bind(&CommunicationInterfaceLocal::poll_check_connection,
-            this, std::placeholders::_1, comm_data) );
+        const auto ping_period = std::chrono::milliseconds(ping_period_s_ * 1000);
+        const auto timeout = ping_period + std::chrono::milliseconds(ping_waiting_time_ms_);
+        const auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - comm_data->time_last_received_.load());
+
+        if (idle >= timeout && disconnect_at_timeout_)
+        {
+            guard.unlock();
+
+            if (comm_data == link_coordinator_)
+                log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::check_liveness] Coordinator is not responding." << std::endl;
+            else
+                log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::check_liveness] Host " << comm_data->communication_info_->ip_
+                    << ":" << comm_data->communication_info_->port_ << " is not responding." << std::endl;
+
+            if (comm_data->is_connected_)
+                handle_disconnect(comm_data);
+            return;
+        }
 
-        // send ping
-        async_send(comm_data, ProtocolCommunication::buildProtocol_get_ping());
+        // received messages count as sign of life, hence a ping is only sent if the connection is idle
+        auto next_check = ping_period - idle;
+        if (idle >= ping_period)
+        {
+            async_send(comm_data, ProtocolCommunication::buildProtocol_get_ping());
+            next_check = disconnect_at_timeout_ ? timeout - idle : ping_period;
+        }
 
-        // restart timer for next ping
-        start_ping(comm_data);
+        comm_data->timeout_liveness_ = timer_wheel_.schedule(next_check,
+            [this, comm_data, session]() { check_liveness(comm_data, session); });
     }
 
-    void CommunicationInterfaceLocal::start_polling(const CommunicationDataPtr& comm_data) const
+    void CommunicationInterfaceLocal::request_registration()
     {
-        comm_data->timer_polling_.expires_from_now(std::chrono::seconds(polling_period_s_));
-        comm_data->timer_polling_.async_wait(std::bind(&CommunicationInterfaceLocal::poll_registration,
-            this, std::placeholders::_1, comm_data) );
+        // the registrations are sent once the coordinator is connected
+        if (link_coordinator_ == nullptr || !link_coordinator_->is_connected_)
+            return;
+
+        asio::post(ioService_, [this]() { send_registrations(); });
     }
 
-    void CommunicationInterfaceLocal::poll_registration(const std::error_code &ec, CommunicationDataPtr comm_data) const
+    void CommunicationInterfaceLocal::send_registrations()
     {
-        if(ec)
-            return;
+        // each registration is sent over the channel of the agent it belongs to
+        const auto local_agents = get_localAgents();
+        const auto channel_of = [this, &local_agents](const int id, const int other_id)
+        {
+            if (local_agents.count(id) > 0 || local_agents.empty())
+                return get_channel_to_coordinator(id);
+            if (local_agents.count(other_id) > 0)
+                return get_channel_to_coordinator(other_id);
+            return get_channel_to_coordinator(local_agents.begin()->first);
+        };
 
-        std::shared_lock<std::shared_mutex> guard(mutex_infos_);
+        std::lock_guard<std::shared_mutex> guard(mutex_infos_);
+
+        timer_wheel_.cancel(timeout_registration_);
+        timeout_registration_ = 0;
+
+        if (!link_coordinator_->is_connected_)
+            return;
 
         // register pending Agent infos
         for( const auto& info : agent_infos_registering_ )
-            async_send(comm_data, ProtocolCommunication::buildProtocol_register_agent(info));
+            async_send(channel_of(info.id_, info.id_), ProtocolCommunication::buildProtocol_register_agent(info));
 
         // de-register agent infos
-	    for (const auto& info : agent_infos_deregistering_)
-            async_send(comm_data, ProtocolCommunication::buildProtocol_deregister_agent(info));
+        for (const auto& info : agent_infos_deregistering_)
+            async_send(channel_of(info.id_, info.id_), ProtocolCommunication::buildProtocol_deregister_agent(info));
 
-        // register pending Coupling Infos
+        // register pending Coupling Infos, collected in one message per channel
+        std::map< CommunicationDataPtr, std::vector<CouplingInfo> > couplings_of_channel;
         for( const auto& info : coupling_infos_pending_ )
-            async_send(comm_data, ProtocolCommunication::buildProtocol_register_coupling(info));
+            couplings_of_channel[channel_of(info.agent_id_, info.neighbor_id_)].push_back(info);
+        for (const auto& [channel, infos] : couplings_of_channel)
+        {
+            if (infos.size() == 1)
+                async_send(channel, ProtocolCommunication::buildProtocol_register_coupling(infos.front()));
+            else
+                async_send(channel, ProtocolCommunication::buildProtocol_register_couplings(infos));
+        }
 
         // de-register Coupling Infos
         for( const auto& info : coupling_infos_deregistering_ )
-            async_send(comm_data, ProtocolCommunication::buildProtocol_deregister_coupling(info));
+            async_send(channel_of(info.agent_id_, info.neighbor_id_), ProtocolCommunication::buildProtocol_deregister_coupling(info));
+
+        // the coordinator postpones registrations it cannot answer yet, hence retry while some are pending
+        if (agent_infos_registering_.empty() && agent_infos_deregistering_.empty()
+            && coupling_infos_pending_.empty() && coupling_infos_deregistering_.empty())
+            return;
 
-        // restart timer
-        start_polling(comm_data);
+        timeout_registration_ = timer_wheel_.schedule(std::chrono::seconds(polling_period_s_),
+            [this]() { send_registrations(); });
     }
 
     void CommunicationInterfaceLocal::set_agent(const AgentPtr &agent)
     {
         std::lock_guard<std::shared_mutex> guard(mutex_basics_);
-        agent_ = agent;
+
+        auto local_agent = std::make_shared<LocalAgent>();
+        local_agent->agent_ = agent;
+        agents_[agent->get_id()] = local_agent;
+
+        // each agent may block a thread while it waits for a reply, which requires another thread
+        start_threads(static_cast<int>(agents_.size()) + 1);
+    }
+
+    void CommunicationInterfaceLocal::start_threads(const int number)
+    {
+        std::lock_guard<std::mutex> guard(mutex_threads_);
+
+        while (static_cast<int>(threads_for_communication_.size()) < number)
+            threads_for_communication_.push_back(std::thread([this]() {ioService_.run(); }));
     }
 
     void CommunicationInterfaceLocal::set_coordinator(const CoordinatorPtr& coordinator)
@@ -470,12 +858,14 @@ namespace grampcd
 
     const bool CommunicationInterfaceLocal::register_agent(const AgentPtr& agent)
     {
-        std::lock_guard<std::shared_mutex> guard_basics(mutex_basics_);
-        std::unique_lock<std::shared_mutex> guard_infos(mutex_infos_);
+        // several agents may run behind this interface
+        set_agent(agent);
 
-        comm_info_local_.id_ = agent->get_id();
-        agent_ = agent;
+        std::unique_lock<std::shared_mutex> guard_infos(mutex_infos_);
         agent_infos_registering_.push_back( agent->get_agentInfo() );
+        guard_infos.unlock();
+
+        request_registration();
 
         return true;
     }
@@ -484,32 +874,58 @@ namespace grampcd
     {
 	    std::unique_lock<std::shared_mutex> guard_infos(mutex_infos_);
         agent_infos_deregistering_.push_back(agent);
+        guard_infos.unlock();
+
+        request_registration();
 
         return true;
     }
 
     const bool CommunicationInterfaceLocal::register_coupling(const CouplingInfo& coupling)
     {
-        std::lock_guard<std::shared_mutex> guard(mutex_infos_);
+        std::unique_lock<std::shared_mutex> guard(mutex_infos_);
 
         // send coordinator message to register coupling
         coupling_infos_pending_.push_back(coupling);
 
         // do not block coupling anymore
         DataConversion::erase_element_from_vector(coupling_infos_blocked_, coupling);
+        guard.unlock();
+
+        request_registration();
+
+        return true;
+    }
+
+    const bool CommunicationInterfaceLocal::register_couplings(const std::vector<CouplingInfo>& couplings)
+    {
+        std::unique_lock<std::shared_mutex> guard(mutex_infos_);
+
+        // the couplings are sent to the coordinator in one message per channel
+        coupling_infos_pending_.insert(coupling_infos_pending_.end(), couplings.begin(), couplings.end());
+
+        // do not block the couplings anymore
+        for (const auto& coupling : couplings)
+            DataConversion::erase_element_from_vector(coupling_infos_blocked_, coupling);
+        guard.unlock();
+
+        request_registration();
 
         return true;
     }
 
     const bool CommunicationInterfaceLocal::deregister_coupling(const CouplingInfo& coupling)
     {
-        std::lock_guard<std::shared_mutex> guard(mutex_infos_);
+        std::unique_lock<std::shared_mutex> guard(mutex_infos_);
 
         // send coordinator message to de-register coupling
         coupling_infos_deregistering_.push_back(coupling);
 
         // block the coupling from re-registering
         coupling_infos_blocked_.push_back(coupling);
+        guard.unlock();
+
+        request_registration();
 
         return true;
     }
@@ -517,7 +933,7 @@ namespace grampcd
     const bool CommunicationInterfaceLocal::send_numberOfNeighbors(const int number, const int from, const int to)
     {
         // get CommunicationData
-        const auto comm_data = get_communicationData(to);
+        const auto comm_data = get_communicationData(from, to);
 
         // check if agent is known
         if(comm_data == nullptr)
@@ -535,7 +951,7 @@ namespace grampcd
     const bool CommunicationInterfaceLocal::send_agentState(const AgentState& state, int from, int to)
     {
         // get CommunicationData
-        const auto comm_data = get_communicationData(to);
+        const auto comm_data = get_communicationData(from, to);
 
         // check if agent is known
         if(comm_data == nullptr)
@@ -545,7 +961,16 @@ namespace grampcd
             return false;
         }
 
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_agentState(state, from));
+        if (is_compressing())
+        {
+            auto quantized_state = state;
+            quantize(quantized_state.x_);
+            quantize(quantized_state.u_);
+            quantize(quantized_state.v_);
+            send_compressed(comm_data, ProtocolCommunication::buildProtocol_send_agentState(quantized_state, from));
+        }
+        else
+            async_send(comm_data, ProtocolCommunication::buildProtocol_send_agentState(state, from));
 
         return true;
     }
@@ -553,7 +978,7 @@ namespace grampcd
     const bool CommunicationInterfaceLocal::send_desiredAgentState(const AgentState &desired_state, int from, int to)
     {
         // get CommunicationData
-        const auto comm_data = get_communicationData(to);
+        const auto comm_data = get_communicationData(from, to);
 
         // check if agent is known
         if(comm_data == nullptr)
@@ -682,6 +1107,12 @@ namespace grampcd
         return std::make_shared< std::map< unsigned int, std::vector< CouplingInfoPtr > > > (coordinator_->get_receivingNeighbors());
     }
 
+    const unsigned int CommunicationInterfaceLocal::get_topologyVersion_from_coordinator() const
+    {
+        std::shared_lock<std::shared_mutex> guard(mutex_coordinator_);
+        return coordinator_->get_topologyVersion();
+    }
+
     const AgentModelPtr CommunicationInterfaceLocal::get_agentModel(int agentId) const
     {
         // get corresponding communication data
@@ -747,7 +1178,7 @@ namespace grampcd
     const bool CommunicationInterfaceLocal::send_couplingState(const CouplingState& state, int from, int to)
     {
         // get CommunicationData
-        const auto comm_data = get_communicationData(to);
+        const auto comm_data = get_communicationData(from, to);
 
         // check if agent is known
         if(comm_data == nullptr)
@@ -759,15 +1190,48 @@ namespace grampcd
         }
 
         // send coupling states
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_couplingState(state, from));
+        if (is_compressing())
+        {
+            auto quantized_state = state;
+            quantize(quantized_state.z_x_);
+            quantize(quantized_state.z_u_);
+            quantize(quantized_state.z_v_);
+            send_compressed(comm_data, ProtocolCommunication::buildProtocol_send_couplingState(quantized_state, from));
+        }
+        else
+            async_send(comm_data, ProtocolCommunication::buildProtocol_send_couplingState(state, from));
 
         return true;
     }
 
+    const bool CommunicationInterfaceLocal::send_couplingState(const CouplingState& state, const int from, const std::vector<int>& to)
+    {
+        // all neighbors in other processes receive the same datagram
+        const auto multicast = get_multicastChannel();
+        bool is_sent = true;
+        std::vector<int> receivers;
+        for (const auto& id : to)
+        {
+            if (multicast != nullptr && get_localAgent(id) == nullptr)
+                receivers.push_back(id);
+            else
+                is_sent = send_couplingState(state, from, id) && is_sent;
+        }
+
+        if (receivers.empty()
+            || multicast->send(from, receivers, ProtocolCommunication::buildProtocol_send_couplingState(state, from)))
+            return is_sent;
+
+        for (const auto& id : receivers)
+            is_sent = send_couplingState(state, from, id) && is_sent;
+
+        return is_sent;
+    }
+
     const bool CommunicationInterfaceLocal::send_couplingState(const CouplingState& state, const CouplingState& state2, int from, int to)
     {
         // get CommunicationData
-        const auto comm_data = get_communicationData(to);
+        const auto comm_data = get_communicationData(from, to);
 
         // check if agent is known
         if(comm_data == nullptr)
@@ -779,15 +1243,28 @@ namespace grampcd
         }
 
         // send coupling states
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_couplingState(state, state2, from));
+        if (is_compressing())
+        {
+            auto quantized_state = state;
+            quantize(quantized_state.z_x_);
+            quantize(quantized_state.z_u_);
+            quantize(quantized_state.z_v_);
+            auto quantized_state2 = state2;
+            quantize(quantized_state2.z_x_);
+            quantize(quantized_state2.z_u_);
+            quantize(quantized_state2.z_v_);
+            send_compressed(comm_data, ProtocolCommunication::buildProtocol_send_couplingState(quantized_state, quantized_state2, from));
+        }
+        else
+            async_send(comm_data, ProtocolCommunication::buildProtocol_send_couplingState(state, state2, from));
 
         return true;
     }
 
-    const bool CommunicationInterfaceLocal::send_multiplierState(const MultiplierState& multiplier, PenaltyState penalty, int from, int to)
+    const bool CommunicationInterfaceLocal::send_multiplierState(const MultiplierState& multiplier, const PenaltyState& penalty, int from, int to)
     {
         // get CommunicationData
-        const auto comm_data = get_communicationData(to);
+        const auto comm_data = get_communicationData(from, to);
 
         // check if agent is known
         if(comm_data == nullptr)
@@ -799,15 +1276,31 @@ namespace grampcd
         }
 
         // send multiplier states
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_multiplierPenaltyState(multiplier, penalty, from));
+        if (is_compressing())
+        {
+            auto quantized_multiplier = multiplier;
+            quantize(quantized_multiplier.mu_x_);
+            quantize(quantized_multiplier.mu_u_);
+            quantize(quantized_multiplier.mu_v_);
+            auto quantized_penalty = penalty;
+            quantize(quantized_penalty.rho_x_);
+            quantize(quantized_penalty.rho_u_);
+            quantize(quantized_penalty.rho_v_);
+            send_compressed(comm_data, ProtocolCommunication::buildProtocol_send_multiplierPenaltyState(quantized_multiplier, quantized_penalty, from));
+        }
+        else
+            async_send(comm_data, ProtocolCommunication::buildProtocol_send_multiplierPenaltyState(multiplier, penalty, from));
 
         return true;
     }
 
     const bool CommunicationInterfaceLocal::send_convergenceFlag(bool converged, int from)
     {
-        // get CommunicationData
-        const auto comm_data = get_communicationData("coordinator");
+        // get CommunicationData, the flag is returned to the node that triggered the step
+        const auto local_agent = get_localAgent(from);
+        const auto comm_data = (local_agent != nullptr && local_agent->comm_data_triggerStep_ != nullptr
+            && local_agent->comm_data_triggerStep_->is_connected_) ?
+            local_agent->comm_data_triggerStep_ : get_communicationData(from, "coordinator");
 
         // check if agent is known
         if (comm_data == nullptr)
@@ -826,6 +1319,8 @@ namespace grampcd
 
     const bool CommunicationInterfaceLocal::configure_optimization(const OptimizationInfo& info)
     {
+        configure_multicast(info, -1);
+
 	    std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
         std::unique_lock<std::mutex> guard_config_optim(mutex_config_optimizationInfo_);
         std::vector<CommunicationDataPtr> comm_data_to_wait_for;
@@ -835,7 +1330,7 @@ namespace grampcd
         const auto data = ProtocolCommunication::buildProtocol_send_optimizationInfo(info);
         for(const auto& comm_data : comm_data_vec_)
         {
-            if( comm_data->is_connected_ )
+            if( comm_data->is_connected_ && comm_data->communication_info_->agent_type_ != "sub_coordinator" )
             {
                 comm_data_to_wait_for.push_back(comm_data);
                 ++numberOfNotifications_config_optimizationInfo_;
@@ -916,7 +1411,7 @@ namespace grampcd
             std::vector<CommunicationDataPtr> comm_data_to_wait_for;
             for (const auto& comm_data : comm_data_vec_)
             {
-                if( comm_data->is_connected_ )
+                if( comm_data->is_connected_ && comm_data->communication_info_->agent_type_ != "sub_coordinator" )
                 {
                     comm_data_to_wait_for.push_back(comm_data);
                     ++numberOfNotifications_waitForConnection_;
@@ -949,39 +1444,257 @@ namespace grampcd
         }
     }
 
-    const bool CommunicationInterfaceLocal::trigger_step(const ADMMStep& step)
+    void CommunicationInterfaceLocal::waitFor_subCoordinators(const int number)
     {
-        // prepare protocol
-        const auto data = ProtocolCommunication::buildProtocol_triggerStep(step);
+        if (!coordinator_)
+        {
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::waitFor_subCoordinators] "
+                << "Coordinator is required to partition the network." << std::endl;
+            return;
+        }
 
-        // send trigger to each agent
+        // wait until all sub-coordinators are connected
+        std::vector<CommunicationDataPtr> sub_coordinators;
+        while (static_cast<int>(sub_coordinators.size()) != number)
+        {
+            sub_coordinators.clear();
+
+            std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+            for (const auto& comm_data : comm_data_vec_)
+                if (comm_data->is_connected_ && comm_data->communication_info_->agent_type_ == "sub_coordinator")
+                    sub_coordinators.push_back(comm_data);
+            guard.unlock();
+
+            if (static_cast<int>(sub_coordinators.size()) != number)
+                std::this_thread::sleep_for(std::chrono::seconds(general_waiting_time_s_));
+        }
+
+        // partition the coupling graph
+        std::shared_lock<std::shared_mutex> guard_coordinator(mutex_coordinator_);
+        const auto partitions = coordinator_->partition_network(number);
+        guard_coordinator.unlock();
+
+        // hand each partition to a sub-coordinator and redirect its agents
+        std::map<int, CommunicationDataPtr> subCoordinator_of_agent;
+        for (unsigned int p = 0; p < partitions.size(); ++p)
+        {
+            async_send(sub_coordinators[p], ProtocolCommunication::buildProtocol_assign_partition(partitions[p]));
+
+            const auto data = ProtocolCommunication::buildProtocol_send_subCoordinatorInfo(*sub_coordinators[p]->communication_info_);
+            for (const int agent_id : partitions[p])
+            {
+                async_send(get_communicationData(agent_id), data);
+                subCoordinator_of_agent[agent_id] = sub_coordinators[p];
+            }
+        }
+
+        // wait until the agents are connected to their sub-coordinator
+        bool connected = false;
+        while (!connected)
+        {
+            std::unique_lock<std::mutex> guard_waitForConnection(mutex_waitForConnection_);
+            numberOfNotifications_waitForConnection_ = 0;
+
+            const auto data = ProtocolCommunication::buildProtocol_get_numberOfActiveCouplings();
+            for (unsigned int p = 0; p < partitions.size(); ++p)
+            {
+                sub_coordinators[p]->number_of_connected_agents_ = 0;
+                ++numberOfNotifications_waitForConnection_;
+                async_send(sub_coordinators[p], data);
+            }
+
+            // wait for response
+            conditionVariable_waitForConnection_.wait_for(guard_waitForConnection, std::chrono::seconds(general_waiting_time_s_),
+                [this] { return numberOfNotifications_waitForConnection_ == 0; });
+
+            connected = true;
+            for (unsigned int p = 0; p < partitions.size(); ++p)
+                if (sub_coordinators[p]->number_of_connected_agents_ != static_cast<int>(partitions[p].size()))
+                    connected = false;
+
+            guard_waitForConnection.unlock();
+
+            // wait some time until next check
+            if (!connected)
+                std::this_thread::sleep_for(std::chrono::seconds(general_waiting_time_s_));
+        }
+
+        // from now on, the agents are triggered by their sub-coordinator
+        std::unique_lock<std::shared_mutex> guard_comm_data_vec(mutex_comm_data_vec_);
+        subCoordinator_of_agent_ = subCoordinator_of_agent;
+        guard_comm_data_vec.unlock();
+
+        log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::waitFor_subCoordinators] "
+            << "Network is partitioned among " << partitions.size() << " sub-coordinators." << std::endl;
+    }
+
+    const bool CommunicationInterfaceLocal::trigger_step(const ADMMStep& step)
+    {
+        // prepare protocol
+        const auto data = ProtocolCommunication::buildProtocol_triggerStep(step, 0);
+
+        // agents are triggered with a single datagram if multicast is active
+        const auto multicast = get_multicastChannel();
+        std::vector<CommunicationDataPtr> comm_data_multicast;
+
+        // send trigger to each agent
         std::shared_lock<std::shared_mutex> guard_commDataVec(mutex_comm_data_vec_);
         std::unique_lock<std::mutex> guard_triggerStep(mutex_triggerStep_);
         numberOfNotifications_triggerStep_ = 0;
+        ++phase_triggerStep_;
+        int number_of_excluded_agents = 0;
+
+        // steps that send states or flags may have a shorter deadline than the steps that solve the local problems
+        const bool is_sending = step == ADMMStep::SEND_AGENT_STATE || step == ADMMStep::SEND_COUPLING_STATE
+            || step == ADMMStep::SEND_MULTIPLIER_STATE || step == ADMMStep::SEND_CONVERGENCE_FLAG;
+        const auto step_timeout = is_sending && communication_timeout_.count() > 0 ? communication_timeout_ : step_timeout_;
+
+        // sub-coordinators wait for their agents for a shorter time, such that their report arrives before the deadline
+        const auto step_timeout_subCoordinator = std::max<unsigned int>(1, static_cast<unsigned int>(step_timeout.count() * 3 / 4));
+        const auto data_subCoordinator = ProtocolCommunication::buildProtocol_triggerStep(step, step_timeout_subCoordinator);
 
         for(const auto& comm_data : comm_data_vec_)
         {
+            // sub-coordinators forward the trigger to the agents of their partition
+            if (comm_data->communication_info_->agent_type_ == "sub_coordinator")
+            {
+                bool has_partition = false;
+                for (const auto& [agent_id, sub_coordinator] : subCoordinator_of_agent_)
+                    has_partition = has_partition || sub_coordinator == comm_data;
+
+                if (comm_data->is_connected_ && has_partition)
+                {
+                    if (comm_data->number_of_pending_acknowledgements_ > 0)
+                        ++number_of_excluded_agents;
+                    else
+                        send_with_acknowledgement(comm_data, data_subCoordinator);
+                }
+                continue;
+            }
+
             if (comm_data->is_connected_ && !comm_data->is_configured)
                 asio::post([this, comm_data]() { configureOptimization(comm_data); });
             else if( comm_data->is_connected_ && comm_data->is_configured)
 		    {
-			    ++numberOfNotifications_triggerStep_;
-                async_send(comm_data, data);
+                // skip agents that are triggered by their sub-coordinator
+                const auto sub_coordinator = subCoordinator_of_agent_.find(comm_data->communication_info_->id_);
+                if (sub_coordinator != subCoordinator_of_agent_.end() && sub_coordinator->second->is_connected_)
+                    continue;
+
+                // agents that still work on a previous step are excluded from this one
+                if (comm_data->number_of_pending_acknowledgements_ > 0)
+                    ++number_of_excluded_agents;
+                else if (multicast != nullptr)
+                {
+                    expect_acknowledgement(comm_data);
+                    comm_data_multicast.push_back(comm_data);
+                }
+                else
+                    send_with_acknowledgement(comm_data, data);
             }
         }
         guard_commDataVec.unlock();
 
-        // wait for response
-        conditionVariable_triggerStep_.wait_for(guard_triggerStep, std::chrono::seconds(general_waiting_time_s_),
+        if (!comm_data_multicast.empty())
+        {
+            std::vector<int> receivers;
+            for (const auto& comm_data : comm_data_multicast)
+                receivers.push_back(comm_data->communication_info_->id_);
+
+            // fall back to TCP if the datagram can not be sent
+            if (!multicast->send(-1, receivers, data))
+                for (const auto& comm_data : comm_data_multicast)
+                    async_send(comm_data, data);
+        }
+
+        // wait for response until the deadline
+        conditionVariable_triggerStep_.wait_for(guard_triggerStep, step_timeout,
             [this] {return numberOfNotifications_triggerStep_ == 0; });
 
-        if (numberOfNotifications_triggerStep_ != 0)
-            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::triggerStep] "
-            << "Some agents did not execute triggered step in time." << std::endl;
+        // late agents keep their previous iterate for this step
+        const int number_of_late_agents = numberOfNotifications_triggerStep_ + number_of_excluded_agents;
+        if (number_of_late_agents == 0)
+            return true;
+
+        log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::triggerStep] "
+            << number_of_late_agents << " agents did not execute triggered step " << DataConversion::ADMMStep_to_int(step)
+            << " in time and keep their previous iterate." << std::endl;
+        guard_triggerStep.unlock();
 
+        // a missing convergence flag counts as not converged
+        if (step == ADMMStep::SEND_CONVERGENCE_FLAG)
+        {
+            std::unique_lock<std::shared_mutex> guard_coordinator(mutex_coordinator_);
+            if (coordinator_)
+                coordinator_->fromCommunication_received_convergenceFlag(false, -1);
+        }
+
+        return false;
+    }
+
+    void CommunicationInterfaceLocal::set_stepTimeout(const typeRNum timeout)
+    {
+        std::unique_lock<std::mutex> guard_triggerStep(mutex_triggerStep_);
+
+        if (timeout <= 0)
+            step_timeout_ = std::chrono::seconds(general_waiting_time_s_);
+        else
+            step_timeout_ = std::chrono::milliseconds(std::max(1, static_cast<int>(std::ceil(timeout * 1000))));
+    }
+
+    void CommunicationInterfaceLocal::set_communicationTimeout(const typeRNum timeout)
+    {
+        std::unique_lock<std::mutex> guard_triggerStep(mutex_triggerStep_);
+
+        if (timeout <= 0)
+            communication_timeout_ = std::chrono::milliseconds(0);
+        else
+            communication_timeout_ = std::chrono::milliseconds(std::max(1, static_cast<int>(std::ceil(timeout * 1000))));
+    }
+
+    void CommunicationInterfaceLocal::send_with_acknowledgement(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data)
+    {
+        expect_acknowledgement(comm_data);
+        async_send(comm_data, data);
+    }
+
+    void CommunicationInterfaceLocal::expect_acknowledgement(const CommunicationDataPtr& comm_data)
+    {
+        ++comm_data->number_of_pending_acknowledgements_;
+        comm_data->phase_triggerStep_ = phase_triggerStep_;
+        ++numberOfNotifications_triggerStep_;
+    }
+
+    const bool CommunicationInterfaceLocal::register_acknowledgement(const CommunicationDataPtr& comm_data) const
+    {
+        if (comm_data->number_of_pending_acknowledgements_ == 0)
+            return false;
+
+        // acknowledgements arrive in order, so only the last one belongs to the current phase
+        --comm_data->number_of_pending_acknowledgements_;
+        if (comm_data->number_of_pending_acknowledgements_ > 0 || comm_data->phase_triggerStep_ != phase_triggerStep_)
+            return false;
+
+        --numberOfNotifications_triggerStep_;
+        conditionVariable_triggerStep_.notify_one();
         return true;
     }
 
+    void CommunicationInterfaceLocal::clear_acknowledgements(const CommunicationDataPtr& comm_data) const
+    {
+        std::unique_lock<std::mutex> guard_triggerStep(mutex_triggerStep_);
+        if (comm_data->number_of_pending_acknowledgements_ == 0)
+            return;
+
+        // the current step does not wait for the channel until the deadline
+        if (comm_data->phase_triggerStep_ == phase_triggerStep_)
+        {
+            --numberOfNotifications_triggerStep_;
+            conditionVariable_triggerStep_.notify_one();
+        }
+        comm_data->number_of_pending_acknowledgements_ = 0;
+    }
+
     void CommunicationInterfaceLocal::trigger_simulation(const std::string& Integrator, typeRNum dt)
     {
         std::shared_lock<std::shared_mutex> guard(mutex_basics_);
@@ -998,12 +1711,14 @@ namespace grampcd
     )
     {
         const auto comm_data = get_communicationData(agentId);
+        if (comm_data == nullptr)
+            return;
 
         std::unique_lock<std::mutex> guard_triggerStep(mutex_triggerStep_);
         numberOfNotifications_triggerStep_ = 0;
-        ++numberOfNotifications_triggerStep_;
+        ++phase_triggerStep_;
 
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_simulatedState(new_state, dt, t0, cost));
+        send_with_acknowledgement(comm_data, ProtocolCommunication::buildProtocol_send_simulatedState(new_state, dt, t0, cost));
 
         // wait for response
         conditionVariable_triggerStep_.wait_for(guard_triggerStep, std::chrono::seconds(general_waiting_time_s_),
@@ -1016,9 +1731,19 @@ namespace grampcd
     }
 
     void CommunicationInterfaceLocal::writeHandler(const std::error_code& ec,
-        std::size_t bytes_transferred, CommunicationDataPtr comm_data,
-        std::shared_ptr<std::vector<char>> data_ptr) const
+        std::size_t bytes_transferred, CommunicationDataPtr comm_data) const
     {
+        std::lock_guard<std::mutex> guard(comm_data->mutex_buffer_send_);
+
+        // release the written batch
+        comm_data->buffer_writing_ = WriteBatch();
+        comm_data->is_writing_ = false;
+
+        // the switch is written, so all following messages are written to shared memory
+        if (!ec && comm_data->is_switching_ && comm_data->shared_memory_ != nullptr)
+            comm_data->is_sendingSharedMemory_ = true;
+        comm_data->is_switching_ = false;
+
         if (ec)
         {
             log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::writeHandler] "
@@ -1026,16 +1751,13 @@ namespace grampcd
                 << "Error number: " << ec.value() << std::endl
                 << "Error message: " << ec.message() << std::endl;
 
-            return;
-        }
-
-        // delete corresponding buffer
-        std::unique_lock<std::mutex> guard(comm_data->mutex_buffer_send_);
-        for (unsigned int i = 0; i < comm_data->buffer_send_.size(); ++i)
-        {
-            if (comm_data->buffer_send_[i] == data_ptr)
-                comm_data->buffer_send_.erase(comm_data->buffer_send_.begin() + i);
+            // the queued messages can not be sent anymore
+            comm_data->buffer_switch_ = WriteBatch();
+            comm_data->buffer_send_ = WriteBatch();
         }
+        // write the messages that were queued in the meantime
+        else if (!comm_data->buffer_send_.views_.empty() || !comm_data->buffer_switch_.views_.empty())
+            start_write(comm_data);
     }
 
     void CommunicationInterfaceLocal::readHandler(const std::error_code& ec,
@@ -1049,39 +1771,86 @@ namespace grampcd
             return;
         }
 
-        // safe data
-        const unsigned int pos_in_vector = static_cast<unsigned int>( comm_data->data_.size() );
-        comm_data->data_.resize(comm_data->data_.size() + amountOfBytes, 0);
-        std::copy(comm_data->buffer_read_.begin(), comm_data->buffer_read_.begin() + amountOfBytes, comm_data->data_.begin() + pos_in_vector);
+        // any received data counts as sign of life
+        comm_data->time_last_received_ = std::chrono::steady_clock::now();
 
-        // only evaluate the data, if at least 4 bytes are read
-        while(comm_data->data_.size() >= 4)
+        // a large message is received directly into its own buffer
+        if (comm_data->message_read_ != nullptr)
         {
-            unsigned int size_of_data = 0;
-            unsigned int pos = 0;
-
-            // read size of data
-            DataConversion::read_from_charArray(comm_data->data_, pos, size_of_data);
+            comm_data->size_message_read_ += amountOfBytes;
+            if (comm_data->size_message_read_ == comm_data->message_read_->size())
+            {
+                const auto data = comm_data->message_read_;
+                comm_data->message_read_ = nullptr;
+                comm_data->size_message_read_ = 0;
 
-            if (size_of_data == 41)
-                bool TEST = true;
+                dispatch_data(comm_data, data);
+            }
+        }
+        else
+        {
+            comm_data->end_read_ += amountOfBytes;
+            const bool is_buffer_filled = comm_data->end_read_ == comm_data->buffer_read_.size();
 
-            // if enough data is read, evaluate it
-            if (comm_data->data_.size() >= size_of_data)
+            // evaluate all complete messages, at least 4 bytes are required to read the size of a message
+            while (comm_data->end_read_ - comm_data->begin_read_ >= sizeof(int))
             {
-                // create local copy of data
-                std::shared_ptr<std::vector<char>> data(new std::vector<char>(size_of_data, 0));
-                for (unsigned int k = 0; k < size_of_data; ++k)
-                    (*data)[k] = comm_data->data_[k];
+                unsigned int size_of_data = 0;
+                unsigned int pos = static_cast<unsigned int>(comm_data->begin_read_);
+
+                // read size of data
+                DataConversion::read_from_charArray(comm_data->buffer_read_, pos, size_of_data);
+
+                if (size_of_data < static_cast<unsigned int>(first_element_with_data_))
+                {
+                    log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::readHandler] "
+                        << "Received message with invalid size " << size_of_data << "." << std::endl;
+
+                    handle_disconnect(comm_data);
+                    return;
+                }
 
-                // erase copied data
-                comm_data->data_.erase(comm_data->data_.begin(), comm_data->data_.begin() + size_of_data);
+                const auto begin = comm_data->buffer_read_.begin() + comm_data->begin_read_;
+                const auto received = comm_data->end_read_ - comm_data->begin_read_;
 
-                // evaluate data asynchronously
-                asio::post([comm_data, this, data]() { ProtocolCommunication::evaluateData(comm_data, this, *data); });
+                // if enough data is read, evaluate it
+                if (received >= size_of_data)
+                {
+                    std::shared_ptr<std::vector<char>> data(new std::vector<char>(begin, begin + size_of_data));
+                    comm_data->begin_read_ += size_of_data;
+
+                    dispatch_data(comm_data, data);
+                }
+                // receive the remaining part of large messages directly
+                else if (size_of_data > comm_data->buffer_read_.size())
+                {
+                    comm_data->message_read_ = std::make_shared< std::vector<char> >(size_of_data, 0);
+                    std::copy(begin, begin + received, comm_data->message_read_->begin());
+                    comm_data->size_message_read_ = received;
+                    comm_data->begin_read_ = comm_data->end_read_;
+                    break;
+                }
+                else
+                    break;
             }
-            else
-                break;
+
+            // move the incomplete message to the front of the buffer
+            if (comm_data->begin_read_ == comm_data->end_read_)
+            {
+                comm_data->begin_read_ = 0;
+                comm_data->end_read_ = 0;
+            }
+            else if (comm_data->begin_read_ > 0)
+            {
+                std::copy(comm_data->buffer_read_.begin() + comm_data->begin_read_,
+                    comm_data->buffer_read_.begin() + comm_data->end_read_, comm_data->buffer_read_.begin());
+                comm_data->end_read_ -= comm_data->begin_read_;
+                comm_data->begin_read_ = 0;
+            }
+
+            // read larger chunks if the last read filled the buffer
+            if (is_buffer_filled && comm_data->buffer_read_.size() < max_size_buffer_read_)
+                comm_data->buffer_read_.resize(2 * comm_data->buffer_read_.size(), 0);
         }
 
         // read data from socket
@@ -1089,36 +1858,42 @@ namespace grampcd
             async_read_some(comm_data);
     }
 
-    void CommunicationInterfaceLocal::connect_to_neighbor(const CommunicationInfoPtr& info)
+    void CommunicationInterfaceLocal::connect_to_neighbor(const int local_id, const CommunicationInfoPtr& info)
     {
         // check if it is actually a neighbor
-        if( info->id_ == comm_info_local_.id_ ) 
+        if( info->id_ == local_id ) 
             return;
 
-        std::shared_lock<std::shared_mutex> soft_guard_comm_data_vec(mutex_comm_data_vec_);
+        // receive the coupling states of the neighbor
+        join_multicastGroup(info->id_);
 
         // check if connection is already established
-        for( const auto& comm_data : comm_data_vec_ )
-            if (comm_data->communication_info_->id_ == info->id_) 
-                return;
-
-        soft_guard_comm_data_vec.unlock();
+        if (get_communicationData(local_id, info->id_) != nullptr)
+            return;
 
         // it's always the agent with the higher id that is connecting to
         // the agent with lower id to prevent race conditions
-        if( info->id_ > comm_info_local_.id_ ) 
+        if( info->id_ > local_id ) 
             return;
 
-        // create new connection
-        std::unique_lock<std::shared_mutex> strong_guard_comm_data_vec(mutex_comm_data_vec_);
-        comm_data_vec_.push_back(std::shared_ptr<CommunicationData>( new CommunicationData(ioService_)));
-        strong_guard_comm_data_vec.unlock();
+        // agents of this process exchange their messages directly, hence both channels are opened at once
+        if (get_localAgent(info->id_) != nullptr)
+        {
+            const auto channel = create_channel(link_loopback_, local_id, info->id_, info);
+            const auto channel_neighbor = create_channel(link_loopback_, info->id_, local_id,
+                std::make_shared<CommunicationInfo>(get_communicationInfo(local_id)));
 
-        // add communicationInfo to list
-        comm_data_vec_.back()->communication_info_ = info;
+            channel_neighbor->is_connected_ = true;
+            channel->is_connected_ = true;
 
-        // connect to neighbor
-        async_connect(comm_data_vec_.back(), info->ip_, info->port_);
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::connect_to_neighbor] "
+                << "Connected agent " << local_id << " to agent with id " << info->id_ << " within this process." << std::endl;
+            return;
+        }
+
+        // the channel is opened over the connection to the process of the neighbor
+        const auto channel = create_channel(get_link(info->ip_, info->port_), local_id, info->id_, info);
+        open_channel(channel);
     }
 
     const bool CommunicationInterfaceLocal::fromCommunication_deregistered_coupling(const CouplingInfo& coupling)
@@ -1165,12 +1940,153 @@ namespace grampcd
         return nullptr;
     }
 
-    void CommunicationInterfaceLocal::waitFor_flag_from_coordinator()
+    const CommunicationDataPtr CommunicationInterfaceLocal::get_communicationData(const int local_id, const int agent_id) const
+    {
+        std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+
+        for (const auto& comm_data : comm_data_vec_)
+            if (comm_data->local_id_ == local_id && comm_data->remote_id_ == agent_id
+                && comm_data->communication_info_->agent_type_ == "agent")
+                return comm_data;
+
+        return nullptr;
+    }
+
+    const CommunicationDataPtr CommunicationInterfaceLocal::get_communicationData(const int local_id, const std::string& agent_type) const
+    {
+        std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+
+        for (const auto& comm_data : comm_data_vec_)
+            if (comm_data->local_id_ == local_id && comm_data->communication_info_->agent_type_ == agent_type)
+                return comm_data;
+
+        return nullptr;
+    }
+
+    const std::shared_ptr<CommunicationInterfaceLocal::LocalAgent> CommunicationInterfaceLocal::get_localAgent(const int id) const
+    {
+        std::shared_lock<std::shared_mutex> guard(mutex_basics_);
+
+        const auto local_agent = agents_.find(id);
+        if (local_agent == agents_.end())
+            return nullptr;
+
+        return local_agent->second;
+    }
+
+    const std::map< int, std::shared_ptr<CommunicationInterfaceLocal::LocalAgent> > CommunicationInterfaceLocal::get_localAgents() const
+    {
+        std::shared_lock<std::shared_mutex> guard(mutex_basics_);
+        return agents_;
+    }
+
+    const CommunicationInfo CommunicationInterfaceLocal::get_communicationInfo(const int local_id) const
+    {
+        // all agents of this process share the address, on which it accepts connections
+        auto info = comm_info_local_;
+        info.id_ = local_id;
+        return info;
+    }
+
+    const CommunicationDataPtr CommunicationInterfaceLocal::get_link(const std::string& ip, const std::string& port)
+    {
+        std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+
+        for (const auto& link : link_vec_)
+            if (link->communication_info_->ip_ == ip && link->communication_info_->port_ == port && link != link_coordinator_)
+                return link;
+
+        // connect to the process
+        const auto link = std::make_shared<CommunicationData>(ioService_);
+        link->communication_info_->ip_ = ip;
+        link->communication_info_->port_ = port;
+        link_vec_.push_back(link);
+        guard.unlock();
+
+        async_connect(link, ip, port);
+
+        return link;
+    }
+
+    const CommunicationDataPtr& CommunicationInterfaceLocal::get_connection(const CommunicationDataPtr& comm_data) const
+    {
+        return comm_data->link_ != nullptr ? comm_data->link_ : comm_data;
+    }
+
+    const CommunicationDataPtr CommunicationInterfaceLocal::find_channel(const CommunicationDataPtr& link, const int local_id, const int remote_id) const
+    {
+        std::lock_guard<std::mutex> guard(link->mutex_channels_);
+
+        const auto channel = link->channels_.find({ remote_id, local_id });
+        if (channel == link->channels_.end())
+            return nullptr;
+
+        return channel->second.lock();
+    }
+
+    const CommunicationDataPtr CommunicationInterfaceLocal::create_channel(const CommunicationDataPtr& link, const int local_id,
+        const int remote_id, const CommunicationInfoPtr& info)
+    {
+        auto channel = find_channel(link, local_id, remote_id);
+        if (channel != nullptr)
+            return channel;
+
+        std::lock_guard<std::shared_mutex> guard(mutex_comm_data_vec_);
+        std::lock_guard<std::mutex> guard_channels(link->mutex_channels_);
+
+        // the channel may be created in the meantime
+        auto& weak_channel = link->channels_[{ remote_id, local_id }];
+        channel = weak_channel.lock();
+        if (channel != nullptr)
+            return channel;
+
+        channel = std::make_shared<CommunicationData>(ioService_);
+        channel->link_ = link;
+        channel->local_id_ = local_id;
+        channel->remote_id_ = remote_id;
+        channel->communication_info_ = info;
+        weak_channel = channel;
+        comm_data_vec_.push_back(channel);
+
+        return channel;
+    }
+
+    const CommunicationDataPtr CommunicationInterfaceLocal::get_channel_to_coordinator(const int local_id)
     {
-        const auto comm_data = get_communicationData("coordinator");
+        const auto channel = create_channel(link_coordinator_, local_id, -1, link_coordinator_->communication_info_);
+        open_channel(channel);
 
+        return channel;
+    }
+
+    const CommunicationDataPtr CommunicationInterfaceLocal::accept_channel(const CommunicationDataPtr& link, const int from, const int to)
+    {
+        const auto channel = find_channel(link, to, from);
+        if (channel != nullptr)
+            return channel;
+
+        // an agent accepts channels to its local agents only
+        if (comm_info_local_.agent_type_ == "agent" && get_localAgent(to) == nullptr)
+        {
+            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::accept_channel] "
+                << "Received message for unknown agent " << to << "." << std::endl;
+            return nullptr;
+        }
+
+        // it's always an agent that opens a channel
+        auto info = std::make_shared<CommunicationInfo>();
+        info->agent_type_ = "agent";
+
+        const auto channel_accepted = create_channel(link, to, from, info);
+        channel_accepted->is_connected_ = true;
+
+        return channel_accepted;
+    }
+
+    void CommunicationInterfaceLocal::waitFor_flag_from_coordinator()
+    {
         // check if agent is known
-        if (comm_data == nullptr)
+        if (link_coordinator_ == nullptr)
         { 
             log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::getFlagFromCoordinator] "
                 << "Coordinator not found. First set coordinator." << std::endl;
@@ -1178,16 +2094,38 @@ namespace grampcd
             return;
         }
 
+        // the flag is awaited for each local agent
+        std::vector<CommunicationDataPtr> channels;
+        for (const auto& [id, local_agent] : get_localAgents())
+            channels.push_back(get_channel_to_coordinator(id));
+        if (channels.empty())
+            channels.push_back(get_channel_to_coordinator(-1));
+
         // wait until flag is set from coordinator
-        comm_data->flag_from_coordinator_ = false;
-	    while (!comm_data->flag_from_coordinator_)
-		    std::this_thread::sleep_for(std::chrono::seconds(general_waiting_time_s_));
+        for (const auto& comm_data : channels)
+            comm_data->flag_from_coordinator_ = false;
+
+        for (const auto& comm_data : channels)
+	        while (!comm_data->flag_from_coordinator_)
+		        std::this_thread::sleep_for(std::chrono::seconds(general_waiting_time_s_));
     }
 
     void CommunicationInterfaceLocal::cap_stored_data(unsigned int data_points)
     {
-        std::unique_lock<std::shared_mutex> guard_basic(mutex_basics_);
-        agent_->get_solution()->maximum_number_of_data_points_ = data_points;
+        for (const auto& [id, local_agent] : get_localAgents())
+        {
+            std::lock_guard<std::mutex> guard(local_agent->mutex_);
+            local_agent->agent_->set_maximumNumberOfDataPoints(data_points);
+        }
+    }
+
+    void CommunicationInterfaceLocal::set_solutionStream(const SolutionStreamPtr& solution_stream)
+    {
+        for (const auto& [id, local_agent] : get_localAgents())
+        {
+            std::lock_guard<std::mutex> guard(local_agent->mutex_);
+            local_agent->agent_->set_solutionStream(solution_stream);
+        }
     }
 
     void CommunicationInterfaceLocal::set_passive()
@@ -1198,14 +2136,15 @@ namespace grampcd
 
     const SolutionPtr CommunicationInterfaceLocal::get_solution(unsigned int agent_id) const
     {
-        if (agent_->get_id() != agent_id)
+        const auto local_agent = get_localAgent(agent_id);
+        if (local_agent == nullptr)
         {
             log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::get_solution] "
                 << "Unknown agent." << std::endl;
             return nullptr;
         }
 
-        return agent_->get_solution();
+        return local_agent->agent_->get_solution();
     }
 
     const std::vector<SolutionPtr> CommunicationInterfaceLocal::get_solution(const std::string& agents) const
@@ -1225,6 +2164,67 @@ namespace grampcd
 		    return std::vector<SolutionPtr>();
         }
 
+        const auto data = ProtocolCommunication::buildProtocol_get_solution();
+        return request_solutions([&data](const CommunicationDataPtr&) { return data; });
+    }
+
+    const SolutionPtr CommunicationInterfaceLocal::get_solution_since(const unsigned int agent_id, const unsigned int index) const
+    {
+        const auto local_agent = get_localAgent(agent_id);
+        if (local_agent != nullptr)
+        {
+            return local_agent->agent_->get_solution_since(index);
+        }
+
+        if (!coordinator_)
+        {
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::get_solution_since] "
+                << "Unknown agent." << std::endl;
+            return nullptr;
+        }
+
+        // only the agent with the id is requested
+        const auto data = ProtocolCommunication::buildProtocol_get_solution_since(index);
+        const auto solutions = request_solutions([&data, agent_id](const CommunicationDataPtr& comm_data)
+            { return comm_data->communication_info_->id_ == static_cast<int>(agent_id) ? data : nullptr; });
+
+        if (solutions.empty())
+        {
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::get_solution_since] "
+                << "Agent " << agent_id << " is not connected." << std::endl;
+            return nullptr;
+        }
+
+        return solutions.front();
+    }
+
+    const std::vector<SolutionPtr> CommunicationInterfaceLocal::get_solution_since(const std::string& agents, const std::map<int, unsigned int>& indices) const
+    {
+        if (agents != "all")
+        {
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::get_solution_since] "
+                << "Unknown set of agents." << std::endl;
+            return std::vector<SolutionPtr>();
+        }
+
+        if (!coordinator_)
+        {
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::get_solution_since] "
+                << "Coordinator is required to sample all solutions." << std::endl;
+
+            return std::vector<SolutionPtr>();
+        }
+
+        // agents without an index send all of their data points
+        return request_solutions([&indices](const CommunicationDataPtr& comm_data)
+            {
+                const auto iter = indices.find(comm_data->communication_info_->id_);
+                return ProtocolCommunication::buildProtocol_get_solution_since(iter != indices.end() ? iter->second : 0);
+            });
+    }
+
+    const std::vector<SolutionPtr> CommunicationInterfaceLocal::request_solutions(const std::function<const std::shared_ptr<std::vector<char>>(const CommunicationDataPtr&)>& build_request) const
+    {
         std::vector<CommunicationDataPtr> comm_data_to_wait_for;
 
         std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
@@ -1232,11 +2232,14 @@ namespace grampcd
         numberOfNotifications_getSolutions_ = 0;
 
         // send request for solution
-        const auto data = ProtocolCommunication::buildProtocol_get_solution();
         for (const auto& comm_data : comm_data_vec_)
         {
-            if (comm_data->is_connected_)
+            if (comm_data->is_connected_ && comm_data->communication_info_->agent_type_ != "sub_coordinator")
             {
+                const auto data = build_request(comm_data);
+                if (data == nullptr)
+                    continue;
+
                 ++numberOfNotifications_getSolutions_;
                 comm_data_to_wait_for.push_back(comm_data);
                 async_send(comm_data, data);
@@ -1259,94 +2262,559 @@ namespace grampcd
         for (unsigned int i = 0; i < comm_data_to_wait_for.size(); ++i)
             solutions[i] = comm_data_to_wait_for[i]->solution_;
 
-        return solutions;
+        return solutions;
+    }
+
+    void CommunicationInterfaceLocal::reset_solution(unsigned int agent_id)
+    {
+        const auto local_agent = get_localAgent(agent_id);
+        if (local_agent != nullptr)
+            local_agent->agent_->reset_solution();
+        else
+            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::reset_solution] "
+            << "Agent " << agent_id << " not found." << std::endl;
+    }
+
+    void CommunicationInterfaceLocal::reset_solution(const std::string& agents)
+    {
+        if (agents == "all")
+        {
+            for (const auto& [id, local_agent] : get_localAgents())
+                local_agent->agent_->reset_solution();
+        }
+        else
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::reset_solution] "
+            << "Set of agents not known." << std::endl;
+    }
+
+    void CommunicationInterfaceLocal::send_flag_to_agents(const std::string& agents) const
+    {
+        if (agents == "all")
+        {
+            std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
+            const auto data = ProtocolCommunication::buildProtocol_send_flagToAgents();
+
+            for (const auto& comm_data : comm_data_vec_)
+                async_send(comm_data, data);
+
+            return;
+        }
+
+        log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::send_flag_to_agents] "
+            << "Unknown set of agents '" << agents << "'." << std::endl;
+    }
+
+    void CommunicationInterfaceLocal::send_flag_to_agents(const int agent_id) const
+    {
+        const auto comm_data = get_communicationData(agent_id);
+
+        // check if agent is known
+        if (comm_data == nullptr)
+        {
+            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::send_flag_to_agents] "
+                << "Agent with id " << agent_id << " not found." << std::endl;
+            return;
+        }
+
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_flagToAgents());    
+    }
+
+    void CommunicationInterfaceLocal::send_flag_to_agents(const std::vector<int>& agent_ids) const
+    {
+        // prepare data
+        const auto data = ProtocolCommunication::buildProtocol_send_flagToAgents();
+
+        // send flag to each agent
+        for (unsigned int k = 0; k < agent_ids.size(); ++k)
+        {
+            const auto comm_data = get_communicationData(agent_ids[k]);
+
+            // check if agent is known
+            if (comm_data == nullptr)
+                log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::send_flag_to_agents] "
+                << "Agent with id " << agent_ids[k] << " not found." << std::endl;
+            else
+                async_send(comm_data, data);
+        }      
+    }
+
+    void CommunicationInterfaceLocal::async_send(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data) const
+    {
+        if (comm_data == nullptr)
+            return;
+
+        if (!comm_data->is_connected_)
+            return;
+
+        if (comm_data->link_ != nullptr && comm_data->link_ == link_loopback_)
+        {
+            deliver_loopback(comm_data, data);
+            return;
+        }
+
+        const auto& link = get_connection(comm_data);
+        if (!link->is_connected_)
+            return;
+
+        // as everything is ok, queue the data
+        std::lock_guard<std::mutex> guard(link->mutex_buffer_send_);
+
+        if (comm_data != link)
+            queue_channelHeader(comm_data, static_cast<unsigned int>(data->size()));
+
+        link->buffer_send_.buffers_.push_back(data);
+        link->buffer_send_.views_.push_back(asio::buffer(*data));
+
+        request_write(link);
+    }
+
+    void CommunicationInterfaceLocal::queue_channelHeader(const CommunicationDataPtr& channel, const unsigned int size_of_message) const
+    {
+        const auto header = ProtocolCommunication::buildProtocol_channelHeader(channel->local_id_, channel->remote_id_, size_of_message);
+
+        channel->link_->buffer_send_.buffers_.push_back(header);
+        channel->link_->buffer_send_.views_.push_back(asio::buffer(*header));
+    }
+
+    void CommunicationInterfaceLocal::deliver_loopback(const CommunicationDataPtr& channel, const std::shared_ptr< std::vector<char> >& data) const
+    {
+        // the message is received over the channel in the opposite direction
+        const auto channel_receiver = find_channel(link_loopback_, channel->remote_id_, channel->local_id_);
+        if (channel_receiver == nullptr)
+            return;
+
+        // the message is evaluated as if it was received over a socket
+        auto communication_interface = const_cast<CommunicationInterfaceLocal*>(this);
+        asio::post([channel_receiver, communication_interface, data]()
+            { ProtocolCommunication::evaluateData(channel_receiver, communication_interface, *data); });
+    }
+
+    void CommunicationInterfaceLocal::start_write(const CommunicationDataPtr& comm_data) const
+    {
+        // the messages up to the switch to shared memory are written separately
+        if (!comm_data->buffer_switch_.views_.empty())
+        {
+            std::swap(comm_data->buffer_writing_, comm_data->buffer_switch_);
+            comm_data->is_switching_ = true;
+        }
+        // all queued messages are coalesced into one write
+        else
+            std::swap(comm_data->buffer_writing_, comm_data->buffer_send_);
+        comm_data->is_writing_ = true;
+
+        if (comm_data->is_sendingSharedMemory_)
+        {
+            // the ring buffer may be full, so do not block the caller
+            const auto channel = comm_data->shared_memory_;
+            asio::post(comm_data->socket_.get_executor(), [this, comm_data, channel]()
+            {
+                // the written batch is not modified until the write completed
+                std::size_t bytes_transferred = 0;
+                for (const auto& view : comm_data->buffer_writing_.views_)
+                {
+                    if (!channel->write(static_cast<const char*>(view.data()), view.size()))
+                    {
+                        writeHandler(std::make_error_code(std::errc::broken_pipe), bytes_transferred, comm_data);
+                        return;
+                    }
+                    bytes_transferred += view.size();
+                }
+
+                writeHandler(std::error_code(), bytes_transferred, comm_data);
+            });
+            return;
+        }
+
+        std::shared_lock<std::shared_mutex> guard_socket(comm_data->mutex_socket_);
+        asio::async_write(comm_data->socket_, comm_data->buffer_writing_.views_,
+            comm_data->strand_.wrap(std::bind(&CommunicationInterfaceLocal::writeHandler,
+                this, std::placeholders::_1, std::placeholders::_2, comm_data)));
+    }
+
+    void CommunicationInterfaceLocal::request_write(const CommunicationDataPtr& comm_data) const
+    {
+        if (comm_data->is_writing_)
+            return;
+
+        if (!is_batching_)
+        {
+            start_write(comm_data);
+            return;
+        }
+
+        if (!comm_data->is_batched_)
+        {
+            comm_data->is_batched_ = true;
+            batch_.push_back(comm_data);
+        }
+    }
+
+    void CommunicationInterfaceLocal::start_batch() const
+    {
+        is_batching_ = true;
+    }
+
+    void CommunicationInterfaceLocal::write_batch() const
+    {
+        is_batching_ = false;
+        std::vector<CommunicationDataPtr> batch;
+        batch.swap(batch_);
+
+        // the writes are started back to back, such that they are submitted together
+        for (const auto& comm_data : batch)
+        {
+            std::lock_guard<std::mutex> guard(comm_data->mutex_buffer_send_);
+            comm_data->is_batched_ = false;
+
+            if (!comm_data->is_writing_ && (!comm_data->buffer_send_.views_.empty() || !comm_data->buffer_switch_.views_.empty()))
+                start_write(comm_data);
+        }
+    }
+
+    void CommunicationInterfaceLocal::send_compressed(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data) const
+    {
+        if (comm_data == nullptr)
+            return;
+
+        if (!comm_data->is_connected_)
+            return;
+
+        // agents of this process do not benefit from compression
+        if (comm_data->link_ != nullptr && comm_data->link_ == link_loopback_)
+        {
+            deliver_loopback(comm_data, data);
+            return;
+        }
+
+        const auto& link = get_connection(comm_data);
+        if (!link->is_connected_)
+            return;
+
+        std::lock_guard<std::mutex> guard(link->mutex_buffer_send_);
+
+        // the reference is chosen while queuing, as the messages are received in this order
+        const char index = (*data)[position_of_index_in_protocol_];
+        auto& reference = comm_data->last_sent_messages_[index];
+        const auto compressed_data = ProtocolCommunication::buildProtocol_compressedMessage(*data, is_deltaEncoding_ ? reference : nullptr);
+        reference = data;
+
+        if (comm_data != link)
+            queue_channelHeader(comm_data, static_cast<unsigned int>(compressed_data->size()));
+
+        link->buffer_send_.buffers_.push_back(compressed_data);
+        link->buffer_send_.views_.push_back(asio::buffer(*compressed_data));
+
+        request_write(link);
+    }
+
+    const bool CommunicationInterfaceLocal::is_compressing() const
+    {
+        return is_deltaEncoding_ || quantization_mantissa_bits_ > 0;
+    }
+
+    void CommunicationInterfaceLocal::quantize(std::vector<typeRNum>& trajectory) const
+    {
+        if (quantization_mantissa_bits_ > 0)
+            DataConversion::quantize(trajectory, quantization_mantissa_bits_, quantization_tolerance_);
+    }
+
+    void CommunicationInterfaceLocal::dispatch_data(const CommunicationDataPtr& comm_data, std::shared_ptr< std::vector<char> > data)
+    {
+        const auto index_of_data = static_cast<index>((*data)[position_of_index_in_protocol_]);
+
+        // the transport is switched in the order of receipt
+        if (index_of_data == index::offer_sharedMemory || index_of_data == index::accept_sharedMemory
+            || index_of_data == index::switch_to_sharedMemory)
+        {
+            handle_sharedMemory(comm_data, *data);
+            return;
+        }
+
+        // messages of a channel are evaluated in the context of the channel
+        if (index_of_data == index::channelMessage)
+        {
+            std::shared_ptr< std::vector<char> > message;
+            if (data->size() >= size_of_channelHeader_ + first_element_with_data_)
+                message = ProtocolCommunication::buildFromProtocol_message_from_channelMessage(*data);
+
+            unsigned int size_of_message = 0;
+            unsigned int pos = 0;
+            if (message != nullptr)
+                DataConversion::read_from_charArray(*message, pos, size_of_message);
+
+            if (message == nullptr || size_of_message != message->size())
+            {
+                log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::dispatch_data] "
+                    << "Received invalid message of a channel." << std::endl;
+                return;
+            }
+
+            const int from = ProtocolCommunication::buildFromProtocol_from_channelMessage(*data);
+            const int to = ProtocolCommunication::buildFromProtocol_to_channelMessage(*data);
+
+            // a closed channel is not accepted again
+            const auto channel = static_cast<index>((*message)[position_of_index_in_protocol_]) == index::close_channel ?
+                find_channel(comm_data, to, from) : accept_channel(comm_data, from, to);
+            if (channel != nullptr)
+                dispatch_data(channel, message);
+            return;
+        }
+
+        // compressed messages are decoded in the order of receipt, as they may refer to the previous message
+        if (index_of_data == index::compressedMessage)
+        {
+            auto& reference = comm_data->last_received_messages_[ProtocolCommunication::buildFromProtocol_index_from_compressedMessage(*data)];
+            data = ProtocolCommunication::buildFromProtocol_compressedMessage(*data, reference);
+
+            if (data == nullptr)
+            {
+                log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::dispatch_data] "
+                    << "Failed to decode compressed message." << std::endl;
+                return;
+            }
+
+            reference = data;
+        }
+
+        // evaluate data asynchronously
+        asio::post([comm_data, this, data]() { ProtocolCommunication::evaluateData(comm_data, this, *data); });
+    }
+
+    void CommunicationInterfaceLocal::offer_sharedMemory(const CommunicationDataPtr& comm_data) const
+    {
+        asio::error_code ec_local;
+        asio::error_code ec_remote;
+        std::shared_lock<std::shared_mutex> guard_socket(comm_data->mutex_socket_);
+        const auto local_endpoint = comm_data->socket_.local_endpoint(ec_local);
+        const auto remote_endpoint = comm_data->socket_.remote_endpoint(ec_remote);
+        guard_socket.unlock();
+
+        // shared memory requires that both endpoints are on the same machine
+        if (ec_local || ec_remote)
+            return;
+        if (!remote_endpoint.address().is_loopback() && remote_endpoint.address() != local_endpoint.address())
+            return;
+
+        const auto channel = SharedMemoryChannel::create(log_);
+        if (channel == nullptr)
+            return;
+
+        std::unique_lock<std::mutex> guard(comm_data->mutex_buffer_send_);
+        comm_data->shared_memory_ = channel;
+        guard.unlock();
+
+        async_send(comm_data, ProtocolCommunication::buildProtocol_offer_sharedMemory(channel->get_name()));
+    }
+
+    void CommunicationInterfaceLocal::handle_sharedMemory(const CommunicationDataPtr& comm_data, const std::vector<char>& data)
+    {
+        const auto index_of_data = static_cast<index>(data[position_of_index_in_protocol_]);
+
+        // the connected host offers shared memory
+        if (index_of_data == index::offer_sharedMemory)
+        {
+            const auto channel = SharedMemoryChannel::open(log_, ProtocolCommunication::buildFromProtocol_name_from_offer_sharedMemory(data));
+            if (channel == nullptr)
+            {
+                async_send(comm_data, ProtocolCommunication::buildProtocol_accept_sharedMemory(false));
+                return;
+            }
+
+            std::unique_lock<std::mutex> guard(comm_data->mutex_buffer_send_);
+            comm_data->shared_memory_ = channel;
+            guard.unlock();
+
+            // the acceptance is the last message that is sent over the socket
+            switch_to_sharedMemory(comm_data, ProtocolCommunication::buildProtocol_accept_sharedMemory(true));
+            return;
+        }
+
+        std::unique_lock<std::mutex> guard(comm_data->mutex_buffer_send_);
+        const auto channel = comm_data->shared_memory_;
+        guard.unlock();
+
+        if (channel == nullptr)
+        {
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::handle_sharedMemory] "
+                << "Received message regarding shared memory, but shared memory is not offered." << std::endl;
+            return;
+        }
+
+        // the connected host answered the offer
+        if (index_of_data == index::accept_sharedMemory)
+        {
+            channel->unlink();
+
+            if (!ProtocolCommunication::buildFromProtocol_accepted_from_accept_sharedMemory(data))
+            {
+                guard.lock();
+                comm_data->shared_memory_ = nullptr;
+                guard.unlock();
+
+                log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handle_sharedMemory] "
+                    << "Connected host declined shared memory." << std::endl;
+                return;
+            }
+
+            // all following messages of the connected host are sent over shared memory
+            start_reading_sharedMemory(comm_data);
+            switch_to_sharedMemory(comm_data, ProtocolCommunication::buildProtocol_switch_to_sharedMemory());
+
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::handle_sharedMemory] "
+                << "Switched connection to shared memory." << std::endl;
+        }
+        // the connected host switched to shared memory
+        else if (index_of_data == index::switch_to_sharedMemory)
+            start_reading_sharedMemory(comm_data);
     }
 
-    void CommunicationInterfaceLocal::reset_solution(unsigned int agent_id)
+    void CommunicationInterfaceLocal::switch_to_sharedMemory(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data) const
     {
-        if (agent_->get_id() == agent_id)
-            agent_->reset_solution();
-        else
-            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::reset_solution] "
-            << "Agent " << agent_id << " not found." << std::endl;
+        if (!comm_data->is_connected_)
+            return;
+
+        std::lock_guard<std::mutex> guard(comm_data->mutex_buffer_send_);
+
+        // the queued messages and the switch are written to the socket before anything is written to shared memory
+        comm_data->buffer_switch_ = std::move(comm_data->buffer_send_);
+        comm_data->buffer_send_ = WriteBatch();
+        comm_data->buffer_switch_.buffers_.push_back(data);
+        comm_data->buffer_switch_.views_.push_back(asio::buffer(*data));
+
+        if (!comm_data->is_writing_)
+            start_write(comm_data);
     }
 
-    void CommunicationInterfaceLocal::reset_solution(const std::string& agents)
+    void CommunicationInterfaceLocal::start_reading_sharedMemory(const CommunicationDataPtr& comm_data)
     {
-        if (agents == "all")
-            agent_->reset_solution();
-        else
-            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::reset_solution] "
-            << "Set of agents not known." << std::endl;
+        std::lock_guard<std::mutex> guard(comm_data->mutex_buffer_send_);
+
+        if (comm_data->shared_memory_ == nullptr || comm_data->thread_sharedMemory_.joinable())
+            return;
+
+        comm_data->thread_sharedMemory_ = std::thread(&CommunicationInterfaceLocal::read_sharedMemory, this,
+            std::weak_ptr<CommunicationData>(comm_data), comm_data->shared_memory_);
     }
 
-    void CommunicationInterfaceLocal::send_flag_to_agents(const std::string& agents) const
+    void CommunicationInterfaceLocal::read_sharedMemory(const std::weak_ptr<CommunicationData>& weak_comm_data, const SharedMemoryChannelPtr& channel)
     {
-        if (agents == "all")
+        std::vector<char> size_of_message(sizeof(int), 0);
+
+        // messages are received in order, as with the socket
+        while (channel->read(size_of_message.data(), size_of_message.size()))
         {
-            std::shared_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
-            const auto data = ProtocolCommunication::buildProtocol_send_flagToAgents();
+            unsigned int size_of_data = 0;
+            unsigned int pos = 0;
+            DataConversion::read_from_charArray(size_of_message, pos, size_of_data);
 
-            for (const auto& comm_data : comm_data_vec_)
-                async_send(comm_data, data);
+            if (size_of_data < static_cast<unsigned int>(first_element_with_data_))
+            {
+                log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::read_sharedMemory] "
+                    << "Received message with invalid size " << size_of_data << "." << std::endl;
 
-            return;
+                channel->close();
+                return;
+            }
+
+            std::shared_ptr<std::vector<char>> data(new std::vector<char>(size_of_data, 0));
+            std::copy(size_of_message.begin(), size_of_message.end(), data->begin());
+            if (!channel->read(data->data() + size_of_message.size(), size_of_data - size_of_message.size()))
+                return;
+
+            const auto comm_data = weak_comm_data.lock();
+            if (comm_data == nullptr)
+                return;
+
+            comm_data->time_last_received_ = std::chrono::steady_clock::now();
+            dispatch_data(comm_data, data);
         }
+    }
 
-        log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::send_flag_to_agents] "
-            << "Unknown set of agents '" << agents << "'." << std::endl;
+    void CommunicationInterfaceLocal::close_sharedMemory(const CommunicationDataPtr& comm_data) const
+    {
+        std::unique_lock<std::mutex> guard(comm_data->mutex_buffer_send_);
+        const auto channel = comm_data->shared_memory_;
+        auto thread = std::move(comm_data->thread_sharedMemory_);
+        comm_data->shared_memory_ = nullptr;
+        comm_data->is_sendingSharedMemory_ = false;
+        guard.unlock();
+
+        if (channel != nullptr)
+            channel->close();
+
+        if (thread.joinable())
+            thread.join();
     }
 
-    void CommunicationInterfaceLocal::send_flag_to_agents(const int agent_id) const
+    void CommunicationInterfaceLocal::configure_multicast(const OptimizationInfo& info, const int id)
     {
-        const auto comm_data = get_communicationData(agent_id);
+        std::unique_lock<std::mutex> guard(mutex_multicast_);
 
-        // check if agent is known
-        if (comm_data == nullptr)
+        // close the channel if multicast is deactivated or other groups are used
+        if (multicast_ != nullptr
+            && (!info.COMM_Multicast_ || !multicast_->is_using(info.COMM_MulticastAddress_, static_cast<unsigned short>(info.COMM_MulticastPort_))))
         {
-            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::send_flag_to_agents] "
-                << "Agent with id " << agent_id << " not found." << std::endl;
+            multicast_->close();
+            multicast_ = nullptr;
+        }
+
+        if (!info.COMM_Multicast_)
+            return;
+
+        if (multicast_ != nullptr)
+        {
+            // the channel of the first agent receives the messages of all agents of this process
+            if (comm_info_local_.agent_type_ == "agent")
+                multicast_->add_receiver(id);
             return;
         }
 
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_flagToAgents());    
-    }
+        const auto channel = std::make_shared<MulticastChannel>(log_, ioService_, id,
+            [this](const int sender, const int receiver, const std::shared_ptr< std::vector<char> >& message)
+            { receive_multicast(sender, receiver, message); });
 
-    void CommunicationInterfaceLocal::send_flag_to_agents(const std::vector<int>& agent_ids) const
-    {
-        // prepare data
-        const auto data = ProtocolCommunication::buildProtocol_send_flagToAgents();
+        // messages are sent via TCP, if the channel can not be opened
+        if (!channel->open(info.COMM_MulticastAddress_, static_cast<unsigned short>(info.COMM_MulticastPort_)))
+            return;
 
-        // send flag to each agent
-        for (unsigned int k = 0; k < agent_ids.size(); ++k)
-        {
-            const auto comm_data = get_communicationData(agent_ids[k]);
+        multicast_ = channel;
+        guard.unlock();
 
-            // check if agent is known
-            if (comm_data == nullptr)
-                log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::send_flag_to_agents] "
-                << "Agent with id " << agent_ids[k] << " not found." << std::endl;
-            else
-                async_send(comm_data, data);
-        }      
+        // agents receive the coordinator and all connected neighbors
+        if (comm_info_local_.agent_type_ != "agent")
+            return;
+
+        join_multicastGroup(-1);
+
+        std::shared_lock<std::shared_mutex> guard_comm_data_vec(mutex_comm_data_vec_);
+        for (const auto& comm_data : comm_data_vec_)
+            if (comm_data->communication_info_->agent_type_ == "agent")
+                join_multicastGroup(comm_data->communication_info_->id_);
     }
 
-    void CommunicationInterfaceLocal::async_send(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<char> >& data) const
+    const MulticastChannelPtr CommunicationInterfaceLocal::get_multicastChannel() const
     {
-        if (comm_data == nullptr)
-            return;
+        std::lock_guard<std::mutex> guard(mutex_multicast_);
+        return multicast_;
+    }
 
-        if (!comm_data->is_connected_)
-            return;
+    void CommunicationInterfaceLocal::join_multicastGroup(const int id) const
+    {
+        const auto multicast = get_multicastChannel();
+        if (multicast != nullptr)
+            multicast->join(id);
+    }
 
-        // as everything is ok, send the data
-        std::unique_lock<std::mutex> guard(comm_data->mutex_buffer_send_);
+    void CommunicationInterfaceLocal::receive_multicast(const int sender, const int receiver, const std::shared_ptr< std::vector<char> >& message)
+    {
+        // the message is evaluated as if it was received via the channel between the sender and the receiver
+        const auto comm_data_sender = sender < 0 ? get_communicationData(receiver, "coordinator") : get_communicationData(receiver, sender);
 
-        comm_data->buffer_send_.push_back(data);
-        comm_data->socket_.async_write_some(asio::buffer(*comm_data->buffer_send_.back()),
-            comm_data->strand_.wrap(std::bind(&CommunicationInterfaceLocal::writeHandler,
-                this, std::placeholders::_1, std::placeholders::_2,
-                comm_data, comm_data->buffer_send_.back())));
+        if (comm_data_sender != nullptr && comm_data_sender->is_connected_)
+        {
+            get_connection(comm_data_sender)->time_last_received_ = std::chrono::steady_clock::now();
+            dispatch_data(comm_data_sender, message);
+        }
     }
 
     void CommunicationInterfaceLocal::async_connect(const CommunicationDataPtr& comm_data)
@@ -1404,21 +2872,36 @@ namespace grampcd
 
         std::shared_lock<std::shared_mutex> guard_socket(comm_data->mutex_socket_);
 
-        comm_data->socket_.async_read_some(asio::buffer(comm_data->buffer_read_),
+        // read into the free part of the buffer or directly into a large message
+        const auto buffer = comm_data->message_read_ != nullptr ?
+            asio::buffer(comm_data->message_read_->data() + comm_data->size_message_read_,
+                comm_data->message_read_->size() - comm_data->size_message_read_) :
+            asio::buffer(comm_data->buffer_read_.data() + comm_data->end_read_,
+                comm_data->buffer_read_.size() - comm_data->end_read_);
+
+        comm_data->socket_.async_read_some(buffer,
             comm_data->strand_.wrap(std::bind(&CommunicationInterfaceLocal::readHandler,
                 this, std::placeholders::_1, std::placeholders::_2, comm_data)));
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_communicationInfo(const CommunicationDataPtr& comm_data, const CommunicationInfoPtr& info)
     {
-        log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::fromCommunication_send_communicationInfo] "
-            << "Accepted connection to agent with id " << info->id_ << "." << std::endl;
+        if (info->agent_type_ == "sub_coordinator")
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::fromCommunication_send_communicationInfo] "
+                << "Accepted connection to sub-coordinator." << std::endl;
+        else
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::fromCommunication_send_communicationInfo] "
+                << "Accepted connection to agent with id " << info->id_ << "." << std::endl;
 
         comm_data->communication_info_ = info;
 
         std::unique_lock<std::shared_mutex> guard(mutex_comm_data_vec_);
         if(!DataConversion::is_element_in_vector(comm_data_vec_, comm_data))
             comm_data_vec_.push_back(comm_data);
+        guard.unlock();
+
+        if (info->agent_type_ == "agent")
+            join_multicastGroup(info->id_);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_flagToAgents(const CommunicationDataPtr& comm_data) const
@@ -1431,10 +2914,29 @@ namespace grampcd
         async_send(comm_data, ProtocolCommunication::buildProtocol_send_ping());
     }
 
+    void CommunicationInterfaceLocal::fromCommunication_send_wireFormat(const CommunicationDataPtr& comm_data, const unsigned int version,
+        const unsigned int size_of_typeRNum, const bool little_endian)
+    {
+        if (version != wire_format_version_ || size_of_typeRNum != sizeof(typeRNum))
+        {
+            log_->print(DebugType::Error) << "[CommunicationInterfaceLocal::fromCommunication_send_wireFormat] "
+                << "Connected host uses wire format version " << version << " with typeRNums of " << size_of_typeRNum
+                << " bytes, but version " << wire_format_version_ << " with " << sizeof(typeRNum)
+                << " bytes is required. Connection is closed." << std::endl;
+
+            handle_disconnect(comm_data);
+            return;
+        }
+
+        // the byte order on the wire is fixed, hence a host with a different byte order requires no further handling
+        if (little_endian != DataConversion::is_littleEndian())
+            log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::fromCommunication_send_wireFormat] "
+                << "Connected host uses a different byte order." << std::endl;
+    }
+
     void CommunicationInterfaceLocal::fromCommunication_send_ping(const CommunicationDataPtr& comm_data) const
     {
-        // reset timer
-        comm_data->timer_check_connection_.cancel();
+        // the reception of any message already counts as sign of life
     }
 
     void CommunicationInterfaceLocal::fromCommunication_get_numberOfActiveCouplings(const CommunicationDataPtr& comm_data) const
@@ -1442,10 +2944,29 @@ namespace grampcd
         std::shared_lock<std::shared_mutex> guard(mutex_infos_);
         int number = 0;
 
-        // count number of couplings with an open connection
+        // a sub-coordinator counts the agents of its partition with an open connection
+        if (comm_info_local_.agent_type_ == "sub_coordinator")
+        {
+            for (const int agent_id : partition_)
+            {
+                const auto comm_data_search = get_communicationData(agent_id);
+
+                if (comm_data_search != nullptr)
+                    if (comm_data_search->is_connected_)
+                        ++number;
+            }
+
+            async_send(comm_data, ProtocolCommunication::buildProtocol_send_numberOfActiveCouplings( number ));
+            return;
+        }
+
+        // count number of couplings of the agent with an open connection
         for(const auto& info : coupling_infos_active_)
         {
-            const auto comm_data_search = get_communicationData(info.neighbor_id_);
+            if (info.agent_id_ != comm_data->local_id_)
+                continue;
+
+            const auto comm_data_search = get_communicationData(comm_data->local_id_, info.neighbor_id_);
 
             if (comm_data_search != nullptr)
                 if (comm_data_search->is_connected_)
@@ -1465,21 +2986,34 @@ namespace grampcd
 
     void CommunicationInterfaceLocal::fromCommunication_send_couplingState(const CommunicationDataPtr& comm_data, const grampcd::CouplingStatePtr& state, int from)
     {
-        std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->fromCommunication_received_couplingState(*state, from);
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(local_agent->mutex_);
+        local_agent->agent_->fromCommunication_received_couplingState(*state, from);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_couplingState(const CommunicationDataPtr& comm_data, 
         const grampcd::CouplingStatePtr& state1, const grampcd::CouplingStatePtr& state2, int from)
     {
-        std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->fromCommunication_received_couplingState(*state1, *state2, from);
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(local_agent->mutex_);
+        local_agent->agent_->fromCommunication_received_couplingState(*state1, *state2, from);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_get_desiredAgentStateFromAgent(const CommunicationDataPtr& comm_data) const
     {
-        // if mutex_basics_ is used here, there is a deadlock if neighbor approximation is used
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_desiredAgentState(agent_->get_desiredAgentState(), agent_->get_id()));
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        // if the mutex of the agent is used here, there is a deadlock if neighbor approximation is used
+        const auto& agent = local_agent->agent_;
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_desiredAgentState(agent->get_desiredAgentState(), agent->get_id()));
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_simulatedState
@@ -1491,9 +3025,15 @@ namespace grampcd
         typeRNum cost
     )
     {
-        std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->set_updatedState(*x_next, dt, t0, cost);
-        async_send(get_communicationData("coordinator"), ProtocolCommunication::buildProtocol_acknowledge_executed_ADMMstep());
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::unique_lock<std::mutex> guard(local_agent->mutex_);
+        local_agent->agent_->set_updatedState(*x_next, dt, t0, cost);
+        guard.unlock();
+
+        async_send(comm_data, ProtocolCommunication::buildProtocol_acknowledge_executed_ADMMstep());
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_couplingModel(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::map<int, grampcd::CouplingModelPtr> >& model) const
@@ -1506,8 +3046,13 @@ namespace grampcd
 
     void CommunicationInterfaceLocal::fromCommunication_get_couplingModelFromAgent(const CommunicationDataPtr& comm_data) const
     {
-        std::shared_lock<std::shared_mutex> guard(mutex_basics_);
-        async_send(get_communicationData("coordinator"), ProtocolCommunication::buildProtocol_send_couplingModel(*agent_->get_couplingModels(), agent_->get_id()));
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(local_agent->mutex_);
+        const auto& agent = local_agent->agent_;
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_couplingModel(*agent->get_couplingModels(), agent->get_id()));
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_agentModel(const CommunicationDataPtr& comm_data, const grampcd::AgentModelPtr& model) const
@@ -1520,14 +3065,24 @@ namespace grampcd
 
     void CommunicationInterfaceLocal::fromCommunication_get_agentModelFromAgent(const CommunicationDataPtr& comm_data) const
     {
-        std::shared_lock<std::shared_mutex> guard(mutex_basics_);
-        async_send(get_communicationData("coordinator"), ProtocolCommunication::buildProtocol_send_agentModel(agent_->get_agentModel(), agent_->get_id()));
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(local_agent->mutex_);
+        const auto& agent = local_agent->agent_;
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_agentModel(agent->get_agentModel(), agent->get_id()));
     }
 
     void CommunicationInterfaceLocal::fromCommunication_get_agentState_for_simulation(const CommunicationDataPtr& comm_data) const
     {
-        // if mutex_basics_ is used here, there is a deadlock if neighbor approximation is used
-        async_send( comm_data, ProtocolCommunication::buildProtocol_send_agentState_for_simulation( agent_->get_agentState(), agent_->get_id() ) );
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        // if the mutex of the agent is used here, there is a deadlock if neighbor approximation is used
+        const auto& agent = local_agent->agent_;
+        async_send( comm_data, ProtocolCommunication::buildProtocol_send_agentState_for_simulation( agent->get_agentState(), agent->get_id() ) );
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_agentState_for_simulation(const CommunicationDataPtr& comm_data, const AgentStatePtr& state) const
@@ -1540,19 +3095,32 @@ namespace grampcd
 
     void CommunicationInterfaceLocal::fromCommunication_send_convergenceFlag(const CommunicationDataPtr& comm_data, bool converged, int from)
     {
-        std::unique_lock<std::shared_mutex> guard_coordinator(mutex_coordinator_);
-        coordinator_->fromCommunication_received_convergenceFlag(converged, from);
+        // a sub-coordinator aggregates the flags of its partition
+        if (comm_info_local_.agent_type_ == "sub_coordinator")
+        {
+            std::unique_lock<std::mutex> guard_trigger(mutex_triggerStep_);
+            if (register_acknowledgement(comm_data))
+                partition_converged_ = partition_converged_ && converged;
+            return;
+        }
 
+        std::unique_lock<std::shared_mutex> guard_coordinator(mutex_coordinator_);
         std::unique_lock<std::mutex> guard_trigger(mutex_triggerStep_);
-        --numberOfNotifications_triggerStep_;
-        conditionVariable_triggerStep_.notify_one();
+
+        // flags of a step that already passed its deadline are outdated
+        if (register_acknowledgement(comm_data))
+            coordinator_->fromCommunication_received_convergenceFlag(converged, from);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_multiplierPenaltyState(const CommunicationDataPtr& comm_data, 
         const grampcd::MultiplierStatePtr& multiplier, const grampcd::PenaltyStatePtr& penalty, const int from)
     {
-        std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->fromCommunication_received_multiplierState(*multiplier, *penalty, from);
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(local_agent->mutex_);
+        local_agent->agent_->fromCommunication_received_multiplierState(*multiplier, *penalty, from);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_desiredAgentState(const CommunicationDataPtr& comm_data, const grampcd::AgentStatePtr& state) const
@@ -1565,14 +3133,22 @@ namespace grampcd
 
     void CommunicationInterfaceLocal::fromCommunication_send_agentState(const CommunicationDataPtr& comm_data, const grampcd::AgentStatePtr& state, int from)
     {
-        std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->fromCommunication_received_agentState(*state, from);
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(local_agent->mutex_);
+        local_agent->agent_->fromCommunication_received_agentState(*state, from);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_numberOfNeighbors(const CommunicationDataPtr& comm_data, int number, int from)
     {
-        std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->fromCommunication_received_numberOfNeighbors(number, from);
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(local_agent->mutex_);
+        local_agent->agent_->fromCommunication_received_numberOfNeighbors(number, from);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_deregister_coupling(const CommunicationDataPtr& comm_data, const CouplingInfoPtr& info)
@@ -1603,8 +3179,20 @@ namespace grampcd
 
     void CommunicationInterfaceLocal::fromCommunication_get_solution(const CommunicationDataPtr& comm_data) const
     {
-        std::shared_lock<std::shared_mutex> guard(mutex_basics_);
-        async_send(comm_data, ProtocolCommunication::buildProtocol_send_solution(agent_->get_solution()));
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_solution(local_agent->agent_->get_solution()));
+    }
+
+    void CommunicationInterfaceLocal::fromCommunication_get_solution_since(const CommunicationDataPtr& comm_data, const unsigned int index) const
+    {
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_solution(local_agent->agent_->get_solution_since(index)));
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_solution(const CommunicationDataPtr& comm_data, const SolutionPtr& solution) const
@@ -1618,8 +3206,7 @@ namespace grampcd
     void CommunicationInterfaceLocal::fromCommunication_received_acknowledgement_executed_ADMMstep(const CommunicationDataPtr& comm_data) const
     {
         std::unique_lock<std::mutex> guard(mutex_triggerStep_);
-        --numberOfNotifications_triggerStep_;
-        conditionVariable_triggerStep_.notify_one();
+        register_acknowledgement(comm_data);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_received_acknowledgement_received_optimizationInfo(const CommunicationDataPtr& comm_data) const
@@ -1630,42 +3217,164 @@ namespace grampcd
         conditionVariable_config_optimizationInfo_.notify_one();
     }
 
-    void CommunicationInterfaceLocal::fromCommunication_triggerStep(ADMMStep step)
+    void CommunicationInterfaceLocal::fromCommunication_triggerStep(const CommunicationDataPtr& comm_data, ADMMStep step, const unsigned int step_timeout_ms)
     {
-        std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->fromCommunication_trigger_step(step);
+        if (comm_info_local_.agent_type_ == "sub_coordinator")
+        {
+            forward_step(comm_data, step, step_timeout_ms);
+            return;
+        }
+
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
+        // agents of this process execute their steps in parallel
+        std::unique_lock<std::mutex> guard(local_agent->mutex_);
+
+        // the messages to all neighbors and the acknowledgement are written together after the step
+        start_batch();
+
+        // acknowledge to the node that triggered the step, which is either the coordinator or a sub-coordinator
+        local_agent->comm_data_triggerStep_ = comm_data;
+        local_agent->agent_->fromCommunication_trigger_step(step);
+        guard.unlock();
 
         if(step != ADMMStep::SEND_CONVERGENCE_FLAG)
-            async_send(get_communicationData("coordinator"), ProtocolCommunication::buildProtocol_acknowledge_executed_ADMMstep());
+            async_send(comm_data, ProtocolCommunication::buildProtocol_acknowledge_executed_ADMMstep());
+
+        write_batch();
+    }
+
+    void CommunicationInterfaceLocal::forward_step(const CommunicationDataPtr& comm_data_coordinator, const ADMMStep& step, const unsigned int step_timeout_ms)
+    {
+        const auto data = ProtocolCommunication::buildProtocol_triggerStep(step, 0);
+
+        // send trigger to each agent of the partition
+        std::shared_lock<std::shared_mutex> guard_commDataVec(mutex_comm_data_vec_);
+        std::unique_lock<std::mutex> guard_triggerStep(mutex_triggerStep_);
+        numberOfNotifications_triggerStep_ = 0;
+        ++phase_triggerStep_;
+        partition_converged_ = true;
+        int number_of_excluded_agents = 0;
+
+        for (const auto& comm_data : comm_data_vec_)
+        {
+            if (comm_data->is_connected_ && comm_data->communication_info_->agent_type_ == "agent")
+            {
+                if (comm_data->number_of_pending_acknowledgements_ > 0)
+                    ++number_of_excluded_agents;
+                else
+                    send_with_acknowledgement(comm_data, data);
+            }
+        }
+        guard_commDataVec.unlock();
+
+        // wait for response until the deadline that is sent by the coordinator
+        const auto step_timeout = step_timeout_ms > 0 ? std::chrono::milliseconds(step_timeout_ms) : step_timeout_;
+        conditionVariable_triggerStep_.wait_for(guard_triggerStep, step_timeout,
+            [this] {return numberOfNotifications_triggerStep_ == 0; });
+
+        const int number_of_late_agents = numberOfNotifications_triggerStep_ + number_of_excluded_agents;
+        if (number_of_late_agents != 0)
+        {
+            log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::forward_step] "
+                << number_of_late_agents << " agents of the partition did not execute triggered step "
+                << DataConversion::ADMMStep_to_int(step) << " in time." << std::endl;
+
+            // a partition with missing flags is not converged
+            partition_converged_ = false;
+        }
+
+        // report a single acknowledgement or convergence flag for the whole partition
+        if (step == ADMMStep::SEND_CONVERGENCE_FLAG)
+            async_send(comm_data_coordinator, ProtocolCommunication::buildProtocol_send_convergenceFlag(partition_converged_, comm_info_local_.id_));
+        else
+            async_send(comm_data_coordinator, ProtocolCommunication::buildProtocol_acknowledge_executed_ADMMstep());
+    }
+
+    void CommunicationInterfaceLocal::fromCommunication_assign_partition(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<int> >& agent_ids)
+    {
+        std::unique_lock<std::shared_mutex> guard(mutex_infos_);
+        partition_ = *agent_ids;
+
+        log_->print(DebugType::Message) << "[CommunicationInterfaceLocal::fromCommunication_assign_partition] "
+            << "Partition with " << partition_.size() << " agents assigned." << std::endl;
+    }
+
+    void CommunicationInterfaceLocal::fromCommunication_send_subCoordinatorInfo(const CommunicationDataPtr& comm_data, const CommunicationInfoPtr& info)
+    {
+        // close the channel to a previous sub-coordinator
+        const auto comm_data_previous = get_communicationData(comm_data->local_id_, "sub_coordinator");
+        if (comm_data_previous != nullptr && comm_data_previous->is_connected_)
+            handle_disconnect(comm_data_previous);
+
+        // open a channel to the sub-coordinator
+        const auto channel = create_channel(get_link(info->ip_, info->port_), comm_data->local_id_, -1, info);
+        open_channel(channel);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_send_optimizationInfo(const CommunicationDataPtr& comm_data, const OptimizationInfoPtr& optimization_info)
     {
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
         std::unique_lock<std::shared_mutex> guard(mutex_basics_);
-        agent_->fromCommunication_configured_optimization(*optimization_info);
-        async_send(get_communicationData("coordinator"), ProtocolCommunication::buildProtocol_acknowledge_received_optimizationInfo());
+
+        // configure the encoding of sent states
+        is_deltaEncoding_ = optimization_info->COMM_DeltaEncoding_;
+        quantization_tolerance_ = optimization_info->COMM_QuantizationTolerance_;
+        if (optimization_info->COMM_Quantization_ == "float32")
+            quantization_mantissa_bits_ = 23;
+        else if (optimization_info->COMM_Quantization_ == "float16")
+            quantization_mantissa_bits_ = 10;
+        else
+        {
+            if (optimization_info->COMM_Quantization_ != "none")
+                log_->print(DebugType::Warning) << "[CommunicationInterfaceLocal::fromCommunication_send_optimizationInfo] "
+                    << "Unknown quantization " << optimization_info->COMM_Quantization_ << ", trajectories are sent exactly." << std::endl;
+            quantization_mantissa_bits_ = 0;
+        }
+
+        guard.unlock();
+
+        std::unique_lock<std::mutex> guard_agent(local_agent->mutex_);
+        local_agent->agent_->fromCommunication_configured_optimization(*optimization_info);
+        const int id = local_agent->agent_->get_id();
+        guard_agent.unlock();
+
+        // join the multicast groups before the first step is triggered
+        configure_multicast(*optimization_info, id);
+
+        async_send(comm_data, ProtocolCommunication::buildProtocol_acknowledge_received_optimizationInfo());
     }
 
     void CommunicationInterfaceLocal::fromCommunication_successfully_registered_coupling(const CommunicationDataPtr& comm_data, 
         const CouplingInfoPtr& coupling_info, const AgentInfoPtr& agent_info, const CommunicationInfoPtr& communication_info)
     {
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
+
         std::unique_lock<std::shared_mutex> guard(mutex_infos_);
 
-        // add coupling to list of active couplings
-        coupling_infos_active_.push_back(*coupling_info);
+        // add coupling to list of active couplings, it is received by both agents if they run in this process
+        if (!DataConversion::is_element_in_vector(coupling_infos_active_, *coupling_info))
+            coupling_infos_active_.push_back(*coupling_info);
 
         // check if coupling is pending and delete it
 	    DataConversion::erase_element_from_vector(coupling_infos_pending_, *coupling_info);
 	    guard.unlock();
 
         // register coupling in agent
-        std::unique_lock<std::shared_mutex> guard_mutex_basics(mutex_basics_);
+        std::unique_lock<std::mutex> guard_agent(local_agent->mutex_);
 
-        agent_->fromCommunication_registered_coupling(*coupling_info, *agent_info);
+        local_agent->agent_->fromCommunication_registered_coupling(*coupling_info, *agent_info);
 
-        guard_mutex_basics.unlock();
+        guard_agent.unlock();
 
-        connect_to_neighbor(communication_info);
+        connect_to_neighbor(comm_data->local_id_, communication_info);
     }
 
     void CommunicationInterfaceLocal::fromCommunication_successfully_registered_agent(const CommunicationDataPtr& comm_data, const AgentInfoPtr& info)
@@ -1682,10 +3391,13 @@ namespace grampcd
         }
 
         // send communication info to coordinator
-        std::shared_lock<std::shared_mutex> guard_socket(comm_data->mutex_socket_);
+        const auto& link = get_connection(comm_data);
+        std::shared_lock<std::shared_mutex> guard_socket(link->mutex_socket_);
+
+        comm_info_local_.ip_ = link->socket_.local_endpoint().address().to_string();
+        guard_socket.unlock();
 
-        comm_info_local_.ip_ = comm_data->socket_.local_endpoint().address().to_string();
-        async_send(get_communicationData("coordinator"), ProtocolCommunication::buildProtocol_send_communicationInfo(comm_info_local_));
+        async_send(comm_data, ProtocolCommunication::buildProtocol_send_communicationInfo(get_communicationInfo(info->id_)));
     }
 
     void CommunicationInterfaceLocal::fromCommunication_register_agent(const CommunicationDataPtr& comm_data, const AgentInfoPtr& info)
@@ -1704,48 +3416,68 @@ namespace grampcd
 
     void CommunicationInterfaceLocal::fromCommunication_register_coupling(const CommunicationDataPtr& comm_data, const CouplingInfoPtr& coupling_info)
     {
-        const auto comm_data_agent = get_communicationData(coupling_info->agent_id_);
-
-        if (comm_data_agent == nullptr)
-            return;
+        fromCommunication_register_couplings(comm_data, std::make_shared< std::vector<CouplingInfo> >(1, *coupling_info));
+    }
 
-        // if the communication info of the agent has not been arrived, return
-        if (comm_data_agent->communication_info_->port_ == "")
-            return;
+    void CommunicationInterfaceLocal::fromCommunication_register_couplings(const CommunicationDataPtr& comm_data, const std::shared_ptr< std::vector<CouplingInfo> >& coupling_infos)
+    {
+        // couplings of agents whose communication info has not arrived yet are left out, the agents send them again
+        std::vector<CouplingInfo> ready_couplings;
+        ready_couplings.reserve(coupling_infos->size());
+        for (const auto& coupling_info : *coupling_infos)
+        {
+            const auto comm_data_agent = get_communicationData(coupling_info.agent_id_);
+            if (comm_data_agent == nullptr || comm_data_agent->communication_info_->port_ == "")
+                continue;
 
-        const auto comm_data_neighbor = get_communicationData(coupling_info->neighbor_id_);
-        if (comm_data_neighbor == nullptr)
-            return;
+            const auto comm_data_neighbor = get_communicationData(coupling_info.neighbor_id_);
+            if (comm_data_neighbor == nullptr || comm_data_neighbor->communication_info_->port_ == "")
+                continue;
 
-        // if the communication info of the agent has not been arrived, return
-        if (comm_data_neighbor->communication_info_->port_ == "")
-            return;
+            ready_couplings.push_back(coupling_info);
+        }
 
         std::unique_lock<std::shared_mutex> guard(mutex_coordinator_);
-        if (!coordinator_->register_coupling(*coupling_info))
-            return;
-    
-	    // send coupling to agent
-	    const auto data_agent = ProtocolCommunication::buildProtocol_successfully_registered_coupling(*coupling_info, *comm_data_neighbor->agent_info_, *comm_data_neighbor->communication_info_);
-	    async_send(comm_data_agent, data_agent);
+        const auto registered_couplings = coordinator_->register_couplings(ready_couplings);
 
-	    // send coupling to neighbor
-	    const auto data_neighbor = ProtocolCommunication::buildProtocol_successfully_registered_coupling(*coupling_info, *comm_data_agent->agent_info_, *comm_data_agent->communication_info_);
-	    async_send(comm_data_neighbor, data_neighbor);
-    
+        for (const auto& coupling_info : registered_couplings)
+        {
+            const auto comm_data_agent = get_communicationData(coupling_info.agent_id_);
+            const auto comm_data_neighbor = get_communicationData(coupling_info.neighbor_id_);
+            if (comm_data_agent == nullptr || comm_data_neighbor == nullptr)
+                continue;
+
+            // send coupling to agent
+            const auto data_agent = ProtocolCommunication::buildProtocol_successfully_registered_coupling(coupling_info, *comm_data_neighbor->agent_info_, *comm_data_neighbor->communication_info_);
+            async_send(comm_data_agent, data_agent);
+
+            // send coupling to neighbor
+            const auto data_neighbor = ProtocolCommunication::buildProtocol_successfully_registered_coupling(coupling_info, *comm_data_agent->agent_info_, *comm_data_agent->communication_info_);
+            async_send(comm_data_neighbor, data_neighbor);
+        }
     }
 
     void CommunicationInterfaceLocal::fromCommunication_deregistered_coupling(const CommunicationDataPtr& comm_data, const CouplingInfoPtr& info)
     {
-        std::unique_lock<std::shared_mutex> guard_basics(mutex_basics_);
-        agent_->fromCommunication_deregistered_coupling(*info);
+        const auto local_agent = get_localAgent(comm_data->local_id_);
+        if (local_agent == nullptr)
+            return;
 
-        // check if coupling should be re-registered
-        const bool reregister = (!DataConversion::is_element_in_vector(coupling_infos_blocked_, *info))
-            && (info->agent_id_ == agent_->get_id());
+        const auto& agent = local_agent->agent_;
+        std::unique_lock<std::mutex> guard_agent(local_agent->mutex_);
+        agent->fromCommunication_deregistered_coupling(*info);
+
+        // check if agent is still neighbor
+        const int neighbor_id = info->agent_id_ != agent->get_id() ? info->agent_id_ : info->neighbor_id_;
+        const bool isNeighbor = DataConversion::is_element_in_vector(agent->get_neighbors(), neighbor_id);
+        guard_agent.unlock();
 
         std::unique_lock<std::shared_mutex> guard_infos(mutex_infos_);
 
+        // check if coupling should be re-registered
+        const bool reregister = (!DataConversion::is_element_in_vector(coupling_infos_blocked_, *info))
+            && (info->agent_id_ == agent->get_id());
+
         // if coupling should not be re-registered, delete it form the list pending
         if (!reregister)
             DataConversion::erase_element_from_vector(coupling_infos_pending_, *info);
@@ -1760,18 +3492,11 @@ namespace grampcd
 
         guard_infos.unlock();
 
-        // Define neighbor id
-        int neighbor_id;
-        if (info->agent_id_ != agent_->get_id()) 
-            neighbor_id = info->agent_id_;
-        else 
-            neighbor_id = info->neighbor_id_;
-
-        // check if agent is still neighbor
-        const bool isNeighbor = DataConversion::is_element_in_vector(agent_->get_neighbors(), neighbor_id);
+        if (reregister)
+            request_registration();
 
         // check if there is still a open connection
-        const auto comm_data_neighbor = get_communicationData(neighbor_id);
+        const auto comm_data_neighbor = get_communicationData(comm_data->local_id_, neighbor_id);
 
         if (comm_data_neighbor == nullptr)
             return;
@@ -1781,6 +3506,19 @@ namespace grampcd
             handle_disconnect(comm_data_neighbor);
     }
 
+    void CommunicationInterfaceLocal::fromCommunication_send_listeningPort(const CommunicationDataPtr& comm_data, const unsigned int port)
+    {
+        // the connection is used for channels to all agents of the connected process
+        std::lock_guard<std::shared_mutex> guard(mutex_comm_data_vec_);
+        comm_data->communication_info_->port_ = std::to_string(port);
+    }
+
+    void CommunicationInterfaceLocal::fromCommunication_close_channel(const CommunicationDataPtr& comm_data)
+    {
+        if (comm_data->link_ != nullptr && comm_data->is_connected_)
+            handle_disconnect_channel(comm_data);
+    }
+
     const unsigned int CommunicationInterfaceLocal::get_numberOfAgents() const
     {
         if (!coordinator_)
@@ -0,0 +1,449 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/comm/multicast_channel.hpp"
+
+#include "grampcd/util/logging.hpp"
+#include "grampcd/util/data_conversion.hpp"
+#include "grampcd/util/protocol_communication.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace grampcd
+{
+
+	namespace
+	{
+		// type, sender, session and sequence number
+		const unsigned int size_of_header_ = static_cast<unsigned int>(sizeof(char) + sizeof(int) + 2 * sizeof(unsigned int));
+
+		// the session differs between restarts of a sender, also if it starts within the same clock tick
+		const unsigned int create_session()
+		{
+			std::random_device device;
+			return device() ^ static_cast<unsigned int>(std::chrono::steady_clock::now().time_since_epoch().count());
+		}
+		const std::size_t max_size_of_datagram_ = 65507;
+	}
+
+	MulticastChannel::MulticastChannel(const LoggingPtr& log, asio::io_service& ioService, const int id, const ReceiveCallback& callback)
+		:
+		log_(log),
+		id_(id),
+		callback_(callback),
+		endpoint_group_(ioService),
+		endpoint_unicast_(ioService),
+		session_(create_session()),
+		timer_heartbeat_(ioService),
+		local_ids_({ id })
+	{}
+
+	const bool MulticastChannel::open(const std::string& address, const unsigned short port)
+	{
+		asio::error_code ec;
+		const auto first_group = asio::ip::make_address_v4(address, ec);
+		if (ec || !first_group.is_multicast())
+		{
+			log_->print(DebugType::Error) << "[MulticastChannel::open] "
+				<< address << " is not an IPv4 multicast address." << std::endl;
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard(mutex_);
+
+		// several hosts on the same machine receive the groups on the same port
+		endpoint_group_.socket_.open(asio::ip::udp::v4(), ec);
+		if (!ec)
+			endpoint_group_.socket_.set_option(asio::ip::udp::socket::reuse_address(true), ec);
+		if (!ec)
+			endpoint_group_.socket_.bind(asio::ip::udp::endpoint(asio::ip::address_v4::any(), port), ec);
+
+		// hosts on the same machine receive the sent datagrams as well
+		if (!ec)
+			endpoint_unicast_.socket_.open(asio::ip::udp::v4(), ec);
+		if (!ec)
+			endpoint_unicast_.socket_.bind(asio::ip::udp::endpoint(asio::ip::address_v4::any(), 0), ec);
+		if (!ec)
+			endpoint_unicast_.socket_.set_option(asio::ip::multicast::enable_loopback(true), ec);
+		if (!ec)
+			endpoint_unicast_.socket_.set_option(asio::ip::multicast::hops(1), ec);
+
+		if (ec)
+		{
+			log_->print(DebugType::Error) << "[MulticastChannel::open] "
+				<< "Failed to open multicast sockets on port " << port << "." << std::endl
+				<< "Error message: " << ec.message() << std::endl;
+
+			endpoint_group_.socket_.close(ec);
+			endpoint_unicast_.socket_.close(ec);
+			return false;
+		}
+
+		first_group_ = first_group;
+		port_ = port;
+		is_open_ = true;
+
+		async_receive(endpoint_group_);
+		async_receive(endpoint_unicast_);
+
+		return true;
+	}
+
+	void MulticastChannel::close()
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		is_open_ = false;
+
+		asio::error_code ec;
+		timer_heartbeat_.cancel(ec);
+		endpoint_group_.socket_.close(ec);
+		endpoint_unicast_.socket_.close(ec);
+	}
+
+	const bool MulticastChannel::is_using(const std::string& address, const unsigned short port) const
+	{
+		asio::error_code ec;
+		const auto first_group = asio::ip::make_address_v4(address, ec);
+
+		std::lock_guard<std::mutex> guard(mutex_);
+		return !ec && first_group == first_group_ && port == port_;
+	}
+
+	void MulticastChannel::add_receiver(const int id)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		local_ids_.insert(id);
+	}
+
+	void MulticastChannel::join(const int sender)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!is_open_ || local_ids_.count(sender) > 0 || joined_senders_.count(sender) > 0)
+			return;
+
+		asio::error_code ec;
+		endpoint_group_.socket_.set_option(asio::ip::multicast::join_group(get_group(sender)), ec);
+		if (ec)
+		{
+			log_->print(DebugType::Warning) << "[MulticastChannel::join] "
+				<< "Failed to join multicast group " << get_group(sender).to_string() << "." << std::endl
+				<< "Error message: " << ec.message() << std::endl;
+			return;
+		}
+
+		joined_senders_.insert(sender);
+	}
+
+	const bool MulticastChannel::send(const int sender, const std::vector<int>& receivers, const std::shared_ptr< std::vector<char> >& message)
+	{
+		if (sender != id_)
+			return false;
+
+		const std::size_t size_of_datagram = size_of_header_ + sizeof(unsigned int) + receivers.size() * sizeof(int) + message->size();
+		if (size_of_datagram > max_size_of_datagram_)
+			return false;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!is_open_)
+			return false;
+
+		std::shared_ptr< std::vector<char> > datagram(new std::vector<char>(size_of_datagram, 0));
+		unsigned int pos = 0;
+
+		// header
+		DataConversion::insert_into_charArray(datagram, pos, static_cast<char>(DatagramType::data));
+		DataConversion::insert_into_charArray(datagram, pos, id_);
+		DataConversion::insert_into_charArray(datagram, pos, session_);
+		DataConversion::insert_into_charArray(datagram, pos, sequence_);
+
+		// receivers
+		DataConversion::insert_into_charArray(datagram, pos, static_cast<unsigned int>(receivers.size()));
+		for (const auto& receiver : receivers)
+			DataConversion::insert_into_charArray(datagram, pos, receiver);
+
+		// message
+		std::copy(message->begin(), message->end(), datagram->begin() + pos);
+
+		asio::error_code ec;
+		endpoint_unicast_.socket_.send_to(asio::buffer(*datagram), asio::ip::udp::endpoint(get_group(id_), port_), 0, ec);
+		if (ec)
+		{
+			log_->print(DebugType::Warning) << "[MulticastChannel::send] "
+				<< "Failed to send multicast datagram." << std::endl
+				<< "Error message: " << ec.message() << std::endl;
+			return false;
+		}
+
+		// keep the datagram for retransmissions
+		++sequence_;
+		history_.push_back(datagram);
+		if (history_.size() > max_size_history_)
+			history_.pop_front();
+
+		start_heartbeat();
+
+		return true;
+	}
+
+	const asio::ip::address_v4 MulticastChannel::get_group(const int sender) const
+	{
+		return asio::ip::address_v4(first_group_.to_uint() + static_cast<asio::ip::address_v4::uint_type>(sender + 1));
+	}
+
+	void MulticastChannel::async_receive(Endpoint& endpoint)
+	{
+		endpoint.socket_.async_receive_from(asio::buffer(endpoint.buffer_), endpoint.sender_endpoint_,
+			std::bind(&MulticastChannel::receiveHandler, shared_from_this(),
+				std::placeholders::_1, std::placeholders::_2, std::ref(endpoint)));
+	}
+
+	void MulticastChannel::receiveHandler(const asio::error_code& ec, const std::size_t bytes_transferred, Endpoint& endpoint)
+	{
+		if (ec == asio::error::operation_aborted)
+			return;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!is_open_)
+			return;
+
+		if (!ec)
+			evaluate_datagram(std::vector<char>(endpoint.buffer_.begin(), endpoint.buffer_.begin() + bytes_transferred),
+				endpoint.sender_endpoint_);
+
+		async_receive(endpoint);
+	}
+
+	void MulticastChannel::evaluate_datagram(const std::vector<char>& datagram, const asio::ip::udp::endpoint& from)
+	{
+		if (datagram.size() < size_of_header_)
+			return;
+
+		const auto type = static_cast<DatagramType>(datagram[0]);
+		unsigned int pos = sizeof(char);
+		int sender = 0;
+		unsigned int session = 0;
+		unsigned int sequence = 0;
+		DataConversion::read_from_charArray(datagram, pos, sender);
+		DataConversion::read_from_charArray(datagram, pos, session);
+		DataConversion::read_from_charArray(datagram, pos, sequence);
+
+		// another host requests data of this host, requests for a previous session are outdated
+		if (type == DatagramType::nack)
+		{
+			if (sender != id_ || session != session_ || datagram.size() < size_of_header_ + sizeof(unsigned int))
+				return;
+
+			unsigned int last = 0;
+			DataConversion::read_from_charArray(datagram, pos, last);
+			send_retransmission(sequence, last, from);
+			return;
+		}
+
+		// datagrams of senders that are not joined are received, if several hosts on the same machine use the same port
+		if (joined_senders_.count(sender) == 0)
+			return;
+
+		auto& receiver = receivers_[sender];
+
+		// the sender restarted, so its sequence numbers start at zero again
+		if (receiver.is_initialized_ && session != receiver.session_)
+		{
+			// the session of data that is not stored anymore is still the current one
+			if (type == DatagramType::unavailable)
+				return;
+
+			log_->print(DebugType::Message) << "[MulticastChannel::evaluate_datagram] "
+				<< "Sender " << sender << " started a new session." << std::endl;
+
+			receiver = Receiver();
+		}
+
+		// The receiver starts at the first datagram it sees. Older data was sent before this host joined
+		// or the sender restarted, so it is not requested. The heartbeat refers to data that was already sent.
+		if (!receiver.is_initialized_ && type != DatagramType::unavailable)
+		{
+			receiver.is_initialized_ = true;
+			receiver.session_ = session;
+			receiver.next_sequence_ = type == DatagramType::heartbeat ? sequence + 1 : sequence;
+		}
+
+		switch (type)
+		{
+		case DatagramType::data:
+			// duplicate
+			if (sequence < receiver.next_sequence_)
+				return;
+
+			// data is missing, so keep the datagram and request the missing ones
+			if (sequence > receiver.next_sequence_)
+			{
+				if (receiver.pending_.size() < max_number_of_pending_)
+					receiver.pending_[sequence] = std::make_shared< std::vector<char> >(datagram);
+
+				send_nack(sender, session, receiver.next_sequence_, sequence - 1, from);
+				return;
+			}
+
+			receiver.pending_[sequence] = std::make_shared< std::vector<char> >(datagram);
+			deliver(sender, receiver);
+			break;
+
+		case DatagramType::heartbeat:
+			// the heartbeat contains the sequence number of the last sent data
+			if (sequence >= receiver.next_sequence_)
+				send_nack(sender, session, receiver.next_sequence_, sequence, from);
+			break;
+
+		case DatagramType::unavailable:
+			// the sender does not store the missing data anymore, so it is skipped
+			if (receiver.is_initialized_ && sequence > receiver.next_sequence_)
+			{
+				log_->print(DebugType::Warning) << "[MulticastChannel::evaluate_datagram] "
+					<< "Lost " << sequence - receiver.next_sequence_ << " messages of sender " << sender << "." << std::endl;
+
+				receiver.next_sequence_ = sequence;
+				receiver.pending_.erase(receiver.pending_.begin(), receiver.pending_.lower_bound(sequence));
+				deliver(sender, receiver);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	void MulticastChannel::deliver(const int sender, Receiver& receiver)
+	{
+		for (auto iterator = receiver.pending_.find(receiver.next_sequence_); iterator != receiver.pending_.end();
+			iterator = receiver.pending_.find(receiver.next_sequence_))
+		{
+			const auto datagram = iterator->second;
+			receiver.pending_.erase(iterator);
+			++receiver.next_sequence_;
+
+			// read receivers
+			unsigned int pos = size_of_header_;
+			unsigned int number_of_receivers = 0;
+			if (datagram->size() < pos + sizeof(unsigned int))
+				continue;
+			DataConversion::read_from_charArray(*datagram, pos, number_of_receivers);
+			if (datagram->size() < pos + number_of_receivers * sizeof(int) + first_element_with_data_)
+				continue;
+
+			std::vector<int> local_receivers;
+			for (unsigned int k = 0; k < number_of_receivers; ++k)
+			{
+				int receiver_id = 0;
+				DataConversion::read_from_charArray(*datagram, pos, receiver_id);
+				if (local_ids_.count(receiver_id) > 0)
+					local_receivers.push_back(receiver_id);
+			}
+			if (local_receivers.empty())
+				continue;
+
+			// the message has to be complete
+			std::shared_ptr< std::vector<char> > message(new std::vector<char>(datagram->begin() + pos, datagram->end()));
+			unsigned int size_of_message = 0;
+			pos = 0;
+			DataConversion::read_from_charArray(*message, pos, size_of_message);
+			if (size_of_message != message->size())
+				continue;
+
+			// messages are handed over in order
+			for (const auto& receiver_id : local_receivers)
+				callback_(sender, receiver_id, message);
+		}
+	}
+
+	void MulticastChannel::send_nack(const int sender, const unsigned int session, const unsigned int first, const unsigned int last, const asio::ip::udp::endpoint& to)
+	{
+		std::shared_ptr< std::vector<char> > datagram(new std::vector<char>(size_of_header_ + sizeof(unsigned int), 0));
+		unsigned int pos = 0;
+
+		DataConversion::insert_into_charArray(datagram, pos, static_cast<char>(DatagramType::nack));
+		DataConversion::insert_into_charArray(datagram, pos, sender);
+		DataConversion::insert_into_charArray(datagram, pos, session);
+		DataConversion::insert_into_charArray(datagram, pos, first);
+		DataConversion::insert_into_charArray(datagram, pos, last);
+
+		asio::error_code ec;
+		endpoint_unicast_.socket_.send_to(asio::buffer(*datagram), to, 0, ec);
+	}
+
+	void MulticastChannel::send_retransmission(unsigned int first, unsigned int last, const asio::ip::udp::endpoint& to)
+	{
+		if (sequence_ == 0)
+			return;
+
+		const unsigned int first_stored = sequence_ - static_cast<unsigned int>(history_.size());
+		last = std::min(last, sequence_ - 1);
+		asio::error_code ec;
+
+		// tell the receiver to skip data that is not stored anymore
+		if (first < first_stored)
+		{
+			std::shared_ptr< std::vector<char> > datagram(new std::vector<char>(size_of_header_, 0));
+			unsigned int pos = 0;
+
+			DataConversion::insert_into_charArray(datagram, pos, static_cast<char>(DatagramType::unavailable));
+			DataConversion::insert_into_charArray(datagram, pos, id_);
+			DataConversion::insert_into_charArray(datagram, pos, session_);
+			DataConversion::insert_into_charArray(datagram, pos, first_stored);
+
+			endpoint_unicast_.socket_.send_to(asio::buffer(*datagram), to, 0, ec);
+			first = first_stored;
+		}
+
+		for (unsigned int sequence = first; sequence <= last && sequence >= first_stored; ++sequence)
+			endpoint_unicast_.socket_.send_to(asio::buffer(*history_[sequence - first_stored]), to, 0, ec);
+	}
+
+	void MulticastChannel::start_heartbeat()
+	{
+		number_of_heartbeats_ = 0;
+
+		timer_heartbeat_.expires_from_now(std::chrono::milliseconds(1));
+		timer_heartbeat_.async_wait(std::bind(&MulticastChannel::heartbeatHandler, shared_from_this(), std::placeholders::_1));
+	}
+
+	void MulticastChannel::heartbeatHandler(const asio::error_code& ec)
+	{
+		if (ec)
+			return;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!is_open_ || sequence_ == 0)
+			return;
+
+		std::shared_ptr< std::vector<char> > datagram(new std::vector<char>(size_of_header_, 0));
+		unsigned int pos = 0;
+
+		DataConversion::insert_into_charArray(datagram, pos, static_cast<char>(DatagramType::heartbeat));
+		DataConversion::insert_into_charArray(datagram, pos, id_);
+		DataConversion::insert_into_charArray(datagram, pos, session_);
+		DataConversion::insert_into_charArray(datagram, pos, sequence_ - 1);
+
+		asio::error_code ec_send;
+		endpoint_unicast_.socket_.send_to(asio::buffer(*datagram), asio::ip::udp::endpoint(get_group(id_), port_), 0, ec_send);
+
+		// the interval doubles after each heartbeat
+		++number_of_heartbeats_;
+		if (number_of_heartbeats_ < max_number_of_heartbeats_)
+		{
+			timer_heartbeat_.expires_from_now(std::chrono::milliseconds(1 << number_of_heartbeats_));
+			timer_heartbeat_.async_wait(std::bind(&MulticastChannel::heartbeatHandler, shared_from_this(), std::placeholders::_1));
+		}
+	}
+
+}
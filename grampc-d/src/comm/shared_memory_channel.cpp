@@ -0,0 +1,371 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/comm/shared_memory_channel.hpp"
+
+#include "grampcd/util/logging.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace grampcd
+{
+
+#ifdef __linux__
+
+	static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+		"Shared memory requires lock-free atomics.");
+
+	/*@brief Positions and wake-up words of a ring buffer, the counters do not wrap around.*/
+	struct SharedMemoryRing
+	{
+		/*Number of bytes written by the producer.*/
+		alignas(64) std::atomic<std::uint64_t> head_;
+		/*Incremented after each write, the consumer waits on it.*/
+		std::atomic<std::uint32_t> sequence_written_;
+		/*Flag that states if the consumer sleeps.*/
+		std::atomic<std::uint32_t> is_consumer_waiting_;
+
+		/*Number of bytes read by the consumer.*/
+		alignas(64) std::atomic<std::uint64_t> tail_;
+		/*Incremented after each read, the producer waits on it.*/
+		std::atomic<std::uint32_t> sequence_read_;
+		/*Flag that states if the producer sleeps.*/
+		std::atomic<std::uint32_t> is_producer_waiting_;
+	};
+
+	/*@brief Layout of the shared memory segment, the data of both ring buffers follows.*/
+	struct SharedMemorySegment
+	{
+		/*Flag that states if the channel is closed.*/
+		std::atomic<std::uint32_t> is_closed_;
+		/*Process ids of the creating and the opening process.*/
+		std::atomic<std::int32_t> pid_creator_;
+		std::atomic<std::int32_t> pid_opener_;
+		/*Ring buffer from creator to opener and vice versa.*/
+		SharedMemoryRing rings_[2];
+	};
+
+	namespace
+	{
+		const std::size_t capacity_ = std::size_t(1) << 20;
+		const std::size_t size_of_segment_ = sizeof(SharedMemorySegment) + 2 * capacity_;
+		const unsigned int number_of_spins_ = 2000;
+		const long waiting_time_ns_ = 100000000;
+
+		void futex_wait(std::atomic<std::uint32_t>& word, const std::uint32_t expected)
+		{
+			// wake up periodically to recognize a terminated process
+			const timespec timeout{ 0, waiting_time_ns_ };
+			syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+		}
+
+		void futex_wake(std::atomic<std::uint32_t>& word)
+		{
+			syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+		}
+
+		/*Wait until the condition holds. Returns false if the channel is closed.*/
+		template<typename Condition, typename Closed>
+		const bool wait(std::atomic<std::uint32_t>& sequence, std::atomic<std::uint32_t>& is_waiting,
+			const Condition& condition, const Closed& is_closed)
+		{
+			// busy waiting first, as the connected process typically answers within microseconds
+			for (unsigned int k = 0; k < number_of_spins_; ++k)
+				if (condition())
+					return true;
+
+			while (true)
+			{
+				const auto expected = sequence.load();
+				if (condition())
+					return true;
+				if (is_closed())
+					return false;
+
+				// announce sleeping and check again, so that no wake-up is missed
+				is_waiting.store(1);
+				if (condition())
+				{
+					is_waiting.store(0);
+					return true;
+				}
+
+				futex_wait(sequence, expected);
+				is_waiting.store(0);
+			}
+		}
+
+		void notify(std::atomic<std::uint32_t>& sequence, const std::atomic<std::uint32_t>& is_waiting)
+		{
+			sequence.fetch_add(1);
+			if (is_waiting.load() != 0)
+				futex_wake(sequence);
+		}
+
+		const bool is_process_alive(const std::int32_t pid)
+		{
+			return pid <= 0 || kill(pid, 0) == 0 || errno != ESRCH;
+		}
+	}
+
+	SharedMemoryChannel::SharedMemoryChannel(const LoggingPtr& log, const std::string& name, void* memory, const bool is_creator)
+		:
+		log_(log),
+		name_(name),
+		segment_(static_cast<SharedMemorySegment*>(memory)),
+		is_creator_(is_creator)
+	{
+		char* data = static_cast<char*>(memory) + sizeof(SharedMemorySegment);
+
+		// the creator sends on the first ring buffer and receives on the second one
+		ring_send_ = &segment_->rings_[is_creator ? 0 : 1];
+		ring_receive_ = &segment_->rings_[is_creator ? 1 : 0];
+		buffer_send_ = data + (is_creator ? 0 : capacity_);
+		buffer_receive_ = data + (is_creator ? capacity_ : 0);
+	}
+
+	SharedMemoryChannel::~SharedMemoryChannel()
+	{
+		close();
+		munmap(segment_, size_of_segment_);
+
+		if (is_creator_)
+			unlink();
+	}
+
+	SharedMemoryChannelPtr SharedMemoryChannel::create(const LoggingPtr& log)
+	{
+		static std::atomic<unsigned int> number_of_segments(0);
+		const std::string name = "/grampcd_" + std::to_string(getpid()) + "_" + std::to_string(number_of_segments++);
+
+		const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+		if (fd < 0)
+		{
+			log->print(DebugType::Error) << "[SharedMemoryChannel::create] "
+				<< "Failed to create shared memory " << name << ": " << std::strerror(errno) << std::endl;
+			return nullptr;
+		}
+
+		void* memory = MAP_FAILED;
+		if (ftruncate(fd, static_cast<off_t>(size_of_segment_)) == 0)
+			memory = mmap(nullptr, size_of_segment_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+
+		if (memory == MAP_FAILED)
+		{
+			log->print(DebugType::Error) << "[SharedMemoryChannel::create] "
+				<< "Failed to map shared memory " << name << ": " << std::strerror(errno) << std::endl;
+			shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		auto segment = new (memory) SharedMemorySegment();
+		segment->pid_creator_.store(getpid());
+
+		return SharedMemoryChannelPtr(new SharedMemoryChannel(log, name, memory, true));
+	}
+
+	SharedMemoryChannelPtr SharedMemoryChannel::open(const LoggingPtr& log, const std::string& name)
+	{
+		const int fd = shm_open(name.c_str(), O_RDWR, 0);
+		if (fd < 0)
+		{
+			log->print(DebugType::Warning) << "[SharedMemoryChannel::open] "
+				<< "Failed to open shared memory " << name << ": " << std::strerror(errno) << std::endl;
+			return nullptr;
+		}
+
+		// the segment has to be created by a process with the same layout
+		struct stat status;
+		void* memory = MAP_FAILED;
+		if (fstat(fd, &status) == 0 && static_cast<std::size_t>(status.st_size) == size_of_segment_)
+			memory = mmap(nullptr, size_of_segment_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+
+		if (memory == MAP_FAILED)
+		{
+			log->print(DebugType::Warning) << "[SharedMemoryChannel::open] "
+				<< "Failed to map shared memory " << name << "." << std::endl;
+			return nullptr;
+		}
+
+		auto channel = SharedMemoryChannelPtr(new SharedMemoryChannel(log, name, memory, false));
+		channel->segment_->pid_opener_.store(getpid());
+
+		// both processes mapped the segment, hence the name is not required anymore
+		channel->unlink();
+
+		return channel;
+	}
+
+	const std::string& SharedMemoryChannel::get_name() const
+	{
+		return name_;
+	}
+
+	void SharedMemoryChannel::unlink() const
+	{
+		shm_unlink(name_.c_str());
+	}
+
+	const bool SharedMemoryChannel::write(const char* data, std::size_t size) const
+	{
+		auto& ring = *ring_send_;
+		const auto is_closed = [this]() { return this->is_closed(); };
+
+		while (size > 0)
+		{
+			const std::uint64_t head = ring.head_.load(std::memory_order_relaxed);
+
+			// wait for free space
+			if (!wait(ring.sequence_read_, ring.is_producer_waiting_,
+				[&ring, head]() { return head - ring.tail_.load(std::memory_order_acquire) < capacity_; }, is_closed))
+				return false;
+
+			const std::size_t position = static_cast<std::size_t>(head % capacity_);
+			const std::size_t free_space = capacity_ - static_cast<std::size_t>(head - ring.tail_.load(std::memory_order_acquire));
+			const std::size_t chunk = std::min({ size, free_space, capacity_ - position });
+
+			std::memcpy(buffer_send_ + position, data, chunk);
+			ring.head_.store(head + chunk, std::memory_order_release);
+			notify(ring.sequence_written_, ring.is_consumer_waiting_);
+
+			data += chunk;
+			size -= chunk;
+		}
+
+		return true;
+	}
+
+	const bool SharedMemoryChannel::read(char* data, std::size_t size) const
+	{
+		auto& ring = *ring_receive_;
+		const auto is_closed = [this]() { return this->is_closed(); };
+
+		while (size > 0)
+		{
+			const std::uint64_t tail = ring.tail_.load(std::memory_order_relaxed);
+
+			// wait for data
+			if (!wait(ring.sequence_written_, ring.is_consumer_waiting_,
+				[&ring, tail]() { return ring.head_.load(std::memory_order_acquire) != tail; }, is_closed))
+				return false;
+
+			const std::size_t position = static_cast<std::size_t>(tail % capacity_);
+			const std::size_t available = static_cast<std::size_t>(ring.head_.load(std::memory_order_acquire) - tail);
+			const std::size_t chunk = std::min({ size, available, capacity_ - position });
+
+			std::memcpy(data, buffer_receive_ + position, chunk);
+			ring.tail_.store(tail + chunk, std::memory_order_release);
+			notify(ring.sequence_read_, ring.is_producer_waiting_);
+
+			data += chunk;
+			size -= chunk;
+		}
+
+		return true;
+	}
+
+	void SharedMemoryChannel::close() const
+	{
+		segment_->is_closed_.store(1);
+
+		// wake up all threads that wait on any of the ring buffers
+		for (auto& ring : segment_->rings_)
+		{
+			ring.sequence_written_.fetch_add(1);
+			ring.sequence_read_.fetch_add(1);
+			futex_wake(ring.sequence_written_);
+			futex_wake(ring.sequence_read_);
+		}
+	}
+
+	const bool SharedMemoryChannel::is_closed() const
+	{
+		if (segment_->is_closed_.load() != 0)
+			return true;
+
+		// a terminated process does not close the channel
+		const auto pid = is_creator_ ? segment_->pid_opener_.load() : segment_->pid_creator_.load();
+		return !is_process_alive(pid);
+	}
+
+#else
+
+	SharedMemoryChannel::SharedMemoryChannel(const LoggingPtr& log, const std::string& name, void* memory, const bool is_creator)
+		:
+		log_(log),
+		name_(name),
+		is_creator_(is_creator)
+	{}
+
+	SharedMemoryChannel::~SharedMemoryChannel()
+	{}
+
+	SharedMemoryChannelPtr SharedMemoryChannel::create(const LoggingPtr& log)
+	{
+		return nullptr;
+	}
+
+	SharedMemoryChannelPtr SharedMemoryChannel::open(const LoggingPtr& log, const std::string& name)
+	{
+		log->print(DebugType::Warning) << "[SharedMemoryChannel::open] "
+			<< "Shared memory is not supported on this platform." << std::endl;
+		return nullptr;
+	}
+
+	const std::string& SharedMemoryChannel::get_name() const
+	{
+		return name_;
+	}
+
+	void SharedMemoryChannel::unlink() const
+	{}
+
+	const bool SharedMemoryChannel::write(const char* data, std::size_t size) const
+	{
+		return false;
+	}
+
+	const bool SharedMemoryChannel::read(char* data, std::size_t size) const
+	{
+		return false;
+	}
+
+	void SharedMemoryChannel::close() const
+	{}
+
+	const bool SharedMemoryChannel::is_closed() const
+	{
+		return true;
+	}
+
+#endif
+
+}
@@ -0,0 +1,171 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/comm/timer_wheel.hpp"
+
+#include <algorithm>
+
+namespace grampcd
+{
+
+	TimerWheel::TimerWheel(asio::io_service& ioService, const std::chrono::milliseconds resolution)
+		:
+		resolution_(std::max(resolution, std::chrono::milliseconds(1))),
+		start_(std::chrono::steady_clock::now()),
+		timer_(ioService)
+	{}
+
+	const TimerWheel::Handle TimerWheel::schedule(const std::chrono::milliseconds delay, const Callback& callback)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+
+		const auto elapsed_ticks = get_elapsed_ticks();
+
+		// the wheel is empty while the timer is not armed, hence it continues at the current time
+		if (!is_timer_armed_)
+		{
+			for (auto& level : slots_)
+				for (auto& slot : level)
+					slot.clear();
+			current_tick_ = std::max(current_tick_, elapsed_ticks);
+		}
+
+		// round the deadline up to the next tick, such that a timeout never expires early
+		const auto deadline = std::chrono::steady_clock::now() - start_ + std::max(delay, std::chrono::milliseconds(0));
+		const auto expiry = static_cast<unsigned long long>((deadline + resolution_ - std::chrono::nanoseconds(1)) / resolution_);
+
+		const Handle handle = next_handle_++;
+		callbacks_[handle] = callback;
+		insert({ handle, expiry }, current_tick_ + 1);
+
+		if (!is_timer_armed_)
+			start_timer();
+
+		return handle;
+	}
+
+	void TimerWheel::cancel(const Handle handle)
+	{
+		// the entry remains in its slot and is dropped once the slot is processed
+		std::lock_guard<std::mutex> guard(mutex_);
+		callbacks_.erase(handle);
+	}
+
+	void TimerWheel::clear()
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+
+		callbacks_.clear();
+		for (auto& level : slots_)
+			for (auto& slot : level)
+				slot.clear();
+
+		asio::error_code ec;
+		timer_.cancel(ec);
+		is_timer_armed_ = false;
+	}
+
+	void TimerWheel::insert(const Entry& entry, const unsigned long long next_tick)
+	{
+		auto expiry = std::max(entry.expiry_, next_tick);
+
+		// timeouts beyond the range of the wheel expire at its end
+		const unsigned long long range = 1ull << (bits_per_level_ * number_of_levels_);
+		expiry = std::min(expiry, next_tick + range - 1);
+
+		const auto ticks = expiry - next_tick;
+		unsigned int level = 0;
+		while (level + 1 < number_of_levels_ && ticks >= (1ull << (bits_per_level_ * (level + 1))))
+			++level;
+
+		const auto slot = (expiry >> (bits_per_level_ * level)) & (slots_per_level_ - 1);
+		slots_[level][slot].push_back({ entry.handle_, expiry });
+	}
+
+	void TimerWheel::cascade(const unsigned int level, const unsigned long long tick)
+	{
+		auto& slot = slots_[level][(tick >> (bits_per_level_ * level)) & (slots_per_level_ - 1)];
+
+		std::vector<Entry> entries;
+		entries.swap(slot);
+
+		for (const auto& entry : entries)
+		{
+			if (callbacks_.find(entry.handle_) != callbacks_.end())
+				insert(entry, tick);
+		}
+	}
+
+	const unsigned long long TimerWheel::get_elapsed_ticks() const
+	{
+		return static_cast<unsigned long long>((std::chrono::steady_clock::now() - start_) / resolution_);
+	}
+
+	void TimerWheel::start_timer()
+	{
+		is_timer_armed_ = true;
+		timer_.expires_at(start_ + resolution_ * static_cast<long long>(current_tick_ + 1));
+		timer_.async_wait(std::bind(&TimerWheel::tickHandler, this, std::placeholders::_1));
+	}
+
+	void TimerWheel::tickHandler(const asio::error_code& ec)
+	{
+		if (ec)
+			return;
+
+		std::vector<Callback> expired;
+
+		std::unique_lock<std::mutex> guard(mutex_);
+		is_timer_armed_ = false;
+
+		// catch up with all ticks that passed, e.g. if the handler was delayed
+		const auto elapsed_ticks = get_elapsed_ticks();
+		while (current_tick_ < elapsed_ticks)
+		{
+			const auto tick = ++current_tick_;
+
+			// coarser levels first, such that their entries can cascade further down
+			for (unsigned int level = number_of_levels_ - 1; level > 0; --level)
+			{
+				if ((tick & ((1ull << (bits_per_level_ * level)) - 1)) == 0)
+					cascade(level, tick);
+			}
+
+			std::vector<Entry> entries;
+			entries.swap(slots_[0][tick & (slots_per_level_ - 1)]);
+
+			for (const auto& entry : entries)
+			{
+				const auto callback = callbacks_.find(entry.handle_);
+				if (callback == callbacks_.end())
+					continue;
+
+				if (entry.expiry_ <= tick)
+				{
+					expired.push_back(std::move(callback->second));
+					callbacks_.erase(callback);
+				}
+				else
+					insert(entry, tick + 1);
+			}
+		}
+
+		if (!callbacks_.empty())
+			start_timer();
+		guard.unlock();
+
+		// callbacks may schedule new timeouts
+		for (const auto& callback : expired)
+			callback();
+	}
+
+}
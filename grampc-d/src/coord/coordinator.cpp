@@ -15,13 +15,14 @@
 #include "grampcd/optim/optim_util.hpp"
 
 #include "grampcd/util/logging.hpp"
-#include "grampcd/util/data_conversion.hpp"
 
 #include "grampcd/comm/communication_interface.hpp"
 
 #include "grampcd/info/agent_info.hpp"
 #include "grampcd/info/coupling_info.hpp"
 
+#include <deque>
+
 namespace grampcd
 {
 
@@ -51,6 +52,7 @@ namespace grampcd
 
 	    // prepare entry in receiving neighbors
 	    receiving_neighbors_.insert(std::make_pair(agent_info.id_, std::vector< std::shared_ptr< CouplingInfo> >()));
+        ++topology_version_;
 
         log_->print(DebugType::Message) << "[Coordinator::register_agent] "
             << "Agent " << agent_info.id_ << " registered. "
@@ -88,9 +90,9 @@ namespace grampcd
 	    // check if coupling already exists 
         auto& sending_neighbors = sending_neighbors_.find(coupling_info.agent_id_)->second;
         auto& receiving_neighbors = receiving_neighbors_.find(coupling_info.neighbor_id_)->second;
+        const CouplingKey key = get_couplingKey(coupling_info);
 
-        if(DataConversion::is_element_in_vector(sending_neighbors, coupling_info) ||
-            DataConversion::is_element_in_vector(receiving_neighbors, coupling_info) )
+        if(couplings_.find(key) != couplings_.end())
         {
             log_->print(DebugType::Warning) << "[Coordinator::register_coupling] Failed to register coupling of agent " << coupling_info.agent_id_
                 << " with neighbor " << coupling_info.neighbor_id_ << " as coupling is already registered." << std::endl;
@@ -105,6 +107,10 @@ namespace grampcd
         // register coupling for receiving neighbor
         receiving_neighbors.push_back(info);
 
+        // remember positions for constant time removal
+        couplings_.insert(std::make_pair(key, CouplingPosition{ sending_neighbors.size() - 1, receiving_neighbors.size() - 1 }));
+        ++topology_version_;
+
         log_->print(DebugType::Message) << "[Coordinator::register_coupling] "
             << "Coupling between agent " << coupling_info.agent_id_ << " (receiving) and agent " << coupling_info.neighbor_id_ << " (sending) registered. "
             << "Model name '" << coupling_info.model_name_ << "'." << std::endl;
@@ -112,6 +118,21 @@ namespace grampcd
         return true;
     }
 
+    const std::vector<CouplingInfo> Coordinator::register_couplings(const std::vector<CouplingInfo>& coupling_infos)
+    {
+        couplings_.reserve(couplings_.size() + coupling_infos.size());
+
+        std::vector<CouplingInfo> registered_couplings;
+        registered_couplings.reserve(coupling_infos.size());
+        for (const auto& coupling_info : coupling_infos)
+        {
+            if (register_coupling(coupling_info))
+                registered_couplings.push_back(coupling_info);
+        }
+
+        return registered_couplings;
+    }
+
     const bool Coordinator::deregister_agent(const AgentInfo &agent_info)
     {
         // check if agent is known
@@ -126,56 +147,96 @@ namespace grampcd
         const auto& sending_neighbors = sending_neighbors_.find(agent_info.id_)->second;
         const auto& receiving_neighbors = receiving_neighbors_.find(agent_info.id_)->second;
 
-        // deregister couplings of sending neighbors
+        // deregister couplings of sending neighbors, starting at the back
+        // such that no entries have to be moved
         while( sending_neighbors.size() > 0 )
-            deregister_coupling(sending_neighbors[0]);
+        {
+            if (!deregister_coupling(sending_neighbors.back()))
+                return false;
+        }
 
         // deregister couplings of receiving neigbors
         while( receiving_neighbors.size() > 0 )
-            deregister_coupling(receiving_neighbors[0]);
+        {
+            if (!deregister_coupling(receiving_neighbors.back()))
+                return false;
+        }
 
+        sending_neighbors_.erase(agent_info.id_);
+        receiving_neighbors_.erase(agent_info.id_);
         agents_.erase(agents_.find(agent_info.id_));
+        ++topology_version_;
 
         return true;
     }
 
     const bool Coordinator::deregister_coupling(CouplingInfoPtr coupling_info)
     {
-	    auto& sending_neighbors = sending_neighbors_.find(coupling_info->agent_id_)->second;
-        auto& receiving_neighbors = receiving_neighbors_.find(coupling_info->neighbor_id_)->second;
+        // copy the info, as the given pointer may point into the lists of neighbors
+        const CouplingInfo info = *coupling_info;
+        const CouplingKey key = get_couplingKey(info);
 
-        // check if coupling is registered in sending neighbors
-        if (!DataConversion::is_element_in_vector(sending_neighbors, *coupling_info))
+        // check if coupling is registered
+        if (couplings_.find(key) == couplings_.end())
         {
             log_->print(DebugType::Error) << "[Coordinator::deregister_coupling] "
-                << "Failed to deregister coupling, as agent " << coupling_info->agent_id_
-                << " has no sending neighbor " << coupling_info->neighbor_id_ << "." << std::endl;
-		    return false;
-	    }
-
-	    // check if coupling is registered in receiving neighbors
-	    if (!DataConversion::is_element_in_vector(receiving_neighbors, *coupling_info))
-	    {
-            log_->print(DebugType::Error) << "[Coordinator::deregister_coupling] "
-                << "Failed to deregister coupling, as agent " << coupling_info->neighbor_id_
-                << " has no receiving neighbor " << coupling_info->agent_id_ << "." << std::endl;
+                << "Failed to deregister coupling, as agent " << info.agent_id_
+                << " has no sending neighbor " << info.neighbor_id_ << "." << std::endl;
 		    return false;
 	    }
 
         // inform both agents that coupling is deregistered
-        communication_interface_->fromCommunication_deregistered_coupling(*coupling_info);
+        communication_interface_->fromCommunication_deregistered_coupling(info);
 
         // and delete coupling
-        DataConversion::erase_element_from_vector(sending_neighbors, *coupling_info);
-        DataConversion::erase_element_from_vector(receiving_neighbors, *coupling_info);
+        erase_coupling(key);
+        ++topology_version_;
 
         log_->print(DebugType::Message) << "[Coordinator::deregister_coupling] "
-            << "Coupling between agent " << coupling_info->agent_id_ << " (receiving) and agent " << coupling_info->neighbor_id_
+            << "Coupling between agent " << info.agent_id_ << " (receiving) and agent " << info.neighbor_id_
             << " (sending) deregistered." << std::endl;
 
         return true;
     }
 
+    std::size_t Coordinator::CouplingKeyHash::operator()(const CouplingKey& key) const
+    {
+        std::size_t seed = std::hash<int>()(std::get<0>(key));
+        seed ^= std::hash<int>()(std::get<1>(key)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<std::string>()(std::get<2>(key)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+
+    Coordinator::CouplingKey Coordinator::get_couplingKey(const CouplingInfo& coupling_info)
+    {
+        return CouplingKey(coupling_info.agent_id_, coupling_info.neighbor_id_, coupling_info.model_name_);
+    }
+
+    void Coordinator::erase_coupling(const CouplingKey& key)
+    {
+        const auto iterator = couplings_.find(key);
+        const CouplingPosition position = iterator->second;
+        couplings_.erase(iterator);
+
+        auto& sending_neighbors = sending_neighbors_.find(std::get<0>(key))->second;
+        auto& receiving_neighbors = receiving_neighbors_.find(std::get<1>(key))->second;
+
+        // move last coupling into the gap and update its position
+        if (position.sending_ + 1 < sending_neighbors.size())
+        {
+            sending_neighbors[position.sending_] = sending_neighbors.back();
+            couplings_.find(get_couplingKey(*sending_neighbors[position.sending_]))->second.sending_ = position.sending_;
+        }
+        sending_neighbors.pop_back();
+
+        if (position.receiving_ + 1 < receiving_neighbors.size())
+        {
+            receiving_neighbors[position.receiving_] = receiving_neighbors.back();
+            couplings_.find(get_couplingKey(*receiving_neighbors[position.receiving_]))->second.receiving_ = position.receiving_;
+        }
+        receiving_neighbors.pop_back();
+    }
+
     void Coordinator::print_network() const
     {
         for( const auto& [id, info] : agents_ )
@@ -197,6 +258,56 @@ namespace grampcd
         return static_cast<unsigned int>(agents_.size());
     }
 
+    const std::vector< std::vector<int> > Coordinator::partition_network(const unsigned int number_of_partitions) const
+    {
+        std::vector< std::vector<int> > partitions;
+        if (number_of_partitions == 0 || agents_.empty())
+            return partitions;
+
+        // every partition is filled up to the same size, the last one takes the rest
+        const std::size_t partition_size = (agents_.size() + number_of_partitions - 1) / number_of_partitions;
+        std::map<unsigned int, bool> assigned;
+        for (const auto& [id, info] : agents_)
+            assigned[id] = false;
+
+        partitions.push_back(std::vector<int>());
+        for (const auto& [seed, seed_info] : agents_)
+        {
+            if (assigned[seed])
+                continue;
+
+            // grow the partition breadth-first along the couplings, so that coupled agents share a partition
+            std::deque<unsigned int> frontier(1, seed);
+            assigned[seed] = true;
+            while (!frontier.empty())
+            {
+                const unsigned int id = frontier.front();
+                frontier.pop_front();
+
+                if (partitions.back().size() >= partition_size && partitions.size() < number_of_partitions)
+                    partitions.push_back(std::vector<int>());
+                partitions.back().push_back(static_cast<int>(id));
+
+                const auto visit = [&assigned, &frontier](const int neighbor_id)
+                {
+                    const auto iterator = assigned.find(neighbor_id);
+                    if (iterator == assigned.end() || iterator->second)
+                        return;
+
+                    iterator->second = true;
+                    frontier.push_back(neighbor_id);
+                };
+
+                for (const auto& coupling : sending_neighbors_.at(id))
+                    visit(coupling->neighbor_id_);
+                for (const auto& coupling : receiving_neighbors_.at(id))
+                    visit(coupling->agent_id_);
+            }
+        }
+
+        return partitions;
+    }
+
     /*************************************************************************
      coordination of alternating direction method of multipliers
      *************************************************************************/
@@ -205,6 +316,12 @@ namespace grampcd
     {
         optimizationInfo_ = oi;
 
+        // bound the time each step may take
+        communication_interface_->set_stepTimeout(oi.ADMM_StepTimeout_);
+        communication_interface_->set_communicationTimeout(0);
+        solve_time_ = std::chrono::steady_clock::duration::zero();
+        number_of_iterations_ = 0;
+
         // initialize local solvers
         communication_interface_->configure_optimization(oi);
 
@@ -220,27 +337,34 @@ namespace grampcd
 
     void Coordinator::solve_ADMM(int outer_iterations, int inner_iterations)
     {
+        update_communicationTimeout();
+
         communication_interface_->trigger_step( ADMMStep::INITIALIZE );
 
+        iterate_ADMM(outer_iterations, inner_iterations);
+    }
+
+    void Coordinator::iterate_ADMM(int outer_iterations, int inner_iterations)
+    {
         for(int i = 0; i < outer_iterations; ++i)
         {
             for(int j = 0; j < inner_iterations; ++j)
             {
                 // solve local minimization problem for agent states
-                communication_interface_->trigger_step(ADMMStep::UPDATE_AGENT_STATE);
+                solve_step(ADMMStep::UPDATE_AGENT_STATE);
 
                 // send updated agent states to receiving neighbors
                 communication_interface_->trigger_step(ADMMStep::SEND_AGENT_STATE);
 
                 // solve local minimization problem for coupling states
-                communication_interface_->trigger_step(ADMMStep::UPDATE_COUPLING_STATE);
+                solve_step(ADMMStep::UPDATE_COUPLING_STATE);
 
                 // send updated coupling states to sending neighbors
                 communication_interface_->trigger_step(ADMMStep::SEND_COUPLING_STATE);
             }
 
             // solve local maximization problem for multiplier states
-            communication_interface_->trigger_step(ADMMStep::UPDATE_MULTIPLIER_STATE);
+            solve_step(ADMMStep::UPDATE_MULTIPLIER_STATE);
 
             // send updated multiplier states to receiving neighbors
             communication_interface_->trigger_step(ADMMStep::SEND_MULTIPLIER_STATE);
@@ -251,16 +375,54 @@ namespace grampcd
             // evaluate convergence
             ADMM_converged_ = true;
             communication_interface_->trigger_step(ADMMStep::SEND_CONVERGENCE_FLAG);
+            ++number_of_iterations_;
             if(ADMM_converged_)
                 break;
         }
     }
 
+    void Coordinator::solve_step(const ADMMStep step)
+    {
+        const auto tstart = std::chrono::steady_clock::now();
+        communication_interface_->trigger_step(step);
+        solve_time_ += std::chrono::steady_clock::now() - tstart;
+    }
+
+    void Coordinator::update_communicationTimeout()
+    {
+        // a configured deadline applies to all steps, and the first sampling step has no solve time yet
+        if (realtime_ && optimizationInfo_.ADMM_StepTimeout_ <= 0 && number_of_iterations_ > 0)
+        {
+            // The sampling time of an iteration, without the time to solve the local problems,
+            // is split among its communication steps. The next sampling step may need all iterations.
+            const auto solve_time = std::chrono::duration<typeRNum>(solve_time_).count() / number_of_iterations_;
+            const auto sampling_time = optimizationInfo_.COMMON_dt_ / std::max(1u, optimizationInfo_.ADMM_maxIterations_);
+            const auto number_of_communication_steps = 2 * optimizationInfo_.ADMM_innerIterations_ + 2;
+
+            // the deadline is at least one millisecond if the solve time exceeds the sampling time
+            const auto timeout = (sampling_time - solve_time) / number_of_communication_steps;
+            communication_interface_->set_communicationTimeout(std::max<typeRNum>(timeout, 1e-3));
+        }
+
+        solve_time_ = std::chrono::steady_clock::duration::zero();
+        number_of_iterations_ = 0;
+    }
+
+    const bool Coordinator::is_converged() const
+    {
+        return ADMM_converged_;
+    }
+
     void Coordinator::fromCommunication_received_convergenceFlag(bool converged, int from)
     {
         ADMM_converged_ = ADMM_converged_ && converged;
     }
 
+    void Coordinator::predict_states() const
+    {
+        communication_interface_->trigger_step(ADMMStep::PREDICT_STATE);
+    }
+
     void Coordinator::trigger_simulation(const std::string& Integrator, typeRNum dt) const
     {
         communication_interface_->trigger_simulation(Integrator, dt);
@@ -281,9 +443,19 @@ namespace grampcd
         return receiving_neighbors_;
     }
 
+    const unsigned int Coordinator::get_topologyVersion() const
+    {
+        return topology_version_;
+    }
+
     const OptimizationInfo& Coordinator::get_optimizationInfo() const
     {
         return optimizationInfo_;
     }
 
+    void Coordinator::set_realtime(const bool realtime)
+    {
+        realtime_ = realtime;
+    }
+
 }
@@ -27,9 +27,12 @@
 
 #include "grampcd/util/logging.hpp"
 #include "grampcd/util/data_conversion.hpp"
+#include "grampcd/util/solution_file.hpp"
+#include "grampcd/util/solution_stream.hpp"
 
 #include "chrono"
 #include <fstream>
+#include <future>
 
 namespace grampcd
 {
@@ -37,6 +40,11 @@ namespace grampcd
 		log_(std::make_shared<Logging>())
 	{}
 
+	DmpcInterface::~DmpcInterface()
+	{
+		stop();
+	}
+
 	void DmpcInterface::run_MPC(const std::vector<AgentPtr>& agents,
 		SimulatorPtr simulator,
 		const OptimizationInfo& oi,
@@ -46,6 +54,7 @@ namespace grampcd
 		SolverCentral solver(agents, oi);
 		const unsigned int maxSimIter = static_cast<unsigned int>(Tsim / oi.COMMON_dt_);
 		std::chrono::milliseconds CPUtime(0);
+		simulator->set_integratorOptions(oi.COMMON_IntegratorSubsteps_, oi.COMMON_IntegratorRelTol_, oi.COMMON_IntegratorAbsTol_);
 
 		// initialize agents
 		for (const auto& agent : agents)
@@ -54,24 +63,33 @@ namespace grampcd
 		// main loop for centralized solution
 		log_->print(DebugType::Base) << "MPC running ..." << std::endl;
 
-		for (unsigned int iMPC = 0; iMPC <= maxSimIter; ++iMPC)
+		std::chrono::milliseconds::rep CPUtime_max = 0;
+		unsigned int iMPC = 0;
+		for (; iMPC <= maxSimIter && !is_stopRequested_; ++iMPC)
 		{
 			// optimize
 			const auto tstart = std::chrono::steady_clock::now();
 			solver.solve();
 			const auto tend = std::chrono::steady_clock::now();
 			CPUtime += std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart);
+			CPUtime_max = std::max(CPUtime_max, std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart).count());
 
 			// update state and time
 			simulator->centralized_simulation(&solver, oi.COMMON_Integrator_, oi.COMMON_dt_);
 		}
+
+		// the loop may be stopped before the simulation time is reached
+		const auto number_of_steps = std::max(1u, iMPC);
+		average_computation_time_ = static_cast<typeRNum>(CPUtime.count()) / static_cast<typeRNum>(number_of_steps);
+		maximum_computation_time_ = static_cast<typeRNum>(CPUtime_max);
 		log_->print(DebugType::Base) << "MPC finished. Average computation time: "
-			<< static_cast<typeRNum>(static_cast<typeRNum>(CPUtime.count()) / static_cast<typeRNum>(maxSimIter + 1)) << " ms." << std::endl;
+			<< average_computation_time_ << " ms." << std::endl;
 	}
 
 	void DmpcInterface::run_MPC(const std::vector<AgentPtr>& agents, SimulatorPtr simulator, const OptimizationInfo& oi)
 	{
 		SolverCentral solver(agents, oi);
+		simulator->set_integratorOptions(oi.COMMON_IntegratorSubsteps_, oi.COMMON_IntegratorRelTol_, oi.COMMON_IntegratorAbsTol_);
 
 		// initialize agents
 		for (const auto& agent : agents)
@@ -82,7 +100,7 @@ namespace grampcd
 		log_->print(DebugType::Base) << "MPC running in endless mode." << std::endl;
 
 		// main loop for centralized solution
-		while (true)
+		while (!is_stopRequested_)
 		{
 			// optimize
 			const auto tstart = std::chrono::steady_clock::now();
@@ -112,51 +130,76 @@ namespace grampcd
 		std::chrono::milliseconds CPUtime(0);
 
 		// main loop for centralized solution
+		coordinator_->set_realtime(realtime_);
 		coordinator_->initialize_ADMM(oi);
 		log_->print(DebugType::Base) << "DMPC running ..." << std::endl;
 
 		simulator_->set_t0(t_0);
+		simulator->set_integratorOptions(oi.COMMON_IntegratorSubsteps_, oi.COMMON_IntegratorRelTol_, oi.COMMON_IntegratorAbsTol_);
 
 		std::chrono::milliseconds::rep CPUtime_max = 0;
+		bool is_started = false;
+		std::chrono::milliseconds CPUtime_firstIteration(0);
 
-		for (unsigned int iMPC = 0; iMPC <= maxSimIter; ++iMPC)
+		unsigned int iMPC = 0;
+		for (; iMPC <= maxSimIter && !is_stopRequested_; ++iMPC)
 		{
-			// optimize
+			// optimize, the first iteration of a pipelined step already ran during the simulation
 			const auto tstart = std::chrono::steady_clock::now();
-			coordinator_->solve_ADMM(oi.ADMM_maxIterations_, oi.ADMM_innerIterations_);
+			if (!is_started)
+				coordinator_->solve_ADMM(oi.ADMM_maxIterations_, oi.ADMM_innerIterations_);
+			else if (!coordinator_->is_converged())
+				coordinator_->iterate_ADMM(oi.ADMM_maxIterations_ - 1, oi.ADMM_innerIterations_);
 			const auto tend = std::chrono::steady_clock::now();
-			CPUtime += std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart);
-			CPUtime_max = std::max(CPUtime_max, std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart).count());
+			const auto CPUtime_step = std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart) + CPUtime_firstIteration;
+			CPUtime += CPUtime_step;
+			CPUtime_max = std::max(CPUtime_max, CPUtime_step.count());
 
 			// update state and time
-			simulator->distributed_simulation(oi.COMMON_Integrator_, oi.COMMON_dt_);
+			is_started = false;
+			CPUtime_firstIteration = std::chrono::milliseconds(0);
+			if (pipelined_ && iMPC < maxSimIter && !is_stopRequested_)
+				is_started = pipelined_simulation(simulator, oi, oi.COMMON_dt_, CPUtime_firstIteration);
+			else
+				simulator->distributed_simulation(oi.COMMON_Integrator_, oi.COMMON_dt_);
 		}
 
+		// the loop may be stopped before the simulation time is reached
+		const auto number_of_steps = std::max(1u, iMPC);
+		average_computation_time_ = static_cast<typeRNum>(CPUtime.count()) / static_cast<typeRNum>(number_of_steps);
+		maximum_computation_time_ = static_cast<typeRNum>(CPUtime_max);
 		log_->print(DebugType::Base) << "DMPC finished." << std::endl
 			<< "Maximum computation time : "
 			<< CPUtime_max << " ms in total or " << CPUtime_max / communication_interface_->get_numberOfAgents() << " ms per agent." << std::endl
 			<< "Average computation time : "
-			<< CPUtime.count() / static_cast<typeRNum>(maxSimIter + 1) << " ms in total or "
-			<< CPUtime.count() / static_cast<typeRNum>(maxSimIter + 1) / communication_interface_->get_numberOfAgents() << " ms per agent." << std::endl;
+			<< CPUtime.count() / static_cast<typeRNum>(number_of_steps) << " ms in total or "
+			<< CPUtime.count() / static_cast<typeRNum>(number_of_steps) / communication_interface_->get_numberOfAgents() << " ms per agent." << std::endl;
 	}
 
 	void DmpcInterface::run_DMPC(SimulatorPtr simulator, const OptimizationInfo& oi)
 	{
 		// main loop for centralized solution
+		coordinator_->set_realtime(realtime_);
 		coordinator_->initialize_ADMM(oi);
 
 		unsigned int CPUtime_iteration(0);
 		const unsigned int dt_in_ms = static_cast<unsigned int>(oi.COMMON_dt_ * 1000);
 
 		log_->print(DebugType::Base) << "DMPC running in endless mode..." << std::endl;
+		simulator->set_integratorOptions(oi.COMMON_IntegratorSubsteps_, oi.COMMON_IntegratorRelTol_, oi.COMMON_IntegratorAbsTol_);
 
-		while (true)
+		bool is_started = false;
+		std::chrono::milliseconds CPUtime_firstIteration(0);
+		while (!is_stopRequested_)
 		{
-			// optimize
+			// optimize, the first iteration of a pipelined step already ran during the simulation
 			const auto tstart = std::chrono::steady_clock::now();
-			coordinator_->solve_ADMM(oi.ADMM_maxIterations_, oi.ADMM_innerIterations_);
+			if (!is_started)
+				coordinator_->solve_ADMM(oi.ADMM_maxIterations_, oi.ADMM_innerIterations_);
+			else if (!coordinator_->is_converged())
+				coordinator_->iterate_ADMM(oi.ADMM_maxIterations_ - 1, oi.ADMM_innerIterations_);
 			const auto tend = std::chrono::steady_clock::now();
-			CPUtime_iteration = static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart).count());
+			CPUtime_iteration = static_cast<unsigned int>((std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart) + CPUtime_firstIteration).count());
 
 			// simulate real time
 			if (realtime_ && static_cast<int>(dt_in_ms - CPUtime_iteration) > 0)
@@ -170,14 +213,44 @@ namespace grampcd
 				simulate_timestep = oi.COMMON_dt_;
 
 			// update state and time
-			simulator->distributed_simulation(oi.COMMON_Integrator_, simulate_timestep);
+			is_started = false;
+			CPUtime_firstIteration = std::chrono::milliseconds(0);
+			if (pipelined_ && !is_stopRequested_)
+				is_started = pipelined_simulation(simulator, oi, simulate_timestep, CPUtime_firstIteration);
+			else
+				simulator->distributed_simulation(oi.COMMON_Integrator_, simulate_timestep);
 		}
 	}
 
-	void DmpcInterface::initialize_central_communicationInterface(int number_of_threads)
+	const bool DmpcInterface::pipelined_simulation(SimulatorPtr simulator, const OptimizationInfo& oi, typeRNum dt, std::chrono::milliseconds& CPUtime_firstIteration)
+	{
+		// the states are collected before the agents shift them
+		if (!simulator->collect_states(oi.COMMON_Integrator_, dt))
+			return false;
+
+		// agents continue with the shifted trajectories ...
+		coordinator_->predict_states();
+
+		// ... and run the first ADMM iteration of the next step while the simulation is computed
+		auto integration = std::async(std::launch::async, [&simulator]() { return simulator->integrate(); });
+		const auto tstart = std::chrono::steady_clock::now();
+		coordinator_->solve_ADMM(1, oi.ADMM_innerIterations_);
+		CPUtime_firstIteration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - tstart);
+
+		// the predicted states are corrected once the simulated states arrive
+		if (integration.get())
+			simulator->send_simulatedStates();
+		else
+			log_->print(DebugType::Error) << "[DmpcInterface::pipelined_simulation] "
+				<< "Simulation failed, hence the agents continue with their predicted states." << std::endl;
+
+		return true;
+	}
+
+	void DmpcInterface::initialize_central_communicationInterface(int number_of_threads, bool zero_copy)
 	{
 		// create communication interface
-		CommunicationInterfacePtr communication_interface(new CommunicationInterfaceCentral(log_, number_of_threads));
+		CommunicationInterfacePtr communication_interface(new CommunicationInterfaceCentral(log_, number_of_threads, zero_copy));
 		communication_interface_ = communication_interface;
 
 		// create coordinator
@@ -196,19 +269,19 @@ namespace grampcd
 		factory_ = ModelFactoryPtr(new GeneralModelFactory(log_));
 	}
 
-	void DmpcInterface::initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator)
+	void DmpcInterface::initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator, int number_of_threads)
 	{
 		// create communication interface
-		communication_interface_ = CommunicationInterfacePtr(new CommunicationInterfaceLocal(log_, adress_coordinator));
+		communication_interface_ = CommunicationInterfacePtr(new CommunicationInterfaceLocal(log_, adress_coordinator, number_of_threads));
 
 		// create factory
 		factory_ = ModelFactoryPtr(new GeneralModelFactory(log_));
 	}
 
-	void DmpcInterface::initialize_local_communicationInterface_as_coordinator(unsigned short port)
+	void DmpcInterface::initialize_local_communicationInterface_as_coordinator(unsigned short port, int number_of_threads)
 	{
 		// create communication interface
-		communication_interface_ = CommunicationInterfacePtr(new CommunicationInterfaceLocal(log_, port));
+		communication_interface_ = CommunicationInterfacePtr(new CommunicationInterfaceLocal(log_, port, number_of_threads));
 
 		// create coordinator
 		coordinator_ = CoordinatorPtr(new Coordinator(communication_interface_, true, log_));
@@ -226,6 +299,15 @@ namespace grampcd
 		factory_ = ModelFactoryPtr(new GeneralModelFactory(log_));
 	}
 
+	void DmpcInterface::initialize_local_communicationInterface_as_subCoordinator(CommunicationInfo adress_coordinator, unsigned short port, int number_of_threads)
+	{
+		// create communication interface
+		communication_interface_ = CommunicationInterfacePtr(new CommunicationInterfaceLocal(log_, adress_coordinator, port, number_of_threads));
+
+		// create factory
+		factory_ = ModelFactoryPtr(new GeneralModelFactory(log_));
+	}
+
 	void DmpcInterface::register_agent(AgentInfo info, std::vector<typeRNum> x_init, std::vector<typeRNum> u_init)
 	{
 		if (info.id_ < 0)
@@ -237,7 +319,9 @@ namespace grampcd
 		}
 
 		// create new agent
-		AgentPtr agent = std::make_shared<Agent>(Agent(communication_interface_, factory_, info, log_));
+		AgentPtr agent = std::make_shared<Agent>(communication_interface_, factory_, info, log_);
+		if (solution_stream_ != nullptr)
+			agent->set_solutionStream(solution_stream_);
 
 		// register agent
 		communication_interface_->register_agent(agent);
@@ -270,24 +354,92 @@ namespace grampcd
 		communication_interface_->register_coupling(info);
 	}
 
+	void DmpcInterface::register_couplings(std::vector<CouplingInfo> infos)
+	{
+		communication_interface_->register_couplings(infos);
+	}
+
 	void DmpcInterface::run_MPC(typeRNum t_0, typeRNum Tsim)
 	{
-		run_MPC(agents_, simulator_, optimizationInfo_, Tsim, t_0);
+		run_controlLoop([this, t_0, Tsim]() { run_MPC(agents_, simulator_, optimizationInfo_, Tsim, t_0); });
 	}
 
 	void DmpcInterface::run_MPC()
 	{
-		run_MPC(agents_, simulator_, optimizationInfo_);
+		run_controlLoop([this]() { run_MPC(agents_, simulator_, optimizationInfo_); });
 	}
 
 	void DmpcInterface::run_DMPC(typeRNum t_0, typeRNum Tsim)
 	{
-		run_DMPC(simulator_, optimizationInfo_, Tsim, t_0);
+		run_controlLoop([this, t_0, Tsim]() { run_DMPC(simulator_, optimizationInfo_, Tsim, t_0); });
 	}
 
 	void DmpcInterface::run_DMPC()
 	{
-		run_DMPC(simulator_, optimizationInfo_);
+		run_controlLoop([this]() { run_DMPC(simulator_, optimizationInfo_); });
+	}
+
+	void DmpcInterface::start_DMPC(typeRNum t_0, typeRNum Tsim)
+	{
+		start_controlLoop([this, t_0, Tsim]() { run_DMPC(simulator_, optimizationInfo_, Tsim, t_0); });
+	}
+
+	void DmpcInterface::start_DMPC()
+	{
+		start_controlLoop([this]() { run_DMPC(simulator_, optimizationInfo_); });
+	}
+
+	void DmpcInterface::run_controlLoop(const std::function<void()>& control_loop)
+	{
+		if (!set_running())
+			return;
+
+		is_stopRequested_ = false;
+		control_loop();
+		is_running_ = false;
+	}
+
+	void DmpcInterface::start_controlLoop(const std::function<void()>& control_loop)
+	{
+		if (!set_running())
+			return;
+
+		// the thread of a finished controller is still joinable
+		if (control_loop_.joinable())
+			control_loop_.join();
+
+		// the flags are set before the thread starts, such that a stop right after the start is not lost
+		is_stopRequested_ = false;
+		control_loop_ = std::thread([this, control_loop]()
+			{
+				control_loop();
+				is_running_ = false;
+			});
+	}
+
+	const bool DmpcInterface::set_running()
+	{
+		// several threads may start a controller at the same time
+		bool is_running = false;
+		if (is_running_.compare_exchange_strong(is_running, true))
+			return true;
+
+		log_->print(DebugType::Error) << "[DmpcInterface::set_running] "
+			<< "A controller is running already." << std::endl;
+		return false;
+	}
+
+	const bool DmpcInterface::poll() const
+	{
+		return is_running_;
+	}
+
+	void DmpcInterface::stop()
+	{
+		is_stopRequested_ = true;
+
+		if (control_loop_.joinable() && control_loop_.get_id() != std::this_thread::get_id())
+			control_loop_.join();
 	}
 
 	SolutionPtr DmpcInterface::get_solution(unsigned int agent_id) const
@@ -300,6 +452,16 @@ namespace grampcd
 		return communication_interface_->get_solution(agents);
 	}
 
+	SolutionPtr DmpcInterface::get_solution_since(unsigned int agent_id, unsigned int index) const
+	{
+		return communication_interface_->get_solution_since(agent_id, index);
+	}
+
+	std::vector< SolutionPtr > DmpcInterface::get_solution_since(std::string agents, std::map<int, unsigned int> indices) const
+	{
+		return communication_interface_->get_solution_since(agents, indices);
+	}
+
 	void DmpcInterface::reset_solution(unsigned int agent_id)
 	{
 		communication_interface_->reset_solution(agent_id);
@@ -325,6 +487,11 @@ namespace grampcd
 		communication_interface_->waitFor_connection(agents, couplings);
 	}
 
+	void DmpcInterface::wait_for_subCoordinators(int number)
+	{
+		communication_interface_->waitFor_subCoordinators(number);
+	}
+
 	void DmpcInterface::set_passive()
 	{
 		communication_interface_->set_passive();
@@ -365,11 +532,56 @@ namespace grampcd
 		realtime_ = realtime;
 	}
 
+	void DmpcInterface::pipeline_steps(bool pipelined)
+	{
+		pipelined_ = pipelined;
+	}
+
+	void DmpcInterface::parallelize_simulation(unsigned int number_of_threads)
+	{
+		if (simulator_ == nullptr)
+		{
+			log_->print(DebugType::Warning) << "[DmpcInterface::parallelize_simulation] "
+				<< "Only the coordinator simulates the system." << std::endl;
+			return;
+		}
+
+		simulator_->set_numberOfThreads(number_of_threads);
+	}
+
 	void DmpcInterface::cap_stored_data(unsigned int data_points)
 	{
 		communication_interface_->cap_stored_data(data_points);
 	}
 
+	void DmpcInterface::stream_solution_to_file(const std::string prefix, unsigned int queue_capacity)
+	{
+		stop_solution_stream();
+
+		solution_stream_ = std::make_shared<SolutionStream>(log_, prefix, queue_capacity);
+		communication_interface_->set_solutionStream(solution_stream_);
+	}
+
+	void DmpcInterface::stop_solution_stream()
+	{
+		if (solution_stream_ == nullptr)
+			return;
+
+		communication_interface_->set_solutionStream(nullptr);
+		solution_stream_->stop();
+		solution_stream_.reset();
+	}
+
+	typeRNum DmpcInterface::get_averageComputationTime() const
+	{
+		return average_computation_time_;
+	}
+
+	typeRNum DmpcInterface::get_maximumComputationTime() const
+	{
+		return maximum_computation_time_;
+	}
+
 	void DmpcInterface::set_print_base(bool print)
 	{
 		log_->set_print_base(print);
@@ -429,6 +641,33 @@ namespace grampcd
 		}
 	}
 
+	void DmpcInterface::print_solution_to_binaryFile(const unsigned int agent_id, const std::string prefix) const
+	{
+		const std::string filename = prefix + std::to_string(agent_id) + ".bin";
+
+		// get solution
+		const auto solution = communication_interface_->get_solution(agent_id);
+
+		if (solution == nullptr || !SolutionFile::write(*solution, filename))
+			log_->print(DebugType::Error) << "[DmpcInterface::print_solution_to_binaryFile] "
+			<< "Failed to write file " << filename << "." << std::endl;
+	}
+
+	void DmpcInterface::print_solution_to_binaryFile(const std::string agents, const std::string prefix) const
+	{
+		// get solutions
+		const auto solutions = communication_interface_->get_solution(agents);
+
+		for (const auto& solution : solutions)
+		{
+			const std::string filename = prefix + std::to_string(solution->agentState_.i_) + ".bin";
+
+			if (!SolutionFile::write(*solution, filename))
+				log_->print(DebugType::Error) << "[DmpcInterface::print_solution_to_binaryFile] "
+				<< "Failed to write file " << filename << "." << std::endl;
+		}
+	}
+
 	AgentInfo DmpcInterface::agentInfo() const
 	{
 		return AgentInfo();
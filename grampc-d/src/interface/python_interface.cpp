@@ -11,36 +11,159 @@
  */
 
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include <grampcd/interface/python_interface.hpp>
 #include "grampcd/interface/dmpc_interface.hpp"
+#include "grampcd/interface/scenario_runner.hpp"
 
 #include "grampcd/state/agent_state.hpp"
 
 #include "grampcd/optim/solution.hpp"
 
+#include "grampcd/util/solution_file.hpp"
+
+#include <algorithm>
+#include <limits>
+
 namespace grampcd
 {
 	namespace py = pybind11;
 
+	namespace
+	{
+		/*Returns a read-only NumPy view on the values in row-major order, which keeps the owner alive.*/
+		py::array make_view(const std::vector<typeRNum>& values, const std::vector<std::size_t>& shape, const py::handle owner)
+		{
+			std::vector<std::size_t> strides(shape.size(), sizeof(typeRNum));
+			for (std::size_t k = shape.size() - 1; k > 0; --k)
+				strides[k - 1] = strides[k] * shape[k];
+
+			py::array view(py::dtype::of<typeRNum>(), shape, strides, values.data(), owner);
+			view.attr("setflags")(py::arg("write") = false);
+			return view;
+		}
+
+		/*Returns a view on the values of an agent state with one row per time step.*/
+		py::array make_view(const py::object& self, const std::vector<typeRNum> AgentState::* member)
+		{
+			const auto& state = self.cast<const AgentState&>();
+			const auto& values = state.*member;
+
+			// the columns are given by the dimension of the state, or of the control
+			const auto rows = state.t_.size();
+			const auto Nx = rows > 0 ? state.x_.size() / rows : 0;
+			const auto columns = member == &AgentState::u_ ? (rows > 0 ? values.size() / rows : 0) : Nx;
+
+			return make_view(values, { columns > 0 ? values.size() / columns : 0, columns }, self);
+		}
+
+		/*Returns a NumPy array that takes ownership of the values.*/
+		py::array make_array(std::vector<typeRNum> values)
+		{
+			const auto owner = new std::vector<typeRNum>(std::move(values));
+			const py::capsule capsule(owner, [](void* p) { delete static_cast<std::vector<typeRNum>*>(p); });
+			return py::array(owner->size(), owner->data(), capsule);
+		}
+
+		/*Stack the simulated solutions of several agents into arrays with the agents as first axis.
+		Shorter histories and smaller dimensions are padded with NaN.*/
+		py::dict stack_solutions(const std::vector<SolutionPtr>& solutions)
+		{
+			const std::size_t number_of_agents = solutions.size();
+			std::size_t rows = 0;
+			std::size_t Nx = 0;
+			std::size_t Nu = 0;
+
+			for (const auto& solution : solutions)
+			{
+				if (solution == nullptr || solution->get_numberOfDataPoints() == 0)
+					continue;
+
+				const std::size_t number_of_data_points = solution->get_numberOfDataPoints();
+				rows = std::max(rows, number_of_data_points);
+				Nx = std::max(Nx, solution->agentState_.x_.size() / number_of_data_points);
+				Nu = std::max(Nu, solution->agentState_.u_.size() / number_of_data_points);
+			}
+
+			const auto nan = std::numeric_limits<typeRNum>::quiet_NaN();
+			py::array_t<int> agent_id(number_of_agents);
+			py::array_t<typeRNum> t(std::vector<std::size_t>{ number_of_agents, rows });
+			py::array_t<typeRNum> x(std::vector<std::size_t>{ number_of_agents, rows, Nx });
+			py::array_t<typeRNum> u(std::vector<std::size_t>{ number_of_agents, rows, Nu });
+			py::array_t<typeRNum> cost(std::vector<std::size_t>{ number_of_agents, rows });
+
+			std::fill(t.mutable_data(), t.mutable_data() + t.size(), nan);
+			std::fill(x.mutable_data(), x.mutable_data() + x.size(), nan);
+			std::fill(u.mutable_data(), u.mutable_data() + u.size(), nan);
+			std::fill(cost.mutable_data(), cost.mutable_data() + cost.size(), nan);
+
+			auto agent_id_view = agent_id.mutable_unchecked<1>();
+			auto t_view = t.mutable_unchecked<2>();
+			auto x_view = x.mutable_unchecked<3>();
+			auto u_view = u.mutable_unchecked<3>();
+			auto cost_view = cost.mutable_unchecked<2>();
+
+			// the ring buffers are read in chronological order without intermediate copies
+			for (std::size_t i = 0; i < number_of_agents; ++i)
+			{
+				const auto& solution = solutions[i];
+				agent_id_view(i) = solution != nullptr ? solution->agentState_.i_ : -1;
+				if (solution == nullptr || solution->get_numberOfDataPoints() == 0)
+					continue;
+
+				const auto& state = solution->agentState_;
+				const std::size_t number_of_data_points = solution->get_numberOfDataPoints();
+				const auto Nxi = state.x_.size() / number_of_data_points;
+				const auto Nui = state.u_.size() / number_of_data_points;
+
+				for (std::size_t k = 0; k < number_of_data_points; ++k)
+				{
+					const std::size_t j = solution->get_dataPoint(static_cast<unsigned int>(k));
+
+					t_view(i, k) = state.t_[j];
+					for (std::size_t l = 0; l < Nxi; ++l)
+						x_view(i, k, l) = state.x_[j * Nxi + l];
+					for (std::size_t l = 0; l < Nui; ++l)
+						u_view(i, k, l) = state.u_[j * Nui + l];
+					if (j < solution->cost_.size())
+						cost_view(i, k) = solution->cost_[j];
+				}
+			}
+
+			py::dict arrays;
+			arrays["agent_id"] = agent_id;
+			arrays["t"] = t;
+			arrays["x"] = x;
+			arrays["u"] = u;
+			arrays["cost"] = cost;
+			return arrays;
+		}
+	}
+
 	PythonInterface::PythonInterface()
 		: dmpc_interface_(std::make_shared<DmpcInterface>())
 	{}
 
-	void PythonInterface::initialize_central_communicationInterface(int number_of_threads)
+	void PythonInterface::initialize_central_communicationInterface(int number_of_threads, bool zero_copy)
+	{
+		dmpc_interface_->initialize_central_communicationInterface(number_of_threads, zero_copy);
+	}
+
+	void PythonInterface::initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator, int number_of_threads)
 	{
-		dmpc_interface_->initialize_central_communicationInterface(number_of_threads);
+		dmpc_interface_->initialize_local_communicationInterface_as_agent(adress_coordinator, number_of_threads);
 	}
 
-	void PythonInterface::initialize_local_communicationInterface_as_agent(CommunicationInfo adress_coordinator)
+	void PythonInterface::initialize_local_communicationInterface_as_coordinator(unsigned short port, int number_of_threads)
 	{
-		dmpc_interface_->initialize_local_communicationInterface_as_agent(adress_coordinator);
+		dmpc_interface_->initialize_local_communicationInterface_as_coordinator(port, number_of_threads);
 	}
 
-	void PythonInterface::initialize_local_communicationInterface_as_coordinator(unsigned short port)
+	void PythonInterface::initialize_local_communicationInterface_as_subCoordinator(CommunicationInfo adress_coordinator, unsigned short port, int number_of_threads)
 	{
-		dmpc_interface_->initialize_local_communicationInterface_as_coordinator(port);
+		dmpc_interface_->initialize_local_communicationInterface_as_subCoordinator(adress_coordinator, port, number_of_threads);
 	}
 
 	void PythonInterface::register_agent(AgentInfo info, std::vector<typeRNum> x_init, std::vector<typeRNum> u_init)
@@ -58,6 +181,11 @@ namespace grampcd
 		dmpc_interface_->register_coupling(info);
 	}
 
+	void PythonInterface::register_couplings(std::vector<CouplingInfo> infos)
+	{
+		dmpc_interface_->register_couplings(infos);
+	}
+
 	void PythonInterface::run_MPC(typeRNum Tsim, typeRNum t0)
 	{
 		dmpc_interface_->run_MPC(Tsim, t0);
@@ -78,6 +206,26 @@ namespace grampcd
 		dmpc_interface_->run_DMPC();
 	}
 
+	void PythonInterface::start_DMPC(typeRNum t_0, typeRNum Tsim)
+	{
+		dmpc_interface_->start_DMPC(t_0, Tsim);
+	}
+
+	void PythonInterface::start_DMPC()
+	{
+		dmpc_interface_->start_DMPC();
+	}
+
+	const bool PythonInterface::poll() const
+	{
+		return dmpc_interface_->poll();
+	}
+
+	void PythonInterface::stop()
+	{
+		dmpc_interface_->stop();
+	}
+
 	SolutionPtr PythonInterface::get_solution(unsigned int agent_id) const
 	{
 		return dmpc_interface_->get_solution(agent_id);
@@ -88,6 +236,16 @@ namespace grampcd
 		return dmpc_interface_->get_solution(agents);
 	}
 
+	SolutionPtr PythonInterface::get_solution_since(unsigned int agent_id, unsigned int index) const
+	{
+		return dmpc_interface_->get_solution_since(agent_id, index);
+	}
+
+	std::vector< SolutionPtr > PythonInterface::get_solution_since(std::string agents, std::map<int, unsigned int> indices) const
+	{
+		return dmpc_interface_->get_solution_since(agents, indices);
+	}
+
 	void PythonInterface::reset_solution(unsigned int agent_id)
 	{
 		dmpc_interface_->reset_solution(agent_id);
@@ -113,6 +271,11 @@ namespace grampcd
 		dmpc_interface_->wait_for_connections(agents, couplings);
 	}
 
+	void PythonInterface::wait_for_subCoordinators(int number)
+	{
+		dmpc_interface_->wait_for_subCoordinators(number);
+	}
+
 	void PythonInterface::set_passive()
 	{
 		dmpc_interface_->set_passive();
@@ -153,6 +316,16 @@ namespace grampcd
 		dmpc_interface_->simulate_realtime(realtime);
 	}
 
+	void PythonInterface::pipeline_steps(bool pipelined)
+	{
+		dmpc_interface_->pipeline_steps(pipelined);
+	}
+
+	void PythonInterface::parallelize_simulation(unsigned int number_of_threads)
+	{
+		dmpc_interface_->parallelize_simulation(number_of_threads);
+	}
+
 	void PythonInterface::deregister_agent(AgentInfo info)
 	{
 		dmpc_interface_->deregister_agent(info);
@@ -163,6 +336,16 @@ namespace grampcd
 		dmpc_interface_->cap_stored_data(data_points);
 	}
 
+	void PythonInterface::stream_solution_to_file(const std::string prefix, unsigned int queue_capacity)
+	{
+		dmpc_interface_->stream_solution_to_file(prefix, queue_capacity);
+	}
+
+	void PythonInterface::stop_solution_stream()
+	{
+		dmpc_interface_->stop_solution_stream();
+	}
+
 	void PythonInterface::set_print_base(bool print)
 	{
 		dmpc_interface_->set_print_base(print);
@@ -193,6 +376,16 @@ namespace grampcd
 		dmpc_interface_->print_solution_to_file(agents, prefix);
 	}
 
+	void PythonInterface::print_solution_to_binaryFile(const unsigned int agent_id, const std::string prefix) const
+	{
+		dmpc_interface_->print_solution_to_binaryFile(agent_id, prefix);
+	}
+
+	void PythonInterface::print_solution_to_binaryFile(const std::string agents, const std::string prefix) const
+	{
+		dmpc_interface_->print_solution_to_binaryFile(agents, prefix);
+	}
+
 	void PythonInterface::set_initialState(const unsigned int agent_id, const std::vector<typeRNum>& x_init)
 	{
 		dmpc_interface_->set_initialState(agent_id, x_init);
@@ -200,55 +393,95 @@ namespace grampcd
 
 	PYBIND11_MODULE(grampcd_interface, m) {
 
+		// the trajectories are read-only NumPy views on the agent state, x_, u_ and v_ are flat,
+		// while get_x, get_u and get_v return one row per time step
 		py::class_<AgentState>(m, "AgentState")
 			.def(py::init<>())
 			.def_readonly("i_", &AgentState::i_)
 			.def_readonly("t0_", &AgentState::t0_)
-			.def_readonly("t_", &AgentState::t_)
-			.def_readonly("u_", &AgentState::u_)
-			.def_readonly("v_", &AgentState::v_)
-			.def_readonly("x_", &AgentState::x_);
-
+			.def_property_readonly("t_", [](const py::object& self) { const auto& t = self.cast<const AgentState&>().t_; return make_view(t, { t.size() }, self); })
+			.def_property_readonly("u_", [](const py::object& self) { const auto& u = self.cast<const AgentState&>().u_; return make_view(u, { u.size() }, self); })
+			.def_property_readonly("v_", [](const py::object& self) { const auto& v = self.cast<const AgentState&>().v_; return make_view(v, { v.size() }, self); })
+			.def_property_readonly("x_", [](const py::object& self) { const auto& x = self.cast<const AgentState&>().x_; return make_view(x, { x.size() }, self); })
+			.def("get_x", [](const py::object& self) { return make_view(self, &AgentState::x_); })
+			.def("get_u", [](const py::object& self) { return make_view(self, &AgentState::u_); })
+			.def("get_v", [](const py::object& self) { return make_view(self, &AgentState::v_); });
+
+		// the agents may update a solution while it is read, hence the views refer to snapshots of it
 		py::class_<Solution, std::shared_ptr<Solution>>(m, "Solution")
 			.def(py::init<>())
-			.def_readonly("agentState_", &Solution::agentState_)
-			.def_readonly("predicted_agentState_", &Solution::predicted_agentState_)
-			.def_readonly("cost_", &Solution::cost_)
-			.def_readonly("predicted_cost_", &Solution::predicted_cost_)
-			.def_readonly("debug_cost_", &Solution::debug_cost_);
+			.def_property_readonly("agentState_", &Solution::get_agentState)
+			.def_property_readonly("predicted_agentState_", [](const Solution& solution) { return solution.predicted_agentState_; })
+			.def_property_readonly("cost_", [](const Solution& solution) { return make_array(solution.get_cost()); })
+			.def_property_readonly("predicted_cost_", [](const Solution& solution) { return make_array(solution.predicted_cost_); })
+			.def_property_readonly("debug_cost_", [](const Solution& solution) { return make_array(solution.debug_cost_); })
+			.def("get_indexOfFirstDataPoint", &Solution::get_indexOfFirstDataPoint)
+			.def("get_nextIndex", &Solution::get_nextIndex);
+
+		// reader for the files of print_solution_to_binaryFile, returns None if the file cannot be read
+		m.def("read_solution_from_binaryFile", &SolutionFile::read, py::arg("filename"));
+
+		// arrays of several solutions with the agents as first axis
+		m.def("stack_solutions", &stack_solutions, py::arg("solutions"));
 
 		py::class_<PythonInterface>(m, "interface")
 			.def(py::init<>())
-			.def("initialize_central_communicationInterface", &PythonInterface::initialize_central_communicationInterface, py::arg("number_of_threads") = 0)
-			.def("initialize_local_communicationInterface_as_agent", &PythonInterface::initialize_local_communicationInterface_as_agent)
-			.def("initialize_local_communicationInterface_as_coordinator", &PythonInterface::initialize_local_communicationInterface_as_coordinator)
+			.def("initialize_central_communicationInterface", &PythonInterface::initialize_central_communicationInterface, py::arg("number_of_threads") = 0, py::arg("zero_copy") = false)
+			.def("initialize_local_communicationInterface_as_agent", &PythonInterface::initialize_local_communicationInterface_as_agent, py::arg("adress_coordinator"), py::arg("number_of_threads") = 0)
+			.def("initialize_local_communicationInterface_as_coordinator", &PythonInterface::initialize_local_communicationInterface_as_coordinator, py::arg("port"), py::arg("number_of_threads") = 0)
+			.def("initialize_local_communicationInterface_as_subCoordinator", &PythonInterface::initialize_local_communicationInterface_as_subCoordinator, py::arg("adress_coordinator"), py::arg("port"), py::arg("number_of_threads") = 0)
 			.def("register_agent", &PythonInterface::register_agent)
 			.def("deregister_agent", &PythonInterface::deregister_agent)
 			.def("set_desiredAgentState", &PythonInterface::set_desiredAgentState)
 			.def("set_initialState", &PythonInterface::set_initialState)
 			.def("register_coupling", &PythonInterface::register_coupling)
+			.def("register_couplings", &PythonInterface::register_couplings)
 			.def("deregister_coupling", &PythonInterface::deregister_coupling)
-			.def("run_MPC", (void (PythonInterface::*)(void)) & PythonInterface::run_MPC)
-			.def("run_MPC", (void (PythonInterface::*)(typeRNum, typeRNum)) & PythonInterface::run_MPC)
-			.def("run_DMPC", (void (PythonInterface::*)(void)) & PythonInterface::run_DMPC)
-			.def("run_DMPC", (void (PythonInterface::*)(typeRNum, typeRNum)) & PythonInterface::run_DMPC)
+			.def("run_MPC", (void (PythonInterface::*)(void)) & PythonInterface::run_MPC, py::call_guard<py::gil_scoped_release>())
+			.def("run_MPC", (void (PythonInterface::*)(typeRNum, typeRNum)) & PythonInterface::run_MPC, py::call_guard<py::gil_scoped_release>())
+			.def("run_DMPC", (void (PythonInterface::*)(void)) & PythonInterface::run_DMPC, py::call_guard<py::gil_scoped_release>())
+			.def("run_DMPC", (void (PythonInterface::*)(typeRNum, typeRNum)) & PythonInterface::run_DMPC, py::call_guard<py::gil_scoped_release>())
+			.def("start_DMPC", (void (PythonInterface::*)(void)) & PythonInterface::start_DMPC, py::call_guard<py::gil_scoped_release>())
+			.def("start_DMPC", (void (PythonInterface::*)(typeRNum, typeRNum)) & PythonInterface::start_DMPC, py::call_guard<py::gil_scoped_release>())
+			.def("poll", &PythonInterface::poll)
+			.def("stop", &PythonInterface::stop, py::call_guard<py::gil_scoped_release>())
 			.def("set_optimizationInfo", &PythonInterface::set_optimizationInfo)
 			.def("get_optimizationInfo", &PythonInterface::get_optimizationInfo)
-			.def("wait_for_connections", &PythonInterface::wait_for_connections)
+			.def("wait_for_connections", &PythonInterface::wait_for_connections, py::call_guard<py::gil_scoped_release>())
+			.def("wait_for_subCoordinators", &PythonInterface::wait_for_subCoordinators, py::call_guard<py::gil_scoped_release>())
 			.def("send_flag_to_agents", (void (PythonInterface::*)(int) const) & PythonInterface::send_flag_to_agents)
 			.def("send_flag_to_agents", (void (PythonInterface::*)(std::vector<int>) const) & PythonInterface::send_flag_to_agents)
 			.def("send_flag_to_agents", (void (PythonInterface::*)(std::string) const) & PythonInterface::send_flag_to_agents)
-			.def("wait_blocking_s", &PythonInterface::wait_blocking_s)
-			.def("waitFor_flag_from_coordinator", &PythonInterface::waitFor_flag_from_coordinator)
-			.def("set_passive", &PythonInterface::set_passive)
-			.def("get_solution", (SolutionPtr(PythonInterface::*)(unsigned int) const) & PythonInterface::get_solution)
-			.def("get_solution", (std::vector< SolutionPtr >(PythonInterface::*)(std::string) const) & PythonInterface::get_solution)
+			.def("wait_blocking_s", &PythonInterface::wait_blocking_s, py::call_guard<py::gil_scoped_release>())
+			.def("waitFor_flag_from_coordinator", &PythonInterface::waitFor_flag_from_coordinator, py::call_guard<py::gil_scoped_release>())
+			.def("set_passive", &PythonInterface::set_passive, py::call_guard<py::gil_scoped_release>())
+			.def("get_solution", (SolutionPtr(PythonInterface::*)(unsigned int) const) & PythonInterface::get_solution, py::call_guard<py::gil_scoped_release>())
+			.def("get_solution", (std::vector< SolutionPtr >(PythonInterface::*)(std::string) const) & PythonInterface::get_solution, py::call_guard<py::gil_scoped_release>())
+			.def("get_solution_arrays", [](const PythonInterface& self, const std::string& agents)
+				{
+					std::vector<SolutionPtr> solutions;
+					{
+						py::gil_scoped_release release;
+						solutions = self.get_solution(agents);
+					}
+					return stack_solutions(solutions);
+				}, py::arg("agents") = "all")
+			.def("get_solution_since", (SolutionPtr(PythonInterface::*)(unsigned int, unsigned int) const) & PythonInterface::get_solution_since,
+				py::arg("agent_id"), py::arg("index"), py::call_guard<py::gil_scoped_release>())
+			.def("get_solution_since", (std::vector< SolutionPtr >(PythonInterface::*)(std::string, std::map<int, unsigned int>) const) & PythonInterface::get_solution_since,
+				py::arg("agents"), py::arg("indices"), py::call_guard<py::gil_scoped_release>())
 			.def("reset_solution", (void(PythonInterface::*)(unsigned int)) & PythonInterface::reset_solution)
 			.def("reset_solution", (void(PythonInterface::*)(std::string)) & PythonInterface::reset_solution)
-			.def("print_solution_to_file", (void(PythonInterface::*)(const unsigned int, const std::string) const) & PythonInterface::print_solution_to_file, py::arg("agent_id"), py::arg("prefix") = "Solution_agent")
-			.def("print_solution_to_file", (void(PythonInterface::*)(const std::string, const std::string) const) & PythonInterface::print_solution_to_file, py::arg("agents"), py::arg("prefix") = "Solution_agent")
+			.def("print_solution_to_file", (void(PythonInterface::*)(const unsigned int, const std::string) const) & PythonInterface::print_solution_to_file, py::arg("agent_id"), py::arg("prefix") = "Solution_agent", py::call_guard<py::gil_scoped_release>())
+			.def("print_solution_to_file", (void(PythonInterface::*)(const std::string, const std::string) const) & PythonInterface::print_solution_to_file, py::arg("agents"), py::arg("prefix") = "Solution_agent", py::call_guard<py::gil_scoped_release>())
+			.def("print_solution_to_binaryFile", (void(PythonInterface::*)(const unsigned int, const std::string) const) & PythonInterface::print_solution_to_binaryFile, py::arg("agent_id"), py::arg("prefix") = "Solution_agent", py::call_guard<py::gil_scoped_release>())
+			.def("print_solution_to_binaryFile", (void(PythonInterface::*)(const std::string, const std::string) const) & PythonInterface::print_solution_to_binaryFile, py::arg("agents"), py::arg("prefix") = "Solution_agent", py::call_guard<py::gil_scoped_release>())
 			.def("simulate_realtime", &PythonInterface::simulate_realtime)
+			.def("pipeline_steps", &PythonInterface::pipeline_steps)
+			.def("parallelize_simulation", &PythonInterface::parallelize_simulation)
 			.def("cap_stored_data", &PythonInterface::cap_stored_data)
+			.def("stream_solution_to_file", &PythonInterface::stream_solution_to_file, py::arg("prefix") = "Solution_agent", py::arg("queue_capacity") = 1000)
+			.def("stop_solution_stream", &PythonInterface::stop_solution_stream, py::call_guard<py::gil_scoped_release>())
 			.def("set_print_base", &PythonInterface::set_print_base)
 			.def("set_print_error", &PythonInterface::set_print_error)
 			.def("set_print_message", &PythonInterface::set_print_message)
@@ -284,6 +517,9 @@ namespace grampcd
 			.def_readwrite("COMMON_Nhor_", &OptimizationInfo::COMMON_Nhor_)
 			.def_readwrite("COMMON_ShiftControl_", &OptimizationInfo::COMMON_ShiftControl_)
 			.def_readwrite("COMMON_Integrator_", &OptimizationInfo::COMMON_Integrator_)
+			.def_readwrite("COMMON_IntegratorSubsteps_", &OptimizationInfo::COMMON_IntegratorSubsteps_)
+			.def_readwrite("COMMON_IntegratorRelTol_", &OptimizationInfo::COMMON_IntegratorRelTol_)
+			.def_readwrite("COMMON_IntegratorAbsTol_", &OptimizationInfo::COMMON_IntegratorAbsTol_)
 
 			// parameters for GRAMPC
 			.def_readwrite("GRAMPC_MaxGradIter_", &OptimizationInfo::GRAMPC_MaxGradIter_)
@@ -314,10 +550,55 @@ namespace grampcd
 			.def_readwrite("ADMM_AdaptPenaltyParameter_", &OptimizationInfo::ADMM_AdaptPenaltyParameter_)
 			.def_readwrite("ADMM_innerIterations_", &OptimizationInfo::ADMM_innerIterations_)
 			.def_readwrite("ADMM_DebugCost_", &OptimizationInfo::ADMM_DebugCost_)
+			.def_readwrite("ADMM_StepTimeout_", &OptimizationInfo::ADMM_StepTimeout_)
 
 			// parameters for neighbor approximation
 			.def_readwrite("APPROX_ApproximateCost_", &OptimizationInfo::APPROX_ApproximateCost_)
 			.def_readwrite("APPROX_ApproximateConstraints_", &OptimizationInfo::APPROX_ApproximateConstraints_)
-			.def_readwrite("APPROX_ApproximateDynamics_", &OptimizationInfo::APPROX_ApproximateDynamics_);
+			.def_readwrite("APPROX_ApproximateDynamics_", &OptimizationInfo::APPROX_ApproximateDynamics_)
+			.def_readwrite("COMM_DeltaEncoding_", &OptimizationInfo::COMM_DeltaEncoding_)
+			.def_readwrite("COMM_Quantization_", &OptimizationInfo::COMM_Quantization_)
+			.def_readwrite("COMM_QuantizationTolerance_", &OptimizationInfo::COMM_QuantizationTolerance_)
+			.def_readwrite("COMM_Multicast_", &OptimizationInfo::COMM_Multicast_)
+			.def_readwrite("COMM_MulticastAddress_", &OptimizationInfo::COMM_MulticastAddress_)
+			.def_readwrite("COMM_MulticastPort_", &OptimizationInfo::COMM_MulticastPort_);
+
+		py::class_<ScenarioInfo>(m, "ScenarioInfo")
+			.def(py::init<>())
+			.def_readwrite("name_", &ScenarioInfo::name_)
+			.def_readwrite("optimization_info_", &ScenarioInfo::optimization_info_)
+			.def_readwrite("agents_", &ScenarioInfo::agents_)
+			.def_readwrite("x_init_", &ScenarioInfo::x_init_)
+			.def_readwrite("u_init_", &ScenarioInfo::u_init_)
+			.def_readwrite("x_des_", &ScenarioInfo::x_des_)
+			.def_readwrite("u_des_", &ScenarioInfo::u_des_)
+			.def_readwrite("couplings_", &ScenarioInfo::couplings_)
+			.def_readwrite("distributed_", &ScenarioInfo::distributed_)
+			.def_readwrite("t0_", &ScenarioInfo::t0_)
+			.def_readwrite("Tsim_", &ScenarioInfo::Tsim_);
+
+		py::class_<ScenarioResult>(m, "ScenarioResult")
+			.def(py::init<>())
+			.def_readonly("name_", &ScenarioResult::name_)
+			.def_readonly("is_successful_", &ScenarioResult::is_successful_)
+			.def_readonly("number_of_agents_", &ScenarioResult::number_of_agents_)
+			.def_readonly("number_of_steps_", &ScenarioResult::number_of_steps_)
+			.def_readonly("cost_", &ScenarioResult::cost_)
+			.def_readonly("final_cost_", &ScenarioResult::final_cost_)
+			.def_readonly("average_computation_time_", &ScenarioResult::average_computation_time_)
+			.def_readonly("maximum_computation_time_", &ScenarioResult::maximum_computation_time_)
+			.def_readonly("run_time_", &ScenarioResult::run_time_);
+
+		// the scenarios do not call back into python, hence other python threads continue while they run
+		py::class_<ScenarioRunner>(m, "ScenarioRunner")
+			.def(py::init<>())
+			.def("add_scenario", &ScenarioRunner::add_scenario)
+			.def("clear", &ScenarioRunner::clear)
+			.def("run", &ScenarioRunner::run, py::arg("number_of_threads"), py::call_guard<py::gil_scoped_release>())
+			.def("get_results", &ScenarioRunner::get_results)
+			.def("print_results_to_file", &ScenarioRunner::print_results_to_file)
+			.def("set_print_base", &ScenarioRunner::set_print_base)
+			.def("set_print_warning", &ScenarioRunner::set_print_warning)
+			.def("set_print_error", &ScenarioRunner::set_print_error);
 	}
 }
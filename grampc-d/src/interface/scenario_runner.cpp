@@ -0,0 +1,193 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/interface/scenario_runner.hpp"
+
+#include "grampcd/interface/dmpc_interface.hpp"
+
+#include "grampcd/optim/solution.hpp"
+
+#include "grampcd/util/logging.hpp"
+
+#include "asio.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace grampcd
+{
+
+	ScenarioRunner::ScenarioRunner() :
+		log_(std::make_shared<Logging>())
+	{}
+
+	void ScenarioRunner::add_scenario(ScenarioInfo scenario)
+	{
+		scenarios_.push_back(std::move(scenario));
+	}
+
+	void ScenarioRunner::clear()
+	{
+		scenarios_.clear();
+		results_.clear();
+	}
+
+	void ScenarioRunner::run(unsigned int number_of_threads)
+	{
+		results_.assign(scenarios_.size(), ScenarioResult());
+		number_of_threads = std::max(1u, std::min<unsigned int>(number_of_threads, static_cast<unsigned int>(scenarios_.size())));
+
+		log_->print(DebugType::Base) << "Running " << scenarios_.size() << " scenarios on "
+			<< number_of_threads << " threads ..." << std::endl;
+		const auto tstart = std::chrono::steady_clock::now();
+
+		// each scenario writes its own result, hence they do not need to be synchronized
+		asio::thread_pool thread_pool(number_of_threads);
+		for (std::size_t k = 0; k < scenarios_.size(); ++k)
+			asio::post(thread_pool, [this, k]() { results_[k] = run_scenario(scenarios_[k]); });
+		thread_pool.join();
+
+		const auto tend = std::chrono::steady_clock::now();
+		const auto number_of_failed_scenarios = std::count_if(results_.begin(), results_.end(),
+			[](const ScenarioResult& result) { return !result.is_successful_; });
+
+		log_->print(DebugType::Base) << "Scenarios finished in "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart).count() << " ms, "
+			<< number_of_failed_scenarios << " of them failed." << std::endl;
+	}
+
+	const ScenarioResult ScenarioRunner::run_scenario(const ScenarioInfo& scenario) const
+	{
+		ScenarioResult result;
+		result.name_ = scenario.name_;
+		result.number_of_agents_ = static_cast<unsigned int>(scenario.agents_.size());
+
+		if (scenario.agents_.empty()
+			|| scenario.x_init_.size() != scenario.agents_.size()
+			|| scenario.u_init_.size() != scenario.agents_.size()
+			|| (!scenario.x_des_.empty() && scenario.x_des_.size() != scenario.agents_.size())
+			|| (!scenario.u_des_.empty() && scenario.u_des_.size() != scenario.agents_.size()))
+		{
+			log_->print(DebugType::Error) << "[ScenarioRunner::run_scenario] Scenario " << scenario.name_
+				<< " is skipped as it requires initial states and controls for each agent." << std::endl;
+			return result;
+		}
+
+		const auto tstart = std::chrono::steady_clock::now();
+
+		const auto interface = std::make_shared<DmpcInterface>();
+		interface->set_print_base(false);
+		interface->set_print_warning(print_warning_);
+		interface->set_print_error(print_error_);
+
+		// set up the scenario
+		interface->initialize_central_communicationInterface();
+		interface->set_optimizationInfo(scenario.optimization_info_);
+
+		for (std::size_t i = 0; i < scenario.agents_.size(); ++i)
+		{
+			const auto& agent = scenario.agents_[i];
+			interface->register_agent(agent, scenario.x_init_[i], scenario.u_init_[i]);
+
+			if (!scenario.x_des_.empty() && !scenario.u_des_.empty())
+				interface->set_desiredAgentState(agent.id_, scenario.x_des_[i], scenario.u_des_[i]);
+		}
+
+		interface->register_couplings(scenario.couplings_);
+
+		// run the controller
+		if (scenario.distributed_)
+			interface->run_DMPC(scenario.t0_, scenario.Tsim_);
+		else
+			interface->run_MPC(scenario.t0_, scenario.Tsim_);
+
+		// aggregate the simulated cost of all agents
+		for (const auto& solution : interface->get_solution("all"))
+		{
+			const auto cost = solution->get_cost();
+			if (cost.empty())
+				continue;
+
+			for (const auto c : cost)
+				result.cost_ += c;
+			result.final_cost_ += cost.back();
+			result.number_of_steps_ = std::max(result.number_of_steps_, static_cast<unsigned int>(cost.size()));
+		}
+
+		const auto tend = std::chrono::steady_clock::now();
+
+		result.average_computation_time_ = interface->get_averageComputationTime();
+		result.maximum_computation_time_ = interface->get_maximumComputationTime();
+		result.run_time_ = static_cast<typeRNum>(std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart).count()) / 1000;
+		result.is_successful_ = result.number_of_steps_ > 0;
+
+		return result;
+	}
+
+	const std::vector<ScenarioResult>& ScenarioRunner::get_results() const
+	{
+		return results_;
+	}
+
+	void ScenarioRunner::print_results_to_file(const std::string filename) const
+	{
+		std::ofstream outputFile(filename);
+
+		if (outputFile)
+			outputFile << results_;
+		else
+			log_->print(DebugType::Error) << "[ScenarioRunner::print_results_to_file] "
+			<< "Failed to open file." << std::endl;
+	}
+
+	void ScenarioRunner::set_print_base(bool print)
+	{
+		log_->set_print_base(print);
+	}
+
+	void ScenarioRunner::set_print_warning(bool print)
+	{
+		print_warning_ = print;
+		log_->set_print_warning(print);
+	}
+
+	void ScenarioRunner::set_print_error(bool print)
+	{
+		print_error_ = print;
+		log_->set_print_error(print);
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const std::vector<ScenarioResult>& results)
+	{
+		stream << "Scenario\tName\tSuccessful\tAgents\tSteps\tCost\tFinalCost\t"
+			<< "AverageComputationTime\tMaximumComputationTime\tRunTime\n";
+
+		for (std::size_t k = 0; k < results.size(); ++k)
+		{
+			const auto& result = results[k];
+
+			stream << k << "\t"
+				<< (result.name_.empty() ? std::to_string(k) : result.name_) << "\t"
+				<< result.is_successful_ << "\t"
+				<< result.number_of_agents_ << "\t"
+				<< result.number_of_steps_ << "\t"
+				<< result.cost_ << "\t"
+				<< result.final_cost_ << "\t"
+				<< result.average_computation_time_ << "\t"
+				<< result.maximum_computation_time_ << "\t"
+				<< result.run_time_ << "\n";
+		}
+
+		return stream;
+	}
+}
@@ -36,38 +36,35 @@ namespace grampcd
 
 		agentState_.i_ = id;
 
+		// the maximum number of data points may change after data points are stored
+		const auto number_of_data_points = get_numberOfDataPoints();
+		const bool is_capped = maximum_number_of_data_points_ > 0;
+		if ((is_capped && number_of_data_points > maximum_number_of_data_points_)
+			|| (first_data_point_ > 0 && (!is_capped || number_of_data_points < maximum_number_of_data_points_)))
+			linearize();
+
 		// check if maximum number of stored data points should be considered AND
 		// maximum number of data points is already reached
-		if (maximum_number_of_data_points_ > 0 && 
-			agentState_.t_.size() == maximum_number_of_data_points_)
+		if (is_capped && get_numberOfDataPoints() == maximum_number_of_data_points_)
 		{
-			// shift time
-			for (unsigned int i = 1; i < agentState_.t_.size(); ++i)
-				agentState_.t_[i - 1] = agentState_.t_[i];
+			// the oldest data point is overwritten
+			const auto k = first_data_point_;
+			first_data_point_ = (first_data_point_ + 1) % maximum_number_of_data_points_;
+			++index_of_first_data_point_;
+
 			// set time
-			agentState_.t_.back() = t0;
+			agentState_.t_[k] = t0;
 
-			// shift controls
-			for (unsigned int i = Nu; i < agentState_.u_.size(); ++i)
-				agentState_.u_[i - Nu] = agentState_.u_[i];
 			// set controls
 			// As the predicted controls are used for the simulation, they can be 
 			// directly used here.
-			for (unsigned int i = 0; i < Nu; ++i)
-				agentState_.u_[agentState_.u_.size() - Nu + i] = predicted_agentState_.u_[i];
+			std::copy(predicted_agentState_.u_.begin(), predicted_agentState_.u_.begin() + Nu, agentState_.u_.begin() + k * Nu);
 
-			// shift states
-			for (unsigned int i = Nx; i < agentState_.x_.size(); ++i)
-				agentState_.x_[i - Nu] = agentState_.x_[i];
 			// set states
-			for (unsigned int i = 0; i < Nx; ++i)
-				agentState_.x_[agentState_.x_.size() - Nx + i] = x[i];
+			std::copy(x.begin(), x.begin() + Nx, agentState_.x_.begin() + k * Nx);
 
-			// shift cost
-			for (unsigned int i = 1; i < cost_.size(); ++i)
-				cost_[i - 1] = cost_[i];
 			// set cost
-			cost_.back() = cost;
+			cost_[k] = cost;
 		}
 		else
 		{
@@ -87,6 +84,124 @@ namespace grampcd
 		}
 	}
 
+	void Solution::linearize()
+	{
+		const auto number_of_data_points = get_numberOfDataPoints();
+		if (number_of_data_points == 0)
+			return;
+
+		const auto Nx = static_cast<unsigned int>(agentState_.x_.size()) / number_of_data_points;
+		const auto Nu = static_cast<unsigned int>(agentState_.u_.size()) / number_of_data_points;
+
+		auto& t = agentState_.t_;
+		auto& x = agentState_.x_;
+		auto& u = agentState_.u_;
+
+		if (first_data_point_ > 0)
+		{
+			std::rotate(t.begin(), t.begin() + first_data_point_, t.end());
+			std::rotate(x.begin(), x.begin() + first_data_point_ * Nx, x.end());
+			std::rotate(u.begin(), u.begin() + first_data_point_ * Nu, u.end());
+			std::rotate(cost_.begin(), cost_.begin() + first_data_point_, cost_.end());
+			first_data_point_ = 0;
+		}
+
+		if (maximum_number_of_data_points_ > 0 && number_of_data_points > maximum_number_of_data_points_)
+		{
+			const auto number_of_dropped_data_points = number_of_data_points - maximum_number_of_data_points_;
+			t.erase(t.begin(), t.begin() + number_of_dropped_data_points);
+			x.erase(x.begin(), x.begin() + number_of_dropped_data_points * Nx);
+			u.erase(u.begin(), u.begin() + number_of_dropped_data_points * Nu);
+			cost_.erase(cost_.begin(), cost_.begin() + number_of_dropped_data_points);
+			index_of_first_data_point_ += number_of_dropped_data_points;
+		}
+	}
+
+	const AgentState Solution::get_agentState() const
+	{
+		AgentState agent_state = agentState_;
+
+		const auto number_of_data_points = get_numberOfDataPoints();
+		if (first_data_point_ == 0 || number_of_data_points == 0)
+			return agent_state;
+
+		const auto Nx = static_cast<unsigned int>(agent_state.x_.size()) / number_of_data_points;
+		const auto Nu = static_cast<unsigned int>(agent_state.u_.size()) / number_of_data_points;
+
+		std::rotate(agent_state.t_.begin(), agent_state.t_.begin() + first_data_point_, agent_state.t_.end());
+		std::rotate(agent_state.x_.begin(), agent_state.x_.begin() + first_data_point_ * Nx, agent_state.x_.end());
+		std::rotate(agent_state.u_.begin(), agent_state.u_.begin() + first_data_point_ * Nu, agent_state.u_.end());
+
+		return agent_state;
+	}
+
+	const std::vector< typeRNum > Solution::get_cost() const
+	{
+		std::vector< typeRNum > cost = cost_;
+
+		if (first_data_point_ > 0 && !cost.empty())
+			std::rotate(cost.begin(), cost.begin() + first_data_point_, cost.end());
+
+		return cost;
+	}
+
+	const unsigned int Solution::get_numberOfDataPoints() const
+	{
+		return static_cast<unsigned int>(agentState_.t_.size());
+	}
+
+	const unsigned int Solution::get_dataPoint(const unsigned int k) const
+	{
+		const auto number_of_data_points = get_numberOfDataPoints();
+		return number_of_data_points > 0 ? (first_data_point_ + k) % number_of_data_points : k;
+	}
+
+	const unsigned int Solution::get_indexOfFirstDataPoint() const
+	{
+		return index_of_first_data_point_;
+	}
+
+	void Solution::set_indexOfFirstDataPoint(const unsigned int index)
+	{
+		index_of_first_data_point_ = index;
+	}
+
+	const unsigned int Solution::get_nextIndex() const
+	{
+		return index_of_first_data_point_ + get_numberOfDataPoints();
+	}
+
+	const SolutionPtr Solution::get_solution_since(const unsigned int index) const
+	{
+		SolutionPtr solution(new Solution(AgentState(), predicted_agentState_));
+		solution->predicted_cost_ = predicted_cost_;
+		solution->agentState_.i_ = agentState_.i_;
+		solution->agentState_.t0_ = agentState_.t0_;
+
+		// data points that were dropped already are skipped
+		const auto number_of_data_points = get_numberOfDataPoints();
+		const auto first_index = index > get_nextIndex() ? index_of_first_data_point_ : std::max(index, index_of_first_data_point_);
+		solution->index_of_first_data_point_ = first_index;
+
+		if (number_of_data_points == 0)
+			return solution;
+
+		const auto Nx = static_cast<unsigned int>(agentState_.x_.size()) / number_of_data_points;
+		const auto Nu = static_cast<unsigned int>(agentState_.u_.size()) / number_of_data_points;
+
+		for (unsigned int k = first_index - index_of_first_data_point_; k < number_of_data_points; ++k)
+		{
+			const auto j = get_dataPoint(k);
+
+			solution->agentState_.t_.push_back(agentState_.t_[j]);
+			solution->agentState_.x_.insert(solution->agentState_.x_.end(), agentState_.x_.begin() + j * Nx, agentState_.x_.begin() + (j + 1) * Nx);
+			solution->agentState_.u_.insert(solution->agentState_.u_.end(), agentState_.u_.begin() + j * Nu, agentState_.u_.begin() + (j + 1) * Nu);
+			solution->cost_.push_back(cost_[j]);
+		}
+
+		return solution;
+	}
+
 	void Solution::update_predicted_state(const AgentState& state, const std::vector< typeRNum >& predicted_cost)
 	{
 		predicted_agentState_ = state;
@@ -123,13 +238,16 @@ namespace grampcd
 
 		for (unsigned int k = 0; k < max_rows; ++k)
 		{
+			// position of the data point in the ring buffer
+			const auto j = solution.get_dataPoint(k);
+
 			/*
 			Print agent state
 			*/
 
 			// print time
 			if (solution.agentState_.t_.size() > k)
-				stream << solution.agentState_.t_[k] << "\t";
+				stream << solution.agentState_.t_[j] << "\t";
 			else
 				stream << "0 \t ";
 
@@ -137,7 +255,7 @@ namespace grampcd
 			for (unsigned int i = 0; i < Nx; ++i)
 			{
 				if (solution.agentState_.x_.size() > Nx * k + i)
-					stream << solution.agentState_.x_[Nx * k + i] << "\t";
+					stream << solution.agentState_.x_[Nx * j + i] << "\t";
 				else
 					stream << "0 \t ";
 			}
@@ -146,7 +264,7 @@ namespace grampcd
 			{
 				// print control
 				if (solution.agentState_.u_.size() > Nu * k + i)
-					stream << solution.agentState_.u_[Nu * k + i] << "\t";
+					stream << solution.agentState_.u_[Nu * j + i] << "\t";
 				else
 					stream << "0 \t ";
 			}
@@ -162,7 +280,7 @@ namespace grampcd
 
 			// print cost
 			if (solution.cost_.size() > k)
-				stream << solution.cost_[k] << "\t";
+				stream << solution.cost_[j] << "\t";
 			else
 				stream << "0 \t ";
 
@@ -26,6 +26,10 @@
 #include "grampcd/util/logging.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
 
 namespace grampcd
 {
@@ -36,6 +40,15 @@ namespace grampcd
     {}
 
     void Simulator::distributed_simulation(const std::string& Integrator, typeRNum dt)
+    {
+        if (!collect_states(Integrator, dt))
+            return;
+
+        //start simulation
+        simulate();
+    }
+
+    const bool Simulator::collect_states(const std::string& Integrator, typeRNum dt)
     {
         // integration method
         Integrator_ = Integrator;
@@ -46,10 +59,11 @@ namespace grampcd
         // get map with all agent infos
         const auto agents = communication_interface_->get_agentInfo_from_coordinator();
         if (agents == nullptr)
-            return;
+            return false;
 
         // collect AgentStates
         agentStates_.clear();
+        desired_agentStates_.clear();
         for(const auto& [id, info] : *agents )
         {
             // get agentState
@@ -59,17 +73,16 @@ namespace grampcd
             // stop simulation if pointer is nullptr
             if (agentStatePtr == nullptr || desired_agentStatePtr == nullptr)
             {
-                log_->print(DebugType::Warning) << "[Simulator::distributed_simulation] Agent " << id
+                log_->print(DebugType::Warning) << "[Simulator::collect_states] Agent " << id
                     << " did not answer. Simulation is interrupted." << std::endl;
-                return;
+                return false;
             }
 
 			agentStates_.insert(std::make_pair(id, agentStatePtr));
 			desired_agentStates_.insert(std::make_pair(id, desired_agentStatePtr));
         }
 
-        //start simulation
-        simulate();
+        return collect_models();
     }
 
     void Simulator::centralized_simulation(const SolverCentral *solver, const std::string& Integrator, typeRNum dt)
@@ -85,182 +98,477 @@ namespace grampcd
 
         // collect AgentStates
         agentStates_.clear();
+        desired_agentStates_.clear();
         for (const auto& agent : agents)
         {
             agentStates_.insert(std::make_pair(agent->get_id(), std::make_shared<AgentState>(agent->get_agentState())));
             desired_agentStates_.insert(std::make_pair(agent->get_id(), std::make_shared<AgentState>(agent->get_desiredAgentState())));
         }
 
+        if (!collect_models())
+            return;
+
 	    //start simulation
         simulate();
     }
 
+    const bool Simulator::collect_models()
+    {
+        // the models only change if agents or couplings are registered or de-registered
+        const auto topology_version = communication_interface_->get_topologyVersion_from_coordinator();
+        if (!are_models_cached_ || topology_version != topology_version_)
+        {
+            agentModels_.clear();
+            couplingModels_.clear();
+            topology_version_ = topology_version;
+            are_models_cached_ = true;
+            is_topology_compiled_ = false;
+        }
+
+        agent_ids_.clear();
+        for (const auto& [id, state] : agentStates_)
+        {
+            agent_ids_.push_back(id);
+
+            if (agentModels_.find(id) != agentModels_.end())
+                continue;
+
+            // get agent model
+            const auto agent_model = communication_interface_->get_agentModel(id);
+
+            if (agent_model == nullptr)
+            {
+                log_->print(DebugType::Warning) << "[Simulator::collect_models] Agent " << id
+                    << " did not send its agent model. Simulation is interrupted." << std::endl;
+                return false;
+            }
+
+            // get all coupling model from agent
+            const auto couplingModels = communication_interface_->get_couplingModels_from_agent(id);
+
+            if (couplingModels == nullptr)
+            {
+                log_->print(DebugType::Warning) << "[Simulator::collect_models] Agent " << id
+                    << " did not send its coupling models. Simulation is interrupted." << std::endl;
+                return false;
+            }
+
+            agentModels_.insert(std::make_pair(id, agent_model));
+            couplingModels_.insert(std::make_pair(id, couplingModels));
+            is_topology_compiled_ = false;
+        }
+
+        return true;
+    }
+
+    const bool Simulator::compile_topology()
+    {
+        if (is_topology_compiled_ && topology_.agent_ids_ == agent_ids_)
+            return true;
+
+        is_topology_compiled_ = false;
+        topology_ = Topology();
+        topology_.agent_ids_ = agent_ids_;
+
+        std::map<unsigned int, unsigned int> index_of_agent;
+        for (unsigned int k = 0; k < agent_ids_.size(); ++k)
+            index_of_agent.insert(std::make_pair(agent_ids_[k], k));
+
+        topology_.offsets_x_.push_back(0);
+        topology_.offsets_u_.push_back(0);
+        topology_.offsets_edges_.push_back(0);
+
+        for (const auto id : agent_ids_)
+        {
+            const auto& agent_model = agentModels_.find(id)->second;
+            topology_.agent_models_.push_back(agent_model);
+            topology_.offsets_x_.push_back(topology_.offsets_x_.back() + agent_model->get_Nxi());
+            topology_.offsets_u_.push_back(topology_.offsets_u_.back() + agent_model->get_Nui());
+
+            for (const auto& [neighbor_id, coupling_model] : *couplingModels_.find(id)->second)
+            {
+                const auto neighbor = index_of_agent.find(neighbor_id);
+                if (neighbor == index_of_agent.end())
+                {
+                    log_->print(DebugType::Warning) << "[Simulator::compile_topology] Neighbor " << neighbor_id
+                        << " of agent " << id << " is not simulated. Simulation is interrupted." << std::endl;
+                    return false;
+                }
+
+                topology_.neighbors_.push_back(neighbor->second);
+                topology_.coupling_models_.push_back(coupling_model);
+            }
+            topology_.offsets_edges_.push_back(static_cast<unsigned int>(topology_.neighbors_.size()));
+        }
+
+        is_topology_compiled_ = true;
+        return true;
+    }
+
     void Simulator::simulate()
     {
+        if (integrate())
+            send_simulatedStates();
+    }
+
+    const bool Simulator::integrate()
+    {
+        is_simulated_ = false;
+
+        // euler and heun are evaluated as before the Butcher tableaus were introduced to keep their results
+        const auto tableau = get_butcherTableau(Integrator_);
+        if (tableau == nullptr && Integrator_ != "euler" && Integrator_ != "heun")
+        {
+            log_->print(DebugType::Error) << "[Simulator::integrate]: Unknown Integrator." << std::endl;
+            return false;
+        }
+
+        if (!compile_topology())
+            return false;
+
         // evaluate t0
         // The initial time step may differ, e.g. due to plug-and-play scenarios.
         // Hence, they are synchronized here.
         for (const auto& [id, state] : agentStates_)
             t0_ = std::max(t0_, state->t0_);
 
-        if( Integrator_ == "euler" )
-        {
-            for(const auto& [id, state] : agentStates_)
-            {
-                // get agent model
-                const auto agent_model = communication_interface_->get_agentModel( id );
+        // gather the current states and controls of all agents, the maps are ordered as the topology
+        const auto number_of_agents = agent_ids_.size();
+        const auto& offsets_x = topology_.offsets_x_;
+        const auto& offsets_u = topology_.offsets_u_;
 
-                if (agent_model == nullptr)
-                {
-                    log_->print(DebugType::Warning) << "[Simulator::simulate] Agent " << id
-                        << " did not send its agent model. Simulation is interrupted." << std::endl;
-                    return;
-                }
-
-                // get all coupling model from agent
-                const auto couplingModels = communication_interface_->get_couplingModels_from_agent( id );
+        states_.clear();
+        desired_states_.clear();
+        for (const auto& [id, state] : agentStates_)
+            states_.push_back(state);
+        for (const auto& [id, desired_state] : desired_agentStates_)
+            desired_states_.push_back(desired_state);
+
+        t_.resize(number_of_agents);
+        x_.resize(offsets_x.back());
+        u_.resize(offsets_u.back());
+        for (std::size_t k = 0; k < number_of_agents; ++k)
+        {
+            t_[k] = states_[k]->t_[0];
+            std::copy(states_[k]->x_.begin(), states_[k]->x_.begin() + (offsets_x[k + 1] - offsets_x[k]), x_.begin() + offsets_x[k]);
+            std::copy(states_[k]->u_.begin(), states_[k]->u_.begin() + (offsets_u[k + 1] - offsets_u[k]), u_.begin() + offsets_u[k]);
+        }
 
-                if (couplingModels == nullptr)
-                {
-                    log_->print(DebugType::Warning) << "[Simulator::simulate] Agent " << id
-                        << " did not send its coupling models. Simulation is interrupted." << std::endl;
-                    return;
-                }
+        // the controls are held over dt, while the states are integrated in several steps
+        x_step_ = x_;
+        x_candidate_.resize(offsets_x.back());
+        for (auto& x_stage : x_stages_)
+            x_stage.resize(offsets_x.back());
+        dx_stages_.resize(tableau == nullptr ? 2 : tableau->b_.size());
+        for (auto& dx_stage : dx_stages_)
+            dx_stage.resize(offsets_x.back());
+        errors_.resize(number_of_agents);
+
+        if (tableau == nullptr || tableau->e_.empty())
+            integrate_fixedSteps(tableau);
+        else if (!integrate_adaptiveSteps(*tableau))
+            return false;
+
+        x_next_.swap(x_step_);
+
+        costs_.resize(number_of_agents);
+        for_each_agent([this](const std::size_t k)
+        {
+            costs_[k] = evaluate_cost(k);
+        });
 
-                // get Nxi
-                const auto Nxi = agent_model->get_Nxi();
+        is_simulated_ = true;
+        return true;
+    }
 
-                // initialize vector for new states
-                std::vector<typeRNum> x_next( Nxi, 0.0 );
+    void Simulator::integrate_fixedSteps(const ButcherTableau* tableau)
+    {
+        const typeRNum h = dt_ / number_of_substeps_;
 
-                // evaluate f_i( x_i, u_i )
-                agent_model->ffct( &x_next[0], state->t_[0], &state->x_[0], &state->u_[0] );
+        for (unsigned int step = 0; step < number_of_substeps_; ++step)
+        {
+            if (tableau != nullptr)
+                evaluate_step(*tableau, step * h, h);
+            else if (Integrator_ == "euler")
+                evaluate_eulerStep(step * h, h);
+            else
+                evaluate_heunStep(step * h, h);
+            x_step_.swap(x_candidate_);
+        }
+    }
 
-                // consider each sending neighbor
-                for( const auto& [neighbor_id, neighbor_model] : *couplingModels )
-                {
-                    // get neighbor state
-                    const auto& neighbor_state = agentStates_.find(neighbor_id)->second;
+    const bool Simulator::integrate_adaptiveSteps(const ButcherTableau& tableau)
+    {
+        typeRNum tau = 0.0;
+        typeRNum h = step_size_ > 0.0 ? std::min(step_size_, dt_) : dt_;
 
-                    // evaluate f_{ij}( xi, ui, x_j, u_j )
-                    neighbor_model->ffct( &x_next[0], state->t_[0], &state->x_[0], &state->u_[0], &neighbor_state->x_[0], &neighbor_state->u_[0] );
-                }
+        for (unsigned int step = 0; tau < dt_; ++step)
+        {
+            if (step == max_number_of_steps_ || h <= std::numeric_limits<typeRNum>::epsilon() * dt_)
+            {
+                log_->print(DebugType::Error) << "[Simulator::integrate_adaptiveSteps]: "
+                    << "Step size control failed at time " << t0_ + tau << "." << std::endl;
+                step_size_ = 0.0;
+                return false;
+            }
 
-                // x_{k+1} = x_k + dt*x'_k
-                for( unsigned int i = 0; i < Nxi; ++i )
-                    x_next[i] = state->x_[i] + dt_ * x_next[i];
+            // the last step ends at dt
+            const bool is_last_step = tau + h >= dt_;
+            const typeRNum h_step = is_last_step ? dt_ - tau : h;
 
-                const auto cost = evaluate_cost(id, agent_model, couplingModels);
+            evaluate_step(tableau, tau, h_step);
+            const auto error = errors_.empty() ? 0.0 : *std::max_element(errors_.begin(), errors_.end());
 
-                // send simulated state to agent
-                communication_interface_->set_simulatedState_for_agent( id, x_next, dt_, t0_, cost);
+            if (error <= 1.0)
+            {
+                tau = is_last_step ? dt_ : tau + h_step;
+                x_step_.swap(x_candidate_);
             }
+
+            // the step size changes at most by a factor of 5
+            const typeRNum factor = error > 0.0
+                ? static_cast<typeRNum>(0.9 * std::pow(error, -1.0 / (tableau.error_order_ + 1)))
+                : static_cast<typeRNum>(5.0);
+            h = h_step * std::min<typeRNum>(5.0, std::max<typeRNum>(0.2, factor));
         }
-        else if( Integrator_ == "heun" )
+
+        step_size_ = h;
+        return true;
+    }
+
+    void Simulator::evaluate_eulerStep(const typeRNum tau, const typeRNum h)
+    {
+        for_each_agent([this, tau, h](const std::size_t k)
         {
-            std::map<unsigned int, std::shared_ptr< std::vector< typeRNum > > > out0;
-            std::map<unsigned int, std::shared_ptr< std::vector< typeRNum > > > out1;
+            const auto begin = topology_.offsets_x_[k];
+            const auto end = topology_.offsets_x_[k + 1];
+
+            // evaluate f_i( x_i, u_i ) + sum_j f_{ij}( xi, ui, x_j, u_j )
+            auto& dx = dx_stages_[0];
+            std::fill(dx.begin() + begin, dx.begin() + end, 0.0);
+            evaluate_dynamics(k, tau, x_step_, &dx[begin]);
+
+            // x_{k+1} = x_k + h*x'_k
+            for (auto i = begin; i < end; ++i)
+                x_candidate_[i] = x_step_[i] + h * dx[i];
+        });
+    }
 
-            for(const auto& [id, state] : agentStates_)
-            {
-                // get agent model
-                const auto agent_model = communication_interface_->get_agentModel( id );
+    void Simulator::evaluate_heunStep(const typeRNum tau, const typeRNum h)
+    {
+        auto& x_predicted = x_stages_[1];
+
+        for_each_agent([this, tau, h, &x_predicted](const std::size_t k)
+        {
+            const auto begin = topology_.offsets_x_[k];
+            const auto end = topology_.offsets_x_[k + 1];
+
+            auto& dx = dx_stages_[0];
+            std::fill(dx.begin() + begin, dx.begin() + end, 0.0);
+            evaluate_dynamics(k, tau, x_step_, &dx[begin]);
+
+            // compute euler
+            // x^*_{k+1} = x_k + h*x'_k
+            for (auto i = begin; i < end; ++i)
+                x_predicted[i] = x_step_[i] + h * dx[i];
+        });
+
+        // the second stage starts after the euler steps of all agents are evaluated,
+        // it is evaluated at the time of the first stage as the original scheme
+        for_each_agent([this, tau, h, &x_predicted](const std::size_t k)
+        {
+            const auto begin = topology_.offsets_x_[k];
+            const auto end = topology_.offsets_x_[k + 1];
 
-			    if (agent_model == nullptr)
-			    {
-				    log_->print(DebugType::Warning) << "[Simulator::simulate] Agent " << id
-					    << " did not send its agent model. Simulation is interrupted." << std::endl;
-				    return;
-			    }
+            auto& dx = dx_stages_[1];
+            std::fill(dx.begin() + begin, dx.begin() + end, 0.0);
+            evaluate_dynamics(k, tau, x_predicted, &dx[begin]);
 
-                // get all coupling model from agent
-                auto couplingModels = communication_interface_->get_couplingModels_from_agent( id );
+            // compute heun
+            for (auto i = begin; i < end; ++i)
+                x_candidate_[i] = 0.5 * x_step_[i] + 0.5 * x_predicted[i] + 0.5 * h * dx[i];
+        });
+    }
 
-			    if (couplingModels == nullptr)
-			    {
-				    log_->print(DebugType::Warning) << "[Simulator::simulate] Agent " << id
-					    << " did not send its coupling models. Simulation is interrupted." << std::endl;
-				    return;
-			    }
+    void Simulator::evaluate_step(const ButcherTableau& tableau, const typeRNum tau, const typeRNum h)
+    {
+        const auto number_of_stages = tableau.b_.size();
 
-			    // initialize vector
-                std::shared_ptr< std::vector< typeRNum > > ptr_to_data(new std::vector<typeRNum>(agent_model->get_Nxi(), 0.0));
+        // Each stage requires the stage states of all neighbors, hence the agents are synchronized after each stage.
+        // The states of the next stage are written to the other buffer, as the neighbors still read the current one.
+        for (std::size_t s = 0; s < number_of_stages; ++s)
+        {
+            const auto& x = s == 0 ? x_step_ : x_stages_[s % 2];
+            auto& x_next_stage = x_stages_[(s + 1) % 2];
 
-                out0.insert(std::make_pair(id, ptr_to_data));
+            for_each_agent([this, &tableau, tau, h, s, number_of_stages, &x, &x_next_stage](const std::size_t k)
+            {
+                const auto begin = topology_.offsets_x_[k];
+                const auto end = topology_.offsets_x_[k + 1];
 
-                // evaluate f_i( x_i, u_i )
-                agent_model->ffct( &((*ptr_to_data)[0]), state->t_[0], &state->x_[0], &state->u_[0] );
+                // evaluate f_i( x_i, u_i ) + sum_j f_{ij}( xi, ui, x_j, u_j )
+                auto& dx = dx_stages_[s];
+                std::fill(dx.begin() + begin, dx.begin() + end, 0.0);
+                evaluate_dynamics(k, tau + tableau.c_[s] * h, x, &dx[begin]);
 
-                // consider each sending neighbor
-                for(const auto& [neighbor_id, neighbor_model] : *couplingModels)
+                if (s + 1 < number_of_stages)
                 {
-                    // get neighbor state
-                    const auto& neighbor_state = agentStates_.find(neighbor_id)->second;
+                    // x^{s+1} = x + h * sum_j a_{s+1,j} * x'^j
+                    const auto& a = tableau.a_[s + 1];
+                    for (auto i = begin; i < end; ++i)
+                    {
+                        typeRNum sum = 0.0;
+                        for (std::size_t j = 0; j <= s; ++j)
+                            sum += a[j] * dx_stages_[j][i];
+                        x_next_stage[i] = x_step_[i] + h * sum;
+                    }
+                    return;
+                }
 
-                    // evaluate f_{ij}( xi, ui, x_j, u_j )
-                    neighbor_model->ffct( &((*ptr_to_data)[0]), state->t_[0], &state->x_[0], &state->u_[0], &neighbor_state->x_[0], &neighbor_state->u_[0] );
+                // x_{k+1} = x_k + h * sum_j b_j * x'^j
+                typeRNum error = 0.0;
+                for (auto i = begin; i < end; ++i)
+                {
+                    typeRNum sum = 0.0;
+                    for (std::size_t j = 0; j < number_of_stages; ++j)
+                        sum += tableau.b_[j] * dx_stages_[j][i];
+                    x_candidate_[i] = x_step_[i] + h * sum;
+
+                    if (tableau.e_.empty())
+                        continue;
+
+                    // maximum of the error estimates, scaled by the tolerances
+                    typeRNum error_i = 0.0;
+                    for (std::size_t j = 0; j < number_of_stages; ++j)
+                        error_i += tableau.e_[j] * dx_stages_[j][i];
+                    const auto scale = abs_tol_ + rel_tol_ * std::max(std::abs(x_step_[i]), std::abs(x_candidate_[i]));
+                    error = std::max(error, std::abs(h * error_i) / scale);
+
+                    // the step is rejected if the error is not finite
+                    if (!std::isfinite(error_i))
+                        error = std::numeric_limits<typeRNum>::infinity();
                 }
+                errors_[k] = error;
+            });
+        }
+    }
 
-                // compute euler
-                // x^*_{k+1} = x_k + dt*x'_k
-                for( unsigned int i = 0; i < agent_model->get_Nxi(); ++i )
-                    (*ptr_to_data)[i] = state->x_[i] + dt_ * (*ptr_to_data)[i];
-            }
+    const Simulator::ButcherTableau* Simulator::get_butcherTableau(const std::string& Integrator)
+    {
+        static const ButcherTableau rk4
+        {
+            { {}, { 0.5 }, { 0.0, 0.5 }, { 0.0, 0.0, 1.0 } },
+            { 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 },
+            { 0.0, 0.5, 0.5, 1.0 },
+            {},
+            0
+        };
+
+        // Dormand-Prince method of order 5 with an embedded error estimate of order 4
+        static const ButcherTableau rk45
+        {
+            {
+                {},
+                { 1.0 / 5.0 },
+                { 3.0 / 40.0, 9.0 / 40.0 },
+                { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0 },
+                { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0 },
+                { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0 },
+                { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 }
+            },
+            { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0 },
+            { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 },
+            { 71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0 },
+            4
+        };
+
+        if (Integrator == "rk4")
+            return &rk4;
+        else if (Integrator == "rk45")
+            return &rk45;
+
+        return nullptr;
+    }
 
-            for(const auto& [id, state] : agentStates_)
+    void Simulator::evaluate_dynamics(const std::size_t k, const typeRNum tau, const std::vector<typeRNum>& x, typeRNum* dx) const
+    {
+        const auto& offsets_x = topology_.offsets_x_;
+        const auto& offsets_u = topology_.offsets_u_;
+        const auto xi = &x[offsets_x[k]];
+        const auto ui = &u_[offsets_u[k]];
+
+        const auto t = t_[k] + tau;
+
+        // evaluate f_i( x_i, u_i )
+        topology_.agent_models_[k]->ffct(dx, t, xi, ui);
+
+        // consider each sending neighbor
+        for (auto edge = topology_.offsets_edges_[k]; edge < topology_.offsets_edges_[k + 1]; ++edge)
+        {
+            const auto j = topology_.neighbors_[edge];
+
+            // evaluate f_{ij}( xi, ui, x_j, u_j )
+            topology_.coupling_models_[edge]->ffct(dx, t, xi, ui, &x[offsets_x[j]], &u_[offsets_u[j]]);
+        }
+    }
+
+    void Simulator::for_each_agent(const std::function<void(const std::size_t)>& function) const
+    {
+        const std::size_t number_of_agents = agent_ids_.size();
+        const std::size_t number_of_chunks = std::min<std::size_t>(number_of_threads_, number_of_agents);
+
+        if (thread_pool_ == nullptr || number_of_chunks < 2)
+        {
+            for (std::size_t k = 0; k < number_of_agents; ++k)
+                function(k);
+            return;
+        }
+
+        std::mutex mutex;
+        std::condition_variable condition_variable;
+        std::size_t remaining_chunks = number_of_chunks - 1;
+
+        const auto evaluate_chunk = [&function, number_of_agents, number_of_chunks](const std::size_t chunk)
+        {
+            const std::size_t begin = chunk * number_of_agents / number_of_chunks;
+            const std::size_t end = (chunk + 1) * number_of_agents / number_of_chunks;
+            for (std::size_t k = begin; k < end; ++k)
+                function(k);
+        };
+
+        for (std::size_t chunk = 1; chunk < number_of_chunks; ++chunk)
+        {
+            asio::post(*thread_pool_, [&, chunk]()
             {
-                // get agent model
-                const auto agent_model = communication_interface_->get_agentModel( id );
-
-			    if (agent_model == nullptr)
-			    {
-				    log_->print(DebugType::Warning) << "[Simulator::simulate] Agent " << id
-					    << " did not send its agent model. Simulation is interrupted." << std::endl;
-				    return;
-			    }
-
-                // get all coupling model from agent
-                auto couplingModels = communication_interface_->get_couplingModels_from_agent( id );
-
-			    if (couplingModels == nullptr)
-			    {
-				    log_->print(DebugType::Warning) << "[Simulator::simulate] Agent " << id
-					    << " did not send its coupling models. Simulation is interrupted." << std::endl;
-				    return;
-			    }
-
-			    // initialize vector
-			    auto ptr_to_data0 = out0.find(id)->second;
-                std::shared_ptr<std::vector<typeRNum>> ptr_to_data1(new std::vector<typeRNum>(agent_model->get_Nxi(), 0.0));
-			    out1.insert(std::make_pair(id, ptr_to_data1));
-
-                // evaluate f_i( x_i, u_i )
-                agent_model->ffct( &((*ptr_to_data1)[0]), state->t_[0], &((*ptr_to_data0)[0]), &state->u_[0] );
-
-                // consider each sending neighbor
-                for(const auto& [neighbor_id, neighbor_model] : *couplingModels)
-                {
-                    // get neighbor state
-                    const auto& neighbor_state = agentStates_.find(neighbor_id)->second;
-                    const auto& ptr_to_data_of_neighbor = out0.find(neighbor_id)->second;
+                evaluate_chunk(chunk);
 
-                    // evaluate f_{ij}( xi, ui, x_j, u_j )
-                    neighbor_model->ffct( &((*ptr_to_data1)[0]), state->t_[0], &((*ptr_to_data0)[0]), &state->u_[0], &((*ptr_to_data_of_neighbor)[0]), &neighbor_state->u_[0] );
-                }
+                std::lock_guard<std::mutex> guard(mutex);
+                if (--remaining_chunks == 0)
+                    condition_variable.notify_one();
+            });
+        }
 
-                // compute heun
-                std::vector<typeRNum> x_next_heun(agent_model->get_Nxi(), 0.0);
-                for(unsigned int i = 0; i < agent_model->get_Nxi(); ++i)
-                    x_next_heun[i] = 0.5 * state->x_[i] + 0.5 * ((*ptr_to_data0)[i]) + 0.5 * dt_ * ((*ptr_to_data1)[i]);
+        // the calling thread evaluates the first chunk
+        evaluate_chunk(0);
 
+        std::unique_lock<std::mutex> guard(mutex);
+        condition_variable.wait(guard, [&remaining_chunks]() { return remaining_chunks == 0; });
+    }
 
-				const auto cost = evaluate_cost(id, agent_model, couplingModels);
+    void Simulator::send_simulatedStates()
+    {
+        if (!is_simulated_)
+            return;
 
-                communication_interface_->set_simulatedState_for_agent( id, x_next_heun, dt_, t0_, cost);
-            }
+        // send simulated state to agent
+        const auto& offsets_x = topology_.offsets_x_;
+        for (std::size_t k = 0; k < topology_.agent_ids_.size(); ++k)
+        {
+            const std::vector<typeRNum> x_next(x_next_.begin() + offsets_x[k], x_next_.begin() + offsets_x[k + 1]);
+            communication_interface_->set_simulatedState_for_agent(topology_.agent_ids_[k], x_next, dt_, t0_, costs_[k]);
         }
-        else
-            log_->print(DebugType::Error) << "[Simulator::simulate]: Unknown Integrator." << std::endl;
+
+        is_simulated_ = false;
     }
 
     void Simulator::set_t0(typeRNum t0)
@@ -268,32 +576,49 @@ namespace grampcd
         t0_ = t0;
     }
 
-    const typeRNum Simulator::evaluate_cost
-	(
-        const unsigned int agent_id,
-        const AgentModelPtr& agent_model,
-        const std::shared_ptr< std::map<int, CouplingModelPtr> >& coupling_models
-    ) const
+    void Simulator::set_numberOfThreads(const unsigned int number_of_threads)
+    {
+        number_of_threads_ = std::max(number_of_threads, 1u);
+
+        // the calling thread takes part in the evaluation
+        thread_pool_.reset();
+        if (number_of_threads_ > 1)
+            thread_pool_ = std::make_unique<asio::thread_pool>(number_of_threads_ - 1);
+    }
+
+    void Simulator::set_integratorOptions(const unsigned int number_of_substeps, const typeRNum rel_tol, const typeRNum abs_tol)
+    {
+        number_of_substeps_ = std::max(number_of_substeps, 1u);
+        rel_tol_ = rel_tol;
+        abs_tol_ = abs_tol;
+    }
+
+    const typeRNum Simulator::evaluate_cost(const std::size_t k) const
     {
         typeRNum cost = 0;
 
-		const auto& agent_states = agentStates_.find(agent_id)->second;
-		const auto& desired_agent_state = desired_agentStates_.find(agent_id)->second;
+        const auto& agent_model = topology_.agent_models_[k];
+		const auto& agent_states = states_[k];
+		const auto& desired_agent_state = desired_states_[k];
         const auto& t = agent_states->t_;
         const auto Nhor = t.size();
 
         const auto Nxi = agent_model->get_Nxi();
         const auto Nui = agent_model->get_Nui();
 
+        const auto first_edge = topology_.offsets_edges_[k];
+        const auto last_edge = topology_.offsets_edges_[k + 1];
+
         for (unsigned int i = 0; i < Nhor; ++i)
         {
             agent_model->lfct(&cost, t0_ + t[i], &agent_states->x_[i*Nxi], &agent_states->u_[i*Nui], &desired_agent_state->x_[i*Nxi]);
 
-            for (const auto& [neighbor_id, coupling_model] : *coupling_models)
+            for (auto edge = first_edge; edge < last_edge; ++edge)
             {
+                const auto& coupling_model = topology_.coupling_models_[edge];
 				const auto Nxj = coupling_model->get_Nxj();
                 const auto Nuj = coupling_model->get_Nuj();
-                const auto& neighbor_states = agentStates_.find(neighbor_id)->second;
+                const auto& neighbor_states = states_[topology_.neighbors_[edge]];
 
                 coupling_model->lfct
                 (
@@ -311,11 +636,11 @@ namespace grampcd
 
         agent_model->Vfct(&cost, t0_ + t.back(), &agent_states->x_[(Nhor - 1) * Nxi], &desired_agent_state->x_[(Nhor - 1) * Nxi]);
 
-		for (const auto& [neighbor_id, coupling_model] : *coupling_models)
+		for (auto edge = first_edge; edge < last_edge; ++edge)
 		{
+            const auto& coupling_model = topology_.coupling_models_[edge];
 			const auto Nxj = coupling_model->get_Nxj();
-			const auto Nuj = coupling_model->get_Nuj();
-			const auto& neighbor_states = agentStates_.find(neighbor_id)->second;
+			const auto& neighbor_states = states_[topology_.neighbors_[edge]];
 
 			coupling_model->Vfct
 			(
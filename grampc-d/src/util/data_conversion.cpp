@@ -21,8 +21,25 @@
 #include "grampcd/agent/agent.hpp"
 #include "grampcd/agent/neighbor.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace grampcd
 {
+	const bool DataConversion::is_littleEndian()
+	{
+		static const bool little_endian = []()
+		{
+			const unsigned int one = 1;
+			char first_byte = 0;
+			std::memcpy(&first_byte, &one, 1);
+			return first_byte == 1;
+		}();
+
+		return little_endian;
+	}
+
 	const int DataConversion::ADMMStep_to_int(ADMMStep step)
 	{
 		switch (step)
@@ -37,6 +54,7 @@ namespace grampcd
 		case ADMMStep::INITIALIZE: return 7;
 		case ADMMStep::SEND_TRUE_STATE: return 8;
 		case ADMMStep::PRINT: return 9;
+		case ADMMStep::PREDICT_STATE: return 10;
 		default: return -1;
 		}
 	}
@@ -55,6 +73,7 @@ namespace grampcd
 		case 7: return ADMMStep::INITIALIZE;
 		case 8: return ADMMStep::SEND_TRUE_STATE;
 		case 9: return ADMMStep::PRINT;
+		case 10: return ADMMStep::PREDICT_STATE;
 		default: return ADMMStep::UPDATE_AGENT_STATE;
 		}
 	}
@@ -70,25 +89,28 @@ namespace grampcd
 
 	void DataConversion::insert_into_charArray(const std::shared_ptr<std::vector<char>>& data, unsigned int& pos, const unsigned int a)
 	{
-		const char* ptr = reinterpret_cast<const char*>(&a);
-		for (unsigned int i = 0; i < sizeof(int); ++i)
-			(*data)[pos + i] = *(ptr + sizeof(int) - 1 - i);
+		// integers are sent in big endian byte order
+		std::memcpy(&(*data)[pos], &a, sizeof(int));
+		if (is_littleEndian())
+			std::reverse(data->begin() + pos, data->begin() + pos + sizeof(int));
 		pos += sizeof(int);
 	}
 
 	void DataConversion::insert_into_charArray(const std::shared_ptr<std::vector<char>>& data, unsigned int& pos, const int a)
 	{
-		const char* ptr = reinterpret_cast<const char*>(&a);
-		for (unsigned int i = 0; i < sizeof(int); ++i)
-			(*data)[pos + i] = *(ptr + sizeof(int) - 1 - i);
+		// integers are sent in big endian byte order
+		std::memcpy(&(*data)[pos], &a, sizeof(int));
+		if (is_littleEndian())
+			std::reverse(data->begin() + pos, data->begin() + pos + sizeof(int));
 		pos += sizeof(int);
 	}
 
 	void DataConversion::insert_into_charArray(const std::shared_ptr<std::vector<char>>& data, unsigned int& pos, const typeRNum a)
 	{
-		const char* ptr = reinterpret_cast<const char*>(&a);
-		for (unsigned int i = 0; i < sizeof(typeRNum); ++i)
-			(*data)[pos + i] = ptr[i];
+		// typeRNums are sent in little endian byte order
+		std::memcpy(&(*data)[pos], &a, sizeof(typeRNum));
+		if (!is_littleEndian())
+			std::reverse(data->begin() + pos, data->begin() + pos + sizeof(typeRNum));
 		pos += sizeof(typeRNum);
 	}
 
@@ -101,10 +123,17 @@ namespace grampcd
 		if (size_of_array == 0)
 			return;
 
-		// insert array
-		const char* ptr = reinterpret_cast<const char*>(&a[0]);
-		for (unsigned int k = 0; k < a.size(); ++k)
-			insert_into_charArray(data, pos, a[k]);
+		// insert array with a single copy if the byte order matches the wire format
+		if (is_littleEndian())
+		{
+			std::memcpy(&(*data)[pos], a.data(), size_of_array);
+			pos += size_of_array;
+		}
+		else
+		{
+			for (const auto value : a)
+				insert_into_charArray(data, pos, value);
+		}
 	}
 
 	void DataConversion::insert_into_charArray(const std::shared_ptr<std::vector<char>>& data, unsigned int& pos, const std::string& a)
@@ -131,24 +160,27 @@ namespace grampcd
 	void DataConversion::read_from_charArray(const std::vector<char>& data, unsigned int& pos, int& a)
 	{
 		char* ptr = reinterpret_cast<char*>(&a);
-		for (unsigned int i = 0; i < sizeof(int); ++i)
-			*(ptr + sizeof(int) - 1 - i) = data[pos + i];
+		std::memcpy(ptr, &data[pos], sizeof(int));
+		if (is_littleEndian())
+			std::reverse(ptr, ptr + sizeof(int));
 		pos += sizeof(int);
 	}
 
 	void DataConversion::read_from_charArray(const std::vector<char>& data, unsigned int& pos, unsigned int& a)
 	{
 		char* ptr = reinterpret_cast<char*>(&a);
-		for (unsigned int i = 0; i < sizeof(int); ++i)
-			*(ptr + sizeof(int) - 1 - i) = data[pos + i];
+		std::memcpy(ptr, &data[pos], sizeof(int));
+		if (is_littleEndian())
+			std::reverse(ptr, ptr + sizeof(int));
 		pos += sizeof(int);
 	}
 
 	void DataConversion::read_from_charArray(const std::vector<char>& data, unsigned int& pos, typeRNum& a)
 	{
 		char* ptr = reinterpret_cast<char*>(&a);
-		for (unsigned int i = 0; i < sizeof(typeRNum); ++i)
-			ptr[i] = data[pos + i];
+		std::memcpy(ptr, &data[pos], sizeof(typeRNum));
+		if (!is_littleEndian())
+			std::reverse(ptr, ptr + sizeof(typeRNum));
 		pos += sizeof(typeRNum);
 	}
 
@@ -170,10 +202,17 @@ namespace grampcd
 
 		a.resize(size_of_array, 0);
 
-		// read array
-		char* ptr = reinterpret_cast<char*>(&a[0]);
-		for (unsigned int k = 0; k < a.size(); ++k)
-			read_from_charArray(data, pos, a[k]);
+		// read array with a single copy if the byte order matches the wire format
+		if (is_littleEndian())
+		{
+			std::memcpy(a.data(), &data[pos], size_of_array * sizeof(typeRNum));
+			pos += static_cast<unsigned int>(size_of_array * sizeof(typeRNum));
+		}
+		else
+		{
+			for (auto& value : a)
+				read_from_charArray(data, pos, value);
+		}
 	}
 
 	void DataConversion::read_from_charArray(const std::vector<char>& data, unsigned int& pos, std::string& a)
@@ -191,6 +230,24 @@ namespace grampcd
 		pos += static_cast<unsigned int>(a.size());
 	}
 
+	void DataConversion::quantize(std::vector<typeRNum>& a, const unsigned int mantissa_bits, const typeRNum tolerance)
+	{
+		std::vector<typeRNum> quantized(a.size(), 0);
+		for (unsigned int k = 0; k < a.size(); ++k)
+		{
+			// a = m * 2^e with 0.5 <= |m| < 1
+			int exponent = 0;
+			const typeRNum mantissa = std::frexp(a[k], &exponent);
+			quantized[k] = std::ldexp(std::round(std::ldexp(mantissa, mantissa_bits + 1)), exponent - static_cast<int>(mantissa_bits) - 1);
+
+			// keep the exact values if the error bound is violated
+			if (std::abs(quantized[k] - a[k]) > tolerance)
+				return;
+		}
+
+		a = std::move(quantized);
+	}
+
 	void DataConversion::skip_in_charArray_bool(const std::vector<char>& data, unsigned int& pos)
 	{
 		++pos;
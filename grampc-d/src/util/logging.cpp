@@ -16,7 +16,9 @@ namespace grampcd
 {
 	std::ostream& Logging::print(const DebugType type) const
 	{
-		std::cout.clear();
+		// Disabled messages are written to a stream without buffer, which discards them.
+		// It is local to each thread, as several interfaces may print concurrently.
+		static thread_local std::ostream null_stream(nullptr);
 
 		switch (type)
 		{
@@ -40,7 +42,6 @@ namespace grampcd
 			break;
 		}
 
-		std::cout.setstate(std::ios_base::badbit);
-		return std::cout;
+		return null_stream;
 	}
 }
\ No newline at end of file
@@ -32,6 +32,8 @@
 
 #include "general_model_factory.hpp"
 
+#include <algorithm>
+
 namespace grampcd
 {
     void ProtocolCommunication::evaluateData(CommunicationDataPtr comm_data, CommunicationInterfaceLocal* communication_interface, const std::vector<char>& data)
@@ -54,12 +56,18 @@ namespace grampcd
         case index::send_solution:
             communication_interface->fromCommunication_send_solution(comm_data, ProtocolCommunication::buildFromProtocol_solution(data));
             break;
+        case index::get_solution_since:
+            communication_interface->fromCommunication_get_solution_since(comm_data, ProtocolCommunication::buildFromProtocol_indexOfDataPoint(data));
+            break;
         case index::register_agent:
             communication_interface->fromCommunication_register_agent(comm_data, ProtocolCommunication::buildFromProtocol_agentInfo(data));
             break;
         case index::register_coupling:
             communication_interface->fromCommunication_register_coupling(comm_data, ProtocolCommunication::buildFromProtocol_couplingInfo(data));
             break;
+        case index::register_couplings:
+            communication_interface->fromCommunication_register_couplings(comm_data, ProtocolCommunication::buildFromProtocol_couplingInfoArray(data));
+            break;
         case index::successfully_registered_coupling:
             communication_interface->fromCommunication_successfully_registered_coupling(comm_data,
                 ProtocolCommunication::buildFromProtocol_couplingInfo_from_successfully_registered_coupling(data),
@@ -118,7 +126,8 @@ namespace grampcd
             communication_interface->fromCommunication_send_agentState_for_simulation(comm_data, ProtocolCommunication::buildFromProtocol_agentState(data));
             break;
         case index::triggerStep:
-            communication_interface->fromCommunication_triggerStep(ProtocolCommunication::buildFromProtocol_ADMMStep(data));
+            communication_interface->fromCommunication_triggerStep(comm_data, ProtocolCommunication::buildFromProtocol_ADMMStep(data),
+                ProtocolCommunication::buildFromProtocol_stepTimeout_from_triggerStep(data));
             break;
         case index::get_agentModelFromAgent:
             communication_interface->fromCommunication_get_agentModelFromAgent(comm_data);
@@ -165,6 +174,24 @@ namespace grampcd
         case index::successfully_deregistered_agent:
             communication_interface->fromCommunication_successfully_deregistered_agent(comm_data, buildFromProtocol_agentInfo(data));
             break;
+        case index::send_wireFormat:
+            communication_interface->fromCommunication_send_wireFormat(comm_data,
+                buildFromProtocol_wireFormatVersion(data),
+                buildFromProtocol_sizeOfTypeRNum_from_wireFormat(data),
+                buildFromProtocol_littleEndian_from_wireFormat(data));
+            break;
+        case index::assign_partition:
+            communication_interface->fromCommunication_assign_partition(comm_data, buildFromProtocol_partition(data));
+            break;
+        case index::send_subCoordinatorInfo:
+            communication_interface->fromCommunication_send_subCoordinatorInfo(comm_data, buildFromProtocol_communicationInfo(data));
+            break;
+        case index::send_listeningPort:
+            communication_interface->fromCommunication_send_listeningPort(comm_data, buildFromProtocol_listeningPort(data));
+            break;
+        case index::close_channel:
+            communication_interface->fromCommunication_close_channel(comm_data);
+            break;
         default:
             const LoggingPtr& log = communication_interface->get_log();
             log->print(DebugType::Error) << "[ProtocolCommunication::evaluateData] Unknown index in protocol." << std::endl;
@@ -193,6 +220,219 @@ namespace grampcd
         return data;
     }
 
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_send_wireFormat()
+    {
+        const char index = static_cast<char>(index::send_wireFormat);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header + static_cast<unsigned int>(sizeof(unsigned int) + sizeof(char) + sizeof(bool));
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+        unsigned int pos = 0;
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // version
+        DataConversion::insert_into_charArray(data, pos, wire_format_version_);
+
+        // size of typeRNum
+        DataConversion::insert_into_charArray(data, pos, static_cast<char>(sizeof(typeRNum)));
+
+        // byte order of host
+        DataConversion::insert_into_charArray(data, pos, DataConversion::is_littleEndian());
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_offer_sharedMemory(const std::string& name)
+    {
+        const char index = static_cast<char>(index::offer_sharedMemory);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header + static_cast<unsigned int>(name.size() + sizeof(int));
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+        unsigned int pos = 0;
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // name of shared memory segment
+        DataConversion::insert_into_charArray(data, pos, name);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_accept_sharedMemory(const bool accepted)
+    {
+        const char index = static_cast<char>(index::accept_sharedMemory);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header + static_cast<unsigned int>(sizeof(bool));
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+        unsigned int pos = 0;
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // flag if shared memory is used
+        DataConversion::insert_into_charArray(data, pos, accepted);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_switch_to_sharedMemory()
+    {
+        const char index = static_cast<char>(index::switch_to_sharedMemory);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header;
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+        unsigned int pos = 0;
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_channelHeader(const int from, const int to, const unsigned int size_of_message)
+    {
+        const char index = static_cast<char>(index::channelMessage);
+        const unsigned int size_of_data = size_of_channelHeader_ + size_of_message;
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_channelHeader_, 0));
+        unsigned int pos = 0;
+
+        // size of data, including the message that follows the header
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // sending and receiving agent
+        DataConversion::insert_into_charArray(data, pos, from);
+        DataConversion::insert_into_charArray(data, pos, to);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_send_listeningPort(const unsigned int port)
+    {
+        const char index = static_cast<char>(index::send_listeningPort);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header + static_cast<unsigned int>(sizeof(unsigned int));
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+        unsigned int pos = 0;
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // port on which the host accepts connections
+        DataConversion::insert_into_charArray(data, pos, port);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_close_channel()
+    {
+        const char index = static_cast<char>(index::close_channel);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header;
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+        unsigned int pos = 0;
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_compressedMessage(const std::vector<char>& message, const std::shared_ptr< std::vector<char> >& reference)
+    {
+        const char index = static_cast<char>(index::compressedMessage);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_message = static_cast<unsigned int>(message.size());
+        const bool is_delta = reference != nullptr && reference->size() == message.size();
+
+        // the message is encoded in blocks of 8 bytes, each with a mask of the non-zero bytes
+        const unsigned int max_size_of_data = size_of_header
+            + static_cast<unsigned int>(sizeof(char) + sizeof(bool) + sizeof(unsigned int))
+            + size_of_message + (size_of_message + 7) / 8;
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(max_size_of_data, 0));
+        unsigned int pos = size_of_header;
+
+        // index and size of original message
+        DataConversion::insert_into_charArray(data, pos, message[position_of_index_in_protocol_]);
+        DataConversion::insert_into_charArray(data, pos, is_delta);
+        DataConversion::insert_into_charArray(data, pos, size_of_message);
+
+        // encode message, the difference to the reference is encoded for delta encoding
+        for (unsigned int block = 0; block < size_of_message; block += 8)
+        {
+            const unsigned int pos_of_mask = pos++;
+            char mask = 0;
+
+            for (unsigned int k = block; k < std::min(block + 8, size_of_message); ++k)
+            {
+                const char byte = is_delta ? static_cast<char>(message[k] ^ (*reference)[k]) : message[k];
+                if (byte != 0)
+                {
+                    mask |= static_cast<char>(1 << (k - block));
+                    (*data)[pos++] = byte;
+                }
+            }
+
+            (*data)[pos_of_mask] = mask;
+        }
+
+        data->resize(pos);
+
+        // size of data
+        const unsigned int size_of_data = pos;
+        pos = 0;
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_assign_partition(const std::vector<int>& agent_ids)
+    {
+        const char index = static_cast<char>(index::assign_partition);
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header + static_cast<unsigned int>(sizeof(unsigned int) + agent_ids.size() * sizeof(int));
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+        unsigned int pos = 0;
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // agents of the partition
+        DataConversion::insert_into_charArray(data, pos, static_cast<unsigned int>(agent_ids.size()));
+        for (const int id : agent_ids)
+            DataConversion::insert_into_charArray(data, pos, id);
+
+        return data;
+    }
+
     const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_get_ping()
     {
 		const char index = static_cast<char>(index::get_ping);
@@ -284,9 +524,10 @@ namespace grampcd
 
     const std::shared_ptr<std::vector<char>> ProtocolCommunication::buildProtocol_send_solution(const SolutionPtr& solution)
     {
-        AgentState& agent_state = solution->agentState_;
-        AgentState& predicted_agentState = solution->predicted_agentState_;
-        std::vector<typeRNum>& cost = solution->cost_;
+        // the history is sent in chronological order
+        const AgentState agent_state = solution->get_agentState();
+        const AgentState& predicted_agentState = solution->predicted_agentState_;
+        const std::vector<typeRNum> cost = solution->get_cost();
 
 		const auto size_of_header = static_cast<char>(first_element_with_data_);
         const unsigned int sizeOfData = size_of_header // header
@@ -306,7 +547,9 @@ namespace grampcd
                 + sizeof(typeRNum) * predicted_agentState.v_.size() + sizeof(int)
                 + sizeof(typeRNum) * predicted_agentState.x_.size() + sizeof(int)
                 // cost 
-                + sizeof(typeRNum) * cost.size() + sizeof(int));
+                + sizeof(typeRNum) * cost.size() + sizeof(int)
+                // index of the first data point
+                + sizeof(unsigned int));
 
         std::shared_ptr<std::vector<char>> data(new std::vector<char>(sizeOfData, 0));
         unsigned int pos = 0;
@@ -337,6 +580,29 @@ namespace grampcd
         // cost
         DataConversion::insert_into_charArray(data, pos, cost);
 
+        // index of the first data point
+        DataConversion::insert_into_charArray(data, pos, solution->get_indexOfFirstDataPoint());
+
+        return data;
+    }
+
+    const std::shared_ptr<std::vector<char>> ProtocolCommunication::buildProtocol_get_solution_since(const unsigned int index_of_data_point)
+    {
+		const char index = static_cast<char>(index::get_solution_since);
+		const auto size_of_header = static_cast<char>(first_element_with_data_);
+        const unsigned int size_of_data = size_of_header + sizeof(unsigned int);
+        std::shared_ptr<std::vector<char>> data(new std::vector<char>(size_of_data, 0));
+
+        // include sizeOfData
+        unsigned int pos = 0;
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // index of the first requested data point
+        DataConversion::insert_into_charArray(data, pos, index_of_data_point);
+
         return data;
     }
 
@@ -620,10 +886,19 @@ namespace grampcd
         return data;
     }
 
-    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_triggerStep(const ADMMStep& step)
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_send_subCoordinatorInfo(const CommunicationInfo& info)
+    {
+        // same layout as a communication info, only the index differs
+        const auto data = buildProtocol_send_communicationInfo(info);
+        (*data)[position_of_index_in_protocol_] = static_cast<char>(index::send_subCoordinatorInfo);
+
+        return data;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_triggerStep(const ADMMStep& step, const unsigned int step_timeout_ms)
 	{
 		const auto size_of_header = static_cast<char>(first_element_with_data_);
-        const unsigned int sizeOfData = size_of_header + sizeof(int);
+        const unsigned int sizeOfData = size_of_header + sizeof(int) + sizeof(unsigned int);
         std::shared_ptr< std::vector<char> > data(new std::vector<char>(sizeOfData, 0));
         unsigned int pos = 0;
 
@@ -636,6 +911,9 @@ namespace grampcd
         // include step
         DataConversion::insert_into_charArray(data, pos, DataConversion::ADMMStep_to_int(step));
 
+        // include deadline for sub-coordinators, zero for agents
+        DataConversion::insert_into_charArray(data, pos, step_timeout_ms);
+
         return data;
     }
 
@@ -705,6 +983,39 @@ namespace grampcd
         return data;
     }
 
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_register_couplings(const std::vector<CouplingInfo>& coupling_infos)
+    {
+        const char index = static_cast<char>(index::register_couplings);
+        unsigned int pos = 0;
+        const auto size_of_header = static_cast<char>(first_element_with_data_);
+        unsigned int size_of_data = size_of_header + static_cast<unsigned int>(sizeof(unsigned int));
+        for (const auto& coupling_info : coupling_infos)
+            size_of_data += static_cast<unsigned int>(sizeof(coupling_info.agent_id_)
+                + sizeof(coupling_info.neighbor_id_)
+                + coupling_info.model_name_.size() + sizeof(int)
+                + sizeof(typeRNum) * coupling_info.model_parameters_.size() + sizeof(int));
+
+        std::shared_ptr< std::vector<char> > data(new std::vector<char>(size_of_data, 0));
+
+        // size of data
+        DataConversion::insert_into_charArray(data, pos, size_of_data);
+
+        // index
+        DataConversion::insert_into_charArray(data, pos, index);
+
+        // coupling infos
+        DataConversion::insert_into_charArray(data, pos, static_cast<unsigned int>(coupling_infos.size()));
+        for (const auto& coupling_info : coupling_infos)
+        {
+            DataConversion::insert_into_charArray(data, pos, coupling_info.agent_id_);
+            DataConversion::insert_into_charArray(data, pos, coupling_info.neighbor_id_);
+            DataConversion::insert_into_charArray(data, pos, coupling_info.model_name_);
+            DataConversion::insert_into_charArray(data, pos, coupling_info.model_parameters_);
+        }
+
+        return data;
+    }
+
     const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildProtocol_deregister_agent(const AgentInfo& info)
     {
         // start with protocol for registering an agent
@@ -1045,6 +1356,9 @@ namespace grampcd
                 + sizeof(info.COMMON_Nhor_)
                 + sizeof(info.COMMON_ShiftControl_)
                 + info.COMMON_Integrator_.size() + sizeof(int)
+                + sizeof(info.COMMON_IntegratorSubsteps_)
+                + sizeof(info.COMMON_IntegratorRelTol_)
+                + sizeof(info.COMMON_IntegratorAbsTol_)
                 // GRAMPC
                 + sizeof(info.GRAMPC_MaxGradIter_)
                 + sizeof(info.GRAMPC_MaxMultIter_)
@@ -1075,7 +1389,14 @@ namespace grampcd
                 // APPROX
                 + sizeof(info.APPROX_ApproximateCost_)
                 + sizeof(info.APPROX_ApproximateConstraints_)
-                + sizeof(info.APPROX_ApproximateDynamics_));
+                + sizeof(info.APPROX_ApproximateDynamics_)
+                // COMM
+                + sizeof(info.COMM_DeltaEncoding_)
+                + info.COMM_Quantization_.size() + sizeof(int)
+                + sizeof(info.COMM_QuantizationTolerance_)
+                + sizeof(info.COMM_Multicast_)
+                + info.COMM_MulticastAddress_.size() + sizeof(int)
+                + sizeof(info.COMM_MulticastPort_));
 
         std::shared_ptr< std::vector<char> >data(new std::vector<char>(size_of_data, 0));
         unsigned int pos = 0;
@@ -1096,6 +1417,9 @@ namespace grampcd
         DataConversion::insert_into_charArray(data, pos, info.COMMON_Nhor_);
         DataConversion::insert_into_charArray(data, pos, info.COMMON_ShiftControl_);
         DataConversion::insert_into_charArray(data, pos, info.COMMON_Integrator_);
+        DataConversion::insert_into_charArray(data, pos, info.COMMON_IntegratorSubsteps_);
+        DataConversion::insert_into_charArray(data, pos, info.COMMON_IntegratorRelTol_);
+        DataConversion::insert_into_charArray(data, pos, info.COMMON_IntegratorAbsTol_);
 
         /**************************
          * GRAMPC
@@ -1140,6 +1464,17 @@ namespace grampcd
         DataConversion::insert_into_charArray(data, pos, info.APPROX_ApproximateConstraints_);
         DataConversion::insert_into_charArray(data, pos, info.APPROX_ApproximateDynamics_);
 
+        /**************************
+         * COMM
+        **************************/
+
+        DataConversion::insert_into_charArray(data, pos, info.COMM_DeltaEncoding_);
+        DataConversion::insert_into_charArray(data, pos, info.COMM_Quantization_);
+        DataConversion::insert_into_charArray(data, pos, info.COMM_QuantizationTolerance_);
+        DataConversion::insert_into_charArray(data, pos, info.COMM_Multicast_);
+        DataConversion::insert_into_charArray(data, pos, info.COMM_MulticastAddress_);
+        DataConversion::insert_into_charArray(data, pos, info.COMM_MulticastPort_);
+
         return data;
     }
 
@@ -1169,9 +1504,21 @@ namespace grampcd
 
 		DataConversion::read_from_charArray(data, pos, solution->cost_);
 
+		unsigned int index_of_first_data_point = 0;
+		DataConversion::read_from_charArray(data, pos, index_of_first_data_point);
+		solution->set_indexOfFirstDataPoint(index_of_first_data_point);
+
 		return solution;
 	}
 
+    const unsigned int ProtocolCommunication::buildFromProtocol_indexOfDataPoint(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        unsigned int index = 0;
+        DataConversion::read_from_charArray(data, pos, index);
+        return index;
+    }
+
     const int ProtocolCommunication::buildFromProtocol_numberOfActiveCouplings(const std::vector<char>& data)
     {
         unsigned int pos = static_cast<char>(first_element_with_data_);
@@ -1180,6 +1527,142 @@ namespace grampcd
         return number;
     }
 
+    const unsigned int ProtocolCommunication::buildFromProtocol_wireFormatVersion(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        unsigned int version = 0;
+        DataConversion::read_from_charArray(data, pos, version);
+        return version;
+    }
+
+    const unsigned int ProtocolCommunication::buildFromProtocol_sizeOfTypeRNum_from_wireFormat(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+
+        // skip version
+        DataConversion::skip_in_charArray_int(data, pos);
+
+        return static_cast<unsigned int>(data[pos]);
+    }
+
+    const bool ProtocolCommunication::buildFromProtocol_littleEndian_from_wireFormat(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+
+        // skip version and size of typeRNum
+        DataConversion::skip_in_charArray_int(data, pos);
+        DataConversion::skip_in_charArray_char(data, pos);
+
+        bool little_endian = false;
+        DataConversion::read_from_charArray(data, pos, little_endian);
+        return little_endian;
+    }
+
+    const std::string ProtocolCommunication::buildFromProtocol_name_from_offer_sharedMemory(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        std::string name;
+        DataConversion::read_from_charArray(data, pos, name);
+        return name;
+    }
+
+    const bool ProtocolCommunication::buildFromProtocol_accepted_from_accept_sharedMemory(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        bool accepted = false;
+        DataConversion::read_from_charArray(data, pos, accepted);
+        return accepted;
+    }
+
+    const int ProtocolCommunication::buildFromProtocol_from_channelMessage(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        int from = 0;
+        DataConversion::read_from_charArray(data, pos, from);
+        return from;
+    }
+
+    const int ProtocolCommunication::buildFromProtocol_to_channelMessage(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_) + static_cast<unsigned int>(sizeof(int));
+        int to = 0;
+        DataConversion::read_from_charArray(data, pos, to);
+        return to;
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildFromProtocol_message_from_channelMessage(const std::vector<char>& data)
+    {
+        return std::make_shared< std::vector<char> >(data.begin() + size_of_channelHeader_, data.end());
+    }
+
+    const unsigned int ProtocolCommunication::buildFromProtocol_listeningPort(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        unsigned int port = 0;
+        DataConversion::read_from_charArray(data, pos, port);
+        return port;
+    }
+
+    const char ProtocolCommunication::buildFromProtocol_index_from_compressedMessage(const std::vector<char>& data)
+    {
+        return data[first_element_with_data_];
+    }
+
+    const std::shared_ptr< std::vector<char> > ProtocolCommunication::buildFromProtocol_compressedMessage(const std::vector<char>& data, const std::shared_ptr< std::vector<char> >& reference)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+
+        // skip index of original message
+        DataConversion::skip_in_charArray_char(data, pos);
+
+        bool is_delta = false;
+        DataConversion::read_from_charArray(data, pos, is_delta);
+
+        unsigned int size_of_message = 0;
+        DataConversion::read_from_charArray(data, pos, size_of_message);
+
+        // the reference must be the last message with the same index
+        if (is_delta && (reference == nullptr || reference->size() != size_of_message))
+            return nullptr;
+
+        std::shared_ptr< std::vector<char> > message(new std::vector<char>(size_of_message, 0));
+        for (unsigned int block = 0; block < size_of_message; block += 8)
+        {
+            if (pos >= data.size())
+                return nullptr;
+
+            const char mask = data[pos++];
+            for (unsigned int k = block; k < std::min(block + 8, size_of_message); ++k)
+            {
+                if ((mask >> (k - block)) & 1)
+                {
+                    if (pos >= data.size())
+                        return nullptr;
+
+                    (*message)[k] = data[pos++];
+                }
+
+                if (is_delta)
+                    (*message)[k] ^= (*reference)[k];
+            }
+        }
+
+        return message;
+    }
+
+    const std::shared_ptr< std::vector<int> > ProtocolCommunication::buildFromProtocol_partition(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        unsigned int number = 0;
+        DataConversion::read_from_charArray(data, pos, number);
+
+        std::shared_ptr< std::vector<int> > agent_ids(new std::vector<int>(number, 0));
+        for (auto& id : *agent_ids)
+            DataConversion::read_from_charArray(data, pos, id);
+
+        return agent_ids;
+    }
+
     const typeRNum ProtocolCommunication::buildFromProtocol_t0_from_simulatedState(const std::vector<char>& data)
     {
         unsigned int pos = static_cast<char>(first_element_with_data_);
@@ -1360,6 +1843,17 @@ namespace grampcd
         return DataConversion::Int_to_ADMMStep(step);
     }
 
+    const unsigned int ProtocolCommunication::buildFromProtocol_stepTimeout_from_triggerStep(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        DataConversion::skip_in_charArray_int(data, pos);
+
+        unsigned int step_timeout_ms = 0;
+        DataConversion::read_from_charArray(data, pos, step_timeout_ms);
+
+        return step_timeout_ms;
+    }
+
     const std::shared_ptr< AgentInfo > ProtocolCommunication::buildFromProtocol_agentInfo(const std::vector<char>& data)
     {
         std::shared_ptr< AgentInfo > info(new AgentInfo);
@@ -1387,6 +1881,24 @@ namespace grampcd
         return info;
     }
 
+    const std::shared_ptr< std::vector<CouplingInfo> > ProtocolCommunication::buildFromProtocol_couplingInfoArray(const std::vector<char>& data)
+    {
+        unsigned int pos = static_cast<char>(first_element_with_data_);
+        unsigned int number = 0;
+        DataConversion::read_from_charArray(data, pos, number);
+
+        std::shared_ptr< std::vector<CouplingInfo> > infos(new std::vector<CouplingInfo>(number));
+        for (auto& info : *infos)
+        {
+            DataConversion::read_from_charArray(data, pos, info.agent_id_);
+            DataConversion::read_from_charArray(data, pos, info.neighbor_id_);
+            DataConversion::read_from_charArray(data, pos, info.model_name_);
+            DataConversion::read_from_charArray(data, pos, info.model_parameters_);
+        }
+
+        return infos;
+    }
+
     const std::shared_ptr< CommunicationInfo > ProtocolCommunication::buildFromProtocol_communicationInfo_from_successfully_registered_coupling(const std::vector<char>& data)
     {
         std::shared_ptr< CommunicationInfo > info(new CommunicationInfo);
@@ -1460,6 +1972,9 @@ namespace grampcd
         DataConversion::read_from_charArray(data, pos, info->COMMON_Nhor_);
         DataConversion::read_from_charArray(data, pos, info->COMMON_ShiftControl_);
         DataConversion::read_from_charArray(data, pos, info->COMMON_Integrator_);
+        DataConversion::read_from_charArray(data, pos, info->COMMON_IntegratorSubsteps_);
+        DataConversion::read_from_charArray(data, pos, info->COMMON_IntegratorRelTol_);
+        DataConversion::read_from_charArray(data, pos, info->COMMON_IntegratorAbsTol_);
 
         /**************************
          * GRAMPC
@@ -1502,6 +2017,17 @@ namespace grampcd
         DataConversion::read_from_charArray(data, pos, info->APPROX_ApproximateConstraints_);
         DataConversion::read_from_charArray(data, pos, info->APPROX_ApproximateDynamics_);
 
+        /**************************
+         * COMM
+        **************************/
+
+        DataConversion::read_from_charArray(data, pos, info->COMM_DeltaEncoding_);
+        DataConversion::read_from_charArray(data, pos, info->COMM_Quantization_);
+        DataConversion::read_from_charArray(data, pos, info->COMM_QuantizationTolerance_);
+        DataConversion::read_from_charArray(data, pos, info->COMM_Multicast_);
+        DataConversion::read_from_charArray(data, pos, info->COMM_MulticastAddress_);
+        DataConversion::read_from_charArray(data, pos, info->COMM_MulticastPort_);
+
         return info;
     }
 
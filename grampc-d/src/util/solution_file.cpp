@@ -0,0 +1,208 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/util/solution_file.hpp"
+
+#include "grampcd/optim/solution.hpp"
+
+#include "grampcd/util/data_conversion.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace grampcd
+{
+
+	namespace
+	{
+		const char magic[8] = { 'G', 'R', 'A', 'M', 'P', 'C', 'D', '\0' };
+		const std::size_t size_of_preamble = sizeof(magic) + sizeof(std::uint64_t);
+
+		/*@brief Column of the file that references strided values of the solution.*/
+		struct Column
+		{
+			std::string name_;
+			const typeRNum* values_;
+			std::size_t length_;
+			std::size_t stride_;
+		};
+
+		/*Returns the integer that follows the key in the header, or -1 if the key is missing.*/
+		long long read_integer(const std::string& header, const std::string& key, std::size_t& pos)
+		{
+			pos = header.find("\"" + key + "\": ", pos);
+			if (pos == std::string::npos)
+				return -1;
+
+			pos += key.size() + 4;
+			return std::strtoll(header.c_str() + pos, nullptr, 10);
+		}
+	}
+
+	const bool SolutionFile::write(const Solution& solution, const std::string& filename)
+	{
+		// the columns are written in chronological order
+		const auto agent_state = solution.get_agentState();
+		const auto cost = solution.get_cost();
+		const auto& debug_cost = solution.debug_cost_;
+
+		const std::size_t rows = agent_state.t_.size();
+		const std::size_t Nx = rows > 0 ? agent_state.x_.size() / rows : 0;
+		const std::size_t Nu = rows > 0 ? agent_state.u_.size() / rows : 0;
+
+		std::vector<Column> columns;
+		columns.push_back({ "t", agent_state.t_.data(), rows, 1 });
+		for (std::size_t i = 0; i < Nx; ++i)
+			columns.push_back({ "x" + std::to_string(i), agent_state.x_.data() + i, rows, Nx });
+		for (std::size_t i = 0; i < Nu; ++i)
+			columns.push_back({ "u" + std::to_string(i), agent_state.u_.data() + i, rows, Nu });
+		if (Nx > 0 && !agent_state.v_.empty())
+		{
+			for (std::size_t i = 0; i < Nx; ++i)
+				columns.push_back({ "v" + std::to_string(i), agent_state.v_.data() + i, agent_state.v_.size() / Nx, Nx });
+		}
+		columns.push_back({ "cost", cost.data(), cost.size(), 1 });
+		columns.push_back({ "debug_cost", debug_cost.data(), debug_cost.size(), 1 });
+
+		// header
+		std::ostringstream stream;
+		stream << "{\"format\": \"grampcd-solution\", \"version\": 1, \"byte_order\": \"little\", \"dtype\": \"float64\", "
+			<< "\"agent_id\": " << agent_state.i_ << ", \"Nx\": " << Nx << ", \"Nu\": " << Nu << ", \"columns\": [";
+
+		std::size_t size_of_data = 0;
+		for (std::size_t k = 0; k < columns.size(); ++k)
+		{
+			stream << (k > 0 ? ", " : "") << "{\"name\": \"" << columns[k].name_ << "\", \"length\": "
+				<< columns[k].length_ << ", \"offset\": " << size_of_data << "}";
+			size_of_data += columns[k].length_ * sizeof(double);
+		}
+		stream << "]}\n";
+
+		// the header is padded, such that the data is aligned to 8 bytes
+		auto header = stream.str();
+		header.append((8 - (size_of_preamble + header.size()) % 8) % 8, ' ');
+
+		// the whole file is written at once
+		std::vector<char> data(size_of_preamble + header.size() + size_of_data);
+		std::memcpy(data.data(), magic, sizeof(magic));
+
+		const auto size_of_header = static_cast<std::uint64_t>(header.size());
+		for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i)
+			data[sizeof(magic) + i] = static_cast<char>((size_of_header >> (8 * i)) & 0xff);
+		std::memcpy(data.data() + size_of_preamble, header.data(), header.size());
+
+		auto pos = data.data() + size_of_preamble + header.size();
+		for (const auto& column : columns)
+		{
+			for (std::size_t k = 0; k < column.length_; ++k)
+			{
+				const auto value = static_cast<double>(column.values_[k * column.stride_]);
+				std::memcpy(pos, &value, sizeof(double));
+				if (!DataConversion::is_littleEndian())
+					std::reverse(pos, pos + sizeof(double));
+				pos += sizeof(double);
+			}
+		}
+
+		std::ofstream file(filename, std::ios::binary);
+		if (!file)
+			return false;
+
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+		return static_cast<bool>(file);
+	}
+
+	const SolutionPtr SolutionFile::read(const std::string& filename)
+	{
+		std::ifstream file(filename, std::ios::binary);
+		if (!file)
+			return nullptr;
+
+		const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		if (data.size() < size_of_preamble || std::memcmp(data.data(), magic, sizeof(magic)) != 0)
+			return nullptr;
+
+		std::uint64_t size_of_header = 0;
+		for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i)
+			size_of_header |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[sizeof(magic) + i])) << (8 * i);
+		if (size_of_header > data.size() - size_of_preamble)
+			return nullptr;
+
+		const std::string header(data.data() + size_of_preamble, static_cast<std::size_t>(size_of_header));
+		const auto first_data = data.data() + size_of_preamble + size_of_header;
+		const auto size_of_data = data.size() - size_of_preamble - static_cast<std::size_t>(size_of_header);
+
+		std::size_t pos = 0;
+		const auto agent_id = read_integer(header, "agent_id", pos);
+		const auto Nx = read_integer(header, "Nx", pos);
+		const auto Nu = read_integer(header, "Nu", pos);
+		if (Nx < 0 || Nu < 0)
+			return nullptr;
+
+		SolutionPtr solution(new Solution);
+		solution->agentState_.i_ = static_cast<int>(agent_id);
+
+		// read the columns in the order of the header
+		while ((pos = header.find("{\"name\": \"", pos)) != std::string::npos)
+		{
+			pos += 10;
+			const auto end_of_name = header.find('"', pos);
+			if (end_of_name == std::string::npos)
+				return nullptr;
+			const auto name = header.substr(pos, end_of_name - pos);
+
+			const auto length = read_integer(header, "length", pos);
+			const auto offset = read_integer(header, "offset", pos);
+			if (length < 0 || offset < 0 || static_cast<std::size_t>(offset + length * sizeof(double)) > size_of_data)
+				return nullptr;
+
+			std::vector<typeRNum>* values = nullptr;
+			std::size_t index = 0;
+			std::size_t stride = 1;
+
+			if (name == "t")
+				values = &solution->agentState_.t_;
+			else if (name == "cost")
+				values = &solution->cost_;
+			else if (name == "debug_cost")
+				values = &solution->debug_cost_;
+			else if (name.size() > 1 && (name[0] == 'x' || name[0] == 'u' || name[0] == 'v'))
+			{
+				index = std::strtoul(name.c_str() + 1, nullptr, 10);
+				stride = static_cast<std::size_t>(name[0] == 'u' ? Nu : Nx);
+				values = name[0] == 'x' ? &solution->agentState_.x_ : name[0] == 'u' ? &solution->agentState_.u_ : &solution->agentState_.v_;
+			}
+
+			// unknown columns are skipped
+			if (values == nullptr || index >= stride)
+				continue;
+
+			values->resize(std::max(values->size(), static_cast<std::size_t>(length) * stride));
+			for (std::size_t k = 0; k < static_cast<std::size_t>(length); ++k)
+			{
+				double value = 0;
+				char bytes[sizeof(double)];
+				std::memcpy(bytes, first_data + offset + k * sizeof(double), sizeof(double));
+				if (!DataConversion::is_littleEndian())
+					std::reverse(bytes, bytes + sizeof(double));
+				std::memcpy(&value, bytes, sizeof(double));
+				(*values)[k * stride + index] = static_cast<typeRNum>(value);
+			}
+		}
+
+		return solution;
+	}
+
+}
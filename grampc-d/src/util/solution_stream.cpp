@@ -0,0 +1,155 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/util/solution_stream.hpp"
+
+#include "grampcd/util/logging.hpp"
+
+#include <algorithm>
+
+namespace grampcd
+{
+
+	SolutionStream::SolutionStream(const LoggingPtr& log, const std::string& prefix, const unsigned int queue_capacity) :
+		log_(log),
+		prefix_(prefix),
+		queue_capacity_(std::max(1u, queue_capacity)),
+		writer_(&SolutionStream::write_dataPoints, this)
+	{}
+
+	SolutionStream::~SolutionStream()
+	{
+		stop();
+	}
+
+	void SolutionStream::push(const int agent_id, const typeRNum t0, const std::vector<typeRNum>& x, const typeRNum cost,
+		const AgentState& predicted_agent_state, const std::vector<typeRNum>& predicted_cost)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		// back-pressure, the agent waits until the writer catches up
+		is_not_full_.wait(lock, [this]() { return is_stopped_ || queue_.size() < queue_capacity_; });
+		if (is_stopped_)
+			return;
+
+		queue_.push_back({ agent_id, t0, x, cost, predicted_agent_state, predicted_cost });
+		lock.unlock();
+
+		is_not_empty_.notify_one();
+	}
+
+	void SolutionStream::stop()
+	{
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+			is_stopped_ = true;
+		}
+		is_not_empty_.notify_all();
+		is_not_full_.notify_all();
+
+		if (writer_.joinable())
+			writer_.join();
+	}
+
+	void SolutionStream::write_dataPoints()
+	{
+		std::deque<DataPoint> data_points;
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				is_not_empty_.wait(lock, [this]() { return is_stopped_ || !queue_.empty(); });
+
+				if (queue_.empty())
+					break;
+
+				// take all queued data points at once, such that the agents are not blocked while writing
+				data_points.swap(queue_);
+			}
+			is_not_full_.notify_all();
+
+			for (const auto& data_point : data_points)
+				write_dataPoint(data_point);
+			data_points.clear();
+
+			for (auto& [id, files] : files_)
+			{
+				files.simulated_.flush();
+				files.predicted_.flush();
+			}
+		}
+
+		files_.clear();
+	}
+
+	void SolutionStream::write_dataPoint(const DataPoint& data_point)
+	{
+		const auto& predicted = data_point.predicted_agentState_;
+		if (predicted.t_.empty())
+			return;
+
+		const auto Nx = static_cast<unsigned int>(data_point.x_.size());
+		const auto Nu = static_cast<unsigned int>(predicted.u_.size() / predicted.t_.size());
+
+		auto iter = files_.find(data_point.agent_id_);
+		if (iter == files_.end())
+		{
+			iter = files_.emplace(data_point.agent_id_, Files()).first;
+			auto& files = iter->second;
+
+			const auto filename = prefix_ + std::to_string(data_point.agent_id_);
+			files.simulated_.open(filename + ".txt");
+			files.predicted_.open(filename + "_predicted.txt");
+
+			if (!files.simulated_ || !files.predicted_)
+				log_->print(DebugType::Error) << "[SolutionStream::write_dataPoint] "
+				<< "Failed to open file " << filename << "." << std::endl;
+
+			files.simulated_ << "AgentState_t\t";
+			for (unsigned int i = 0; i < Nx; ++i)
+				files.simulated_ << "AgentState_x" << i << "\t";
+			for (unsigned int i = 0; i < Nu; ++i)
+				files.simulated_ << "AgentState_u" << i << "\t";
+			files.simulated_ << "Cost\n";
+
+			files.predicted_ << "Sampling_t\tPredicted_t\t";
+			for (unsigned int i = 0; i < Nx; ++i)
+				files.predicted_ << "Predicted_x" << i << "\t";
+			for (unsigned int i = 0; i < Nu; ++i)
+				files.predicted_ << "Predicted_u" << i << "\t";
+			files.predicted_ << "Predicted_Cost\n";
+		}
+
+		auto& files = iter->second;
+
+		// simulated data point, the first predicted control is the one that is applied
+		files.simulated_ << data_point.t0_ << "\t";
+		for (unsigned int i = 0; i < Nx; ++i)
+			files.simulated_ << data_point.x_[i] << "\t";
+		for (unsigned int i = 0; i < Nu; ++i)
+			files.simulated_ << predicted.u_[i] << "\t";
+		files.simulated_ << data_point.cost_ << "\n";
+
+		// predicted trajectory
+		for (unsigned int k = 0; k < predicted.t_.size(); ++k)
+		{
+			files.predicted_ << data_point.t0_ << "\t" << predicted.t_[k] << "\t";
+			for (unsigned int i = 0; i < Nx; ++i)
+				files.predicted_ << predicted.x_[k * Nx + i] << "\t";
+			for (unsigned int i = 0; i < Nu; ++i)
+				files.predicted_ << predicted.u_[k * Nu + i] << "\t";
+			files.predicted_ << (k < data_point.predicted_cost_.size() ? data_point.predicted_cost_[k] : 0) << "\n";
+		}
+	}
+
+}
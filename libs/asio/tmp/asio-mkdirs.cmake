@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/libs/asio/src/asio"
+  "/root/repo/libs/asio/src/asio-build"
+  "/root/repo/libs/asio"
+  "/root/repo/libs/asio/tmp"
+  "/root/repo/libs/asio/src/asio-stamp"
+  "/root/repo/libs/asio/src"
+  "/root/repo/libs/asio/src/asio-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/libs/asio/src/asio-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/libs/asio/src/asio-stamp${cfgdir}") # cfgdir has leading slash
+endif()
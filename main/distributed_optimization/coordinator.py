@@ -57,21 +57,18 @@ interface.wait_for_connections(3, 4)
 # run distributed controller
 interface.run_DMPC(0, Tsim)
 
-# get solutions
-solution_DMPC = interface.get_solution('all')
+# get solutions as arrays with the agents as first axis
+solution_DMPC = interface.get_solution_arrays('all')
 
 interface.send_flag_to_agents('all')
 
 #calculate global cost
-global_cost_DMPC = [0] * len(solution_DMPC[0].agentState_.t_);
-for i in range(0, 3) :
-    for j in range(0, len(solution_DMPC[0].agentState_.t_)) :
-        global_cost_DMPC[j] = global_cost_DMPC[j] + solution_DMPC[i].cost_[j]
+global_cost_DMPC = solution_DMPC['cost'].sum(axis=0)
 
 fig = plt.figure()
 fig.suptitle('Simulation example \n Distributed optimization', y=1)
 
-plt.plot(solution_DMPC[0].agentState_.t_, global_cost_DMPC, 'r--')
+plt.plot(solution_DMPC['t'][0], global_cost_DMPC, 'r--')
 plt.ylabel('Global cost')
 plt.xlabel('Simulation time in s')
 
@@ -63,7 +63,9 @@ int main(int argc, char** argv)
 	coupling_info.neighbor_id_ = 0;
 	interface->register_coupling(coupling_info);
 
+	// only the last 100 data points are kept in memory, while the whole history is appended to files
 	interface->cap_stored_data(100);
+	interface->stream_solution_to_file();
 
 	while (true)
 		interface->wait_blocking_s(1);
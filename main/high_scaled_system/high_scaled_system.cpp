@@ -142,6 +142,7 @@ int main(int argc, char** argv)
         }
     }
 
+    std::vector<grampcd::CouplingInfo> couplings;
     idx = 0;
     for (unsigned int i = 0; i < n_agents_y; ++i)
     {
@@ -153,34 +154,37 @@ int main(int argc, char** argv)
             if (j > 0)
             {
                 coupling_info.neighbor_id_ = idx - 1;
-                interface->register_coupling(coupling_info);
+                couplings.push_back(coupling_info);
             }
 
             // coupling with neighbor on the right
             if (j < n_agents_x - 1)
             {
                 coupling_info.neighbor_id_ = idx + 1;
-                interface->register_coupling(coupling_info);
+                couplings.push_back(coupling_info);
             }
 
             // coupling with neighbor above
             if (i > 0)
             {
                 coupling_info.neighbor_id_ = idx - n_agents_x;
-                interface->register_coupling(coupling_info);
+                couplings.push_back(coupling_info);
             }
 
             // coupling with neighbor below
             if (i < n_agents_y - 1)
             {
                 coupling_info.neighbor_id_ = idx + n_agents_x;
-                interface->register_coupling(coupling_info);
+                couplings.push_back(coupling_info);
             }
 
             idx = idx + 1;
         }
     }
 
+    // register the couplings at once
+    interface->register_couplings(couplings);
+
     // run DMPC
     interface->run_DMPC(0, Tsim);
 
@@ -0,0 +1,138 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/interface/scenario_runner.hpp"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+
+int main(int argc, char** argv)
+{
+    // create runner
+    grampcd::ScenarioRunner runner;
+
+    // set optimization info
+    grampcd::OptimizationInfo optimization_info;
+    optimization_info.COMMON_Nhor_ = 21;
+    optimization_info.COMMON_Thor_ = 2;
+    optimization_info.COMMON_dt_ = 0.02;
+    optimization_info.GRAMPC_MaxGradIter_ = 15;
+    optimization_info.GRAMPC_MaxMultIter_ = 1;
+    optimization_info.ADMM_maxIterations_ = 10;
+    optimization_info.ADMM_ConvergenceTolerance_ = 0.002;
+
+    typeRNum Tsim = 2;
+
+    // parameters for cost function
+    typeRNum P_x = 1; typeRNum P_vx = 1; typeRNum P_y = 1; typeRNum P_vy = 1;
+    typeRNum Q_vx = 2; typeRNum Q_vy = 2;
+    typeRNum R_ux = 0.01; typeRNum R_uy = 0.01;
+
+    // model parameters
+    typeRNum m_agent = 7.5; typeRNum c = 0.5;
+
+    // number of agents
+    const unsigned int n_agents_x = 3;
+    const unsigned int n_agents_y = 3;
+
+    // parameter sweep over the weights of the positions and the number of ADMM iterations,
+    // each with randomized initial states
+    const std::vector<typeRNum> Q_positions = { 1, 5, 10 };
+    const std::vector<unsigned int> ADMM_iterations = { 5, 10 };
+    const unsigned int n_samples = 4;
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<typeRNum> distribution(0.0, 0.4);
+
+    for (const auto Q_position : Q_positions)
+    {
+        for (const auto iterations : ADMM_iterations)
+        {
+            for (unsigned int sample = 0; sample < n_samples; ++sample)
+            {
+                grampcd::ScenarioInfo scenario;
+                scenario.name_ = "Q" + std::to_string(static_cast<int>(Q_position))
+                    + "_ADMM" + std::to_string(iterations) + "_sample" + std::to_string(sample);
+                scenario.optimization_info_ = optimization_info;
+                scenario.optimization_info_.ADMM_maxIterations_ = iterations;
+                scenario.Tsim_ = Tsim;
+
+                // agents
+                grampcd::AgentInfo agent_info;
+                agent_info.model_name_ = "ssms2d_agentModel";
+                agent_info.model_parameters_ = { m_agent, 1 };
+                agent_info.cost_parameters_ = { P_x, P_vx, P_y, P_vy, Q_position, Q_vx, Q_position, Q_vy, R_ux, R_uy };
+
+                for (unsigned int i = 0; i < n_agents_x; ++i)
+                {
+                    for (unsigned int j = 0; j < n_agents_y; ++j)
+                    {
+                        agent_info.id_ = i * n_agents_x + j;
+                        scenario.agents_.push_back(agent_info);
+                        scenario.x_init_.push_back({ static_cast<typeRNum>(i) + distribution(generator), 0.0,
+                            static_cast<typeRNum>(j) + distribution(generator), 0.0 });
+                        scenario.u_init_.push_back({ 0, 0 });
+                        scenario.x_des_.push_back({ static_cast<typeRNum>(i), 0, static_cast<typeRNum>(j), 0 });
+                        scenario.u_des_.push_back({ 0, 0 });
+                    }
+                }
+
+                // couplings with the neighbors on the left, right, above and below
+                grampcd::CouplingInfo coupling_info;
+                coupling_info.model_name_ = "ssms2d_couplingModel";
+                coupling_info.model_parameters_ = { m_agent, c };
+
+                for (unsigned int i = 0; i < n_agents_y; ++i)
+                {
+                    for (unsigned int j = 0; j < n_agents_x; ++j)
+                    {
+                        const int idx = i * n_agents_x + j;
+                        coupling_info.agent_id_ = idx;
+
+                        if (j > 0)
+                        {
+                            coupling_info.neighbor_id_ = idx - 1;
+                            scenario.couplings_.push_back(coupling_info);
+                        }
+                        if (j < n_agents_x - 1)
+                        {
+                            coupling_info.neighbor_id_ = idx + 1;
+                            scenario.couplings_.push_back(coupling_info);
+                        }
+                        if (i > 0)
+                        {
+                            coupling_info.neighbor_id_ = idx - n_agents_x;
+                            scenario.couplings_.push_back(coupling_info);
+                        }
+                        if (i < n_agents_y - 1)
+                        {
+                            coupling_info.neighbor_id_ = idx + n_agents_x;
+                            scenario.couplings_.push_back(coupling_info);
+                        }
+                    }
+                }
+
+                runner.add_scenario(scenario);
+            }
+        }
+    }
+
+    // run all scenarios in parallel
+    runner.run(std::max(1u, std::thread::hardware_concurrency()));
+
+    // print results
+    runner.print_results_to_file("Scenarios.txt");
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+# This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+#
+# GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+# based on the alternating direction method of multipliers (ADMM).
+#
+# Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+# All rights reserved.
+#
+# GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+
+from pathlib import Path
+import sys, os
+from random import seed, random
+
+# generate path to module
+path = os.getcwd()
+sys.path.append(os.path.join(path, 'bin'))
+
+path = str(Path(path).parents[1])
+path = os.path.join(path, 'bin')
+
+# append path to list of folders where python is searching for modules
+sys.path.append(path)
+
+#import python interface
+import grampcd_interface
+
+# create runner
+runner = grampcd_interface.ScenarioRunner()
+
+# set optimization info
+optimization_info = grampcd_interface.OptimizationInfo()
+optimization_info.COMMON_Nhor_ = 21
+optimization_info.COMMON_Thor_ = 2
+optimization_info.COMMON_dt_ = 0.02
+optimization_info.GRAMPC_MaxGradIter_ = 15
+optimization_info.GRAMPC_MaxMultIter_ = 1
+optimization_info.ADMM_ConvergenceTolerance_ = 0.002
+
+Tsim = 2
+
+# parameters for cost function
+P_x = 1; P_vx = 1; P_y = 1; P_vy = 1;
+Q_vx = 2; Q_vy = 2;
+R_ux = 0.01; R_uy = 0.01;
+
+# model parameters
+m_agent = 7.5; c = 0.5;
+
+# number of agents
+n_agents_x = 3;
+n_agents_y = 3;
+
+# parameter sweep over the weights of the positions and the number of ADMM iterations,
+# each with randomized initial states
+seed(0)
+for Q_position in [1, 5, 10] :
+    for iterations in [5, 10] :
+        for sample in range(0, 4) :
+            scenario = grampcd_interface.ScenarioInfo()
+            scenario.name_ = "Q" + str(Q_position) + "_ADMM" + str(iterations) + "_sample" + str(sample)
+            optimization_info.ADMM_maxIterations_ = iterations
+            scenario.optimization_info_ = optimization_info
+            scenario.Tsim_ = Tsim
+
+            # agents
+            agents = []; x_init = []; u_init = []; x_des = []; u_des = []
+            for i in range(0, n_agents_x) :
+                for j in range(0, n_agents_y) :
+                    agentInfo = grampcd_interface.AgentInfo()
+                    agentInfo.id_ = i*n_agents_x + j
+                    agentInfo.model_name_ = "ssms2d_agentModel"
+                    agentInfo.model_parameters_ = [m_agent, 1]
+                    agentInfo.cost_parameters_ = [P_x, P_vx, P_y, P_vy, Q_position, Q_vx, Q_position, Q_vy, R_ux, R_uy]
+
+                    agents.append(agentInfo)
+                    x_init.append([i + 0.4*random(), 0, j + 0.4*random(), 0])
+                    u_init.append([0, 0])
+                    x_des.append([i, 0, j, 0])
+                    u_des.append([0, 0])
+
+            scenario.agents_ = agents
+            scenario.x_init_ = x_init
+            scenario.u_init_ = u_init
+            scenario.x_des_ = x_des
+            scenario.u_des_ = u_des
+
+            # couplings with the neighbors on the left, right, above and below
+            couplings = []
+            for i in range(0, n_agents_y) :
+                for j in range(0, n_agents_x) :
+                    idx = i*n_agents_x + j
+                    neighbors = []
+                    if j > 0 :
+                        neighbors.append(idx - 1)
+                    if j < n_agents_x - 1 :
+                        neighbors.append(idx + 1)
+                    if i > 0 :
+                        neighbors.append(idx - n_agents_x)
+                    if i < n_agents_y - 1 :
+                        neighbors.append(idx + n_agents_x)
+
+                    for neighbor in neighbors :
+                        coupling_info = grampcd_interface.CouplingInfo()
+                        coupling_info.agent_id_ = idx
+                        coupling_info.neighbor_id_ = neighbor
+                        coupling_info.model_name_ = "ssms2d_couplingModel"
+                        coupling_info.model_parameters_ = [m_agent, c]
+                        coupling_info.cost_parameters_ = []
+                        couplings.append(coupling_info)
+
+            scenario.couplings_ = couplings
+            runner.add_scenario(scenario)
+
+# run all scenarios in parallel
+runner.run(os.cpu_count())
+
+# print results
+runner.print_results_to_file("Scenarios.txt")
+
+for result in runner.get_results() :
+    print(result.name_, result.cost_, result.average_computation_time_)
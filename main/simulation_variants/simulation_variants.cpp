@@ -0,0 +1,127 @@
+/* This file is part of GRAMPC-D - (https://github.com/grampc-d/grampc-d.git)
+ *
+ * GRAMPC-D -- A software framework for distributed model predictive control (DMPC)
+ * based on the alternating direction method of multipliers (ADMM).
+ *
+ * Copyright 2020 by Daniel Burk, Andreas Voelz, Knut Graichen
+ * All rights reserved.
+ *
+ * GRAMPC-D is distributed under the BSD-3-Clause license, see LICENSE.txt
+ *
+ */
+
+#include "grampcd/interface/dmpc_interface.hpp"
+
+/*Simulate the coupled water tanks with the given settings and print the solutions with the given prefix.*/
+void simulate(const std::string& integrator, const unsigned int threads_simulation, const bool zero_copy, const std::string& prefix)
+{
+	// create interface
+	const auto interface = std::make_shared<grampcd::DmpcInterface>();
+
+	// initialize communication interface
+	interface->initialize_central_communicationInterface(0, zero_copy);
+
+	// set optimization info
+	auto optimization_info = interface->optimizationInfo();
+	optimization_info.COMMON_Nhor_ = 21;
+	optimization_info.COMMON_Thor_ = 5;
+	optimization_info.COMMON_dt_ = 0.1;
+	optimization_info.GRAMPC_MaxGradIter_ = 10;
+	optimization_info.GRAMPC_MaxMultIter_ = 2;
+	optimization_info.ADMM_maxIterations_ = 10;
+	optimization_info.ADMM_ConvergenceTolerance_ = 0.02;
+	optimization_info.COMMON_Integrator_ = integrator;
+	optimization_info.COMMON_IntegratorSubsteps_ = integrator == "rk4" ? 2 : 1;
+
+	interface->set_optimizationInfo(optimization_info);
+
+	// parameters for cost function
+	typeRNum P = 1;
+	typeRNum Q = 1;
+	typeRNum R = 0.1;
+
+	// parameters for model
+	typeRNum A = 0.1;
+	typeRNum a = 0.005;
+	typeRNum d = 0.01;
+
+	// inital and desired states and controls
+	std::vector<typeRNum> xinit(1, 0.5);
+	std::vector<typeRNum> uinit(1, 0.0);
+	std::vector<typeRNum> xdes(1, 2.0);
+	std::vector<typeRNum> udes(1, 0.0);
+
+	// register agents
+	auto agent = interface->agentInfo();
+	agent.model_name_ = "water_tank_agentModel";
+
+	int agent_id = 1;
+	agent.id_ = agent_id;
+	agent.model_parameters_ = { A, 1, 0 };
+	agent.cost_parameters_ = { 0, 0, R };
+	interface->register_agent(agent, xinit, uinit);
+	interface->set_desiredAgentState(agent_id, xdes, udes);
+
+	agent_id = 2;
+	agent.id_ = agent_id;
+	agent.model_parameters_ = { A, 0, 0 };
+	agent.cost_parameters_ = { 0, 0, 0 };
+	interface->register_agent(agent, xinit, uinit);
+	interface->set_desiredAgentState(agent_id, xdes, udes);
+
+	agent_id = 3;
+	agent.id_ = agent_id;
+	agent.model_parameters_ = { A, 0, 0 };
+	agent.cost_parameters_ = { 0, 0, 0 };
+	interface->register_agent(agent, xinit, uinit);
+	interface->set_desiredAgentState(agent_id, xdes, udes);
+
+	agent_id = 4;
+	agent.id_ = agent_id;
+	agent.model_parameters_ = { A, 0, d };
+	agent.cost_parameters_ = { P, Q, 0 };
+	interface->register_agent(agent, xinit, uinit);
+	interface->set_desiredAgentState(agent_id, xdes, udes);
+
+	// register couplings
+	auto coupling_info = interface->couplingInfo();
+	coupling_info.model_name_ = "water_tank_couplingModel";
+	coupling_info.model_parameters_ = { A, a };
+
+	std::vector<grampcd::CouplingInfo> couplings;
+	for (const auto& [id, neighbor_id] : std::vector< std::pair<int, int> >{ {1, 2}, {1, 3}, {2, 1}, {2, 4}, {3, 1}, {3, 4}, {4, 2}, {4, 3} })
+	{
+		coupling_info.agent_id_ = id;
+		coupling_info.neighbor_id_ = neighbor_id;
+		couplings.push_back(coupling_info);
+	}
+	interface->register_couplings(couplings);
+
+	// simulate the agents in parallel
+	if (threads_simulation > 0)
+		interface->parallelize_simulation(threads_simulation);
+
+	// run distributed controller
+	interface->run_DMPC(0, 3);
+
+	// print solution to file
+	interface->print_solution_to_file("all", prefix);
+}
+
+int main(int argc, char** argv)
+{
+	// fixed step integrator with sub-steps
+	simulate("rk4", 0, false, "rk4_agent");
+
+	// adaptive integrator
+	simulate("rk45", 0, false, "rk45_agent");
+
+	// the serial and the parallel simulation on the compiled topology yield the same solution
+	simulate("heun", 0, false, "serial_agent");
+	simulate("heun", 2, false, "parallel_agent");
+
+	// the central communication interface without copies of the states yields the same solution
+	simulate("heun", 0, true, "zeroCopy_agent");
+
+	return 0;
+}
@@ -24,4 +24,6 @@ int main(int argc, char* argv[])
 	checksumHandler.add_unit_test("evaluate_neighborApproximation");
 	checksumHandler.add_unit_test("high_scaled_system");
 	checksumHandler.add_unit_test("plug-and-play");
+	checksumHandler.add_unit_test("simulation_variants");
+	checksumHandler.add_unit_test("solution_handling");
 }
\ No newline at end of file